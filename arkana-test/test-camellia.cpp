@@ -1,8 +1,17 @@
 #include "./gtest.h"
 #include "../arkana/ark.h"
+#include "../arkana/camellia-file.h"
 #include "../arkana/camellia/camellia.h"
+#include "../arkana/camellia/camellia-ref.h"
+#include "../arkana/camellia/ghash-ref.h"
 #include "./helper.h"
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
 using namespace arkana::hexilit;
 using namespace arkana::camellia;
 using arkana::byte_array;
@@ -245,6 +254,145 @@ TYPED_TEST_P(CamelliaTest, ctr_partial256)
         }
 }
 
+TYPED_TEST_P(CamelliaTest, ctr_layouts128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto& plain = TestFixture::source_for_benchmark();
+
+    // rfc5528 counter block is be32 layout starting from nonce || iv || 1
+    {
+        auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+        auto nonce = 0x00'00'00'30_byte_array;
+        const block_t initial = 0x00'00'00'30'00'00'00'00'00'00'00'00'00'00'00'01_byte_array;
+        std::vector<std::byte> expected(4096), actual(4096);
+        TypeParam::camellia128_ctr_context_t(key, iv, nonce)->process_bytes(expected.data(), plain.data(), 0, expected.size());
+        TypeParam::camellia128_ctr_context_t(key, initial, ctr_layout_t::be32)->process_bytes(actual.data(), plain.data(), 0, actual.size());
+        EXPECT_EQ(actual, expected);
+    }
+
+    // counter fields wrap around in the middle of a batch
+    const auto add_counter = [](block_t b, ctr_layout_t layout, uint64_t n)
+    {
+        const size_t bytes = layout == ctr_layout_t::be128 ? 16 : layout == ctr_layout_t::be64 ? 8 : 4;
+        for (size_t k = 0; k < bytes; k++)
+        {
+            const size_t i = layout == ctr_layout_t::le32 ? 16 - bytes + k : 15 - k;
+            n += static_cast<uint8_t>(b[i]);
+            b[i] = static_cast<std::byte>(n);
+            n >>= 8;
+        }
+        return b;
+    };
+
+    for (auto [layout, initial] : {
+             std::pair{ctr_layout_t::be128, 0xff'ff'ff'ff'ff'ff'ff'ff'ff'ff'ff'ff'ff'ff'fe'e5_byte_array},
+             std::pair{ctr_layout_t::be128, 0x01'23'45'67'89'ab'cd'ef'00'00'00'ff'ff'ff'ff'f3_byte_array},
+             std::pair{ctr_layout_t::be64, 0x01'23'45'67'89'ab'cd'ef'ff'ff'ff'ff'ff'ff'fe'f7_byte_array},
+             std::pair{ctr_layout_t::be32, 0x01'23'45'67'89'ab'cd'ef'01'23'45'67'ff'ff'fe'fd_byte_array},
+             std::pair{ctr_layout_t::le32, 0x01'23'45'67'89'ab'cd'ef'01'23'45'67'e9'fe'ff'ff_byte_array},
+         })
+    {
+        std::vector<block_t> counters(256);
+        for (size_t i = 0; i < counters.size(); i++)
+            counters[i] = add_counter(initial, layout, i);
+
+        std::vector<std::byte> expected(counters.size() * sizeof(block_t));
+        TypeParam::camellia128_ecb_encrypt_context_t(key)->process_blocks(expected.data(), counters.data(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++)
+            expected[i] ^= plain[i];
+
+        auto ctx = TypeParam::camellia128_ctr_context_t(key, initial, layout);
+        for (auto i : {0, 1, 15, 16, 17, 255, 256, 257, 511, 512, 513, 1000})
+            for (auto j : {0, 1, 15, 16, 17, 255, 256, 257, 511, 512, 513, 1024, 3000})
+            {
+                std::vector<std::byte> x(j + 2);
+                ctx->process_bytes(x.data() + 1, plain.data() + i, i, j);
+                EXPECT_EQ(x[0], std::byte{});
+                EXPECT_EQ(memcmp(x.data() + 1, expected.data() + i, j), 0) << "layout=" << static_cast<int>(layout) << " i=" << i << " j=" << j;
+                EXPECT_EQ(x[j + 1], std::byte{});
+            }
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, ctr_generate128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    auto nonce = 0x00'00'00'30_byte_array;
+    const block_t initial = 0x01'23'45'67'89'ab'cd'ef'ff'ff'ff'ff'ff'ff'fe'e5_byte_array;
+
+    for (auto ctx : {
+             std::shared_ptr<ctr_context_t>(TypeParam::camellia128_ctr_context_t(key, iv, nonce)),
+             std::shared_ptr<ctr_context_t>(TypeParam::camellia128_ctr_context_t(key, initial, ctr_layout_t::be128)),
+         })
+    {
+        // keystream is the encryption of zeros
+        std::vector<std::byte> expected(4096);
+        ctx->process_bytes(expected.data(), expected.data(), 0, expected.size());
+
+        for (auto i : {0, 1, 15, 16, 17, 255, 256, 257, 511, 512, 513, 1000})
+            for (auto j : {0, 1, 15, 16, 17, 255, 256, 257, 511, 512, 513, 1024, 3000})
+            {
+                std::vector<std::byte> x(j + 2);
+                ctx->generate(x.data() + 1, i, j);
+                EXPECT_EQ(x[0], std::byte{});
+                EXPECT_EQ(memcmp(x.data() + 1, expected.data() + i, j), 0) << "i=" << i << " j=" << j;
+                EXPECT_EQ(x[j + 1], std::byte{});
+            }
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, ctr_segments128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    auto nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+    auto ctx = TypeParam::camellia128_ctr_context_t(key, iv, nonce);
+
+    const std::vector<std::vector<size_t>> layouts = {
+        {4096, 4096, 4096},
+        {1, 511, 512, 1000, 0, 17, 4096},
+        {100, 200, 300, 400, 500, 600, 700, 800},
+        {0, 12288},
+    };
+
+    for (auto position : {0, 5, 512, 1000})
+        for (auto& dst_layout : layouts)
+            for (auto& src_layout : layouts)
+            {
+                size_t length = 0, src_length = 0;
+                for (auto n : dst_layout) length += n;
+                for (auto n : src_layout) src_length += n;
+                if (length != src_length) continue;
+
+                std::vector<std::byte> expected(length), keystream(length);
+                ctx->process_bytes(expected.data(), plain.data(), position, length);
+                ctx->generate(keystream.data(), position, length);
+
+                std::vector<std::byte> actual(length), generated(length);
+                std::vector<buffer_segment_t> dst_iov, gen_iov;
+                std::vector<const_buffer_segment_t> src_iov;
+                for (size_t i = 0, offset = 0; i < dst_layout.size(); offset += dst_layout[i++])
+                {
+                    dst_iov.push_back({actual.data() + offset, dst_layout[i]});
+                    gen_iov.push_back({generated.data() + offset, dst_layout[i]});
+                }
+                for (size_t i = 0, offset = 0; i < src_layout.size(); offset += src_layout[i++])
+                    src_iov.push_back({plain.data() + offset, src_layout[i]});
+
+                ctx->process_segments(dst_iov.data(), dst_iov.size(), src_iov.data(), src_iov.size(), position);
+                EXPECT_EQ(actual, expected) << "position=" << position;
+                ctx->process_segments(gen_iov.data(), gen_iov.size(), nullptr, 0, position);
+                EXPECT_EQ(generated, keystream) << "position=" << position;
+            }
+
+    std::vector<std::byte> x(32);
+    buffer_segment_t dst_iov[] = {{x.data(), 32}};
+    const_buffer_segment_t src_iov[] = {{plain.data(), 16}};
+    EXPECT_THROW(ctx->process_segments(dst_iov, 1, src_iov, 1, 0), std::invalid_argument);
+}
+
 TYPED_TEST_P(CamelliaTest, ecb_benchmark128)
 {
     auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
@@ -289,6 +437,294 @@ TYPED_TEST_P(CamelliaTest, ctr_benchmark256)
     EXPECT_EQ(source, buffer);
 }
 
+namespace
+{
+    // reference cbc decryption: plain[i] = ecb_decrypt(cipher[i]) ^ cipher[i - 1]
+    template <class ecb_context_t>
+    std::vector<std::byte> cbc_decrypt_by_ecb(ecb_context_t ecb_decrypt_context, const cbc_iv_t& iv, const std::byte* cipher, size_t length)
+    {
+        std::vector<std::byte> plain(length);
+        ecb_decrypt_context->process_blocks(plain.data(), cipher, length);
+        for (size_t i = 0; i < length; i++)
+            plain[i] ^= i < 16 ? iv[i] : cipher[i - 16];
+        return plain;
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, cbc_partial128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'01'02'03'04'05'06'07'08'09'0a'0b'0c'0d'0e'0f_byte_array;
+    auto& cipher = TestFixture::source_for_benchmark();
+    constexpr size_t length = 2048;
+    auto expected = cbc_decrypt_by_ecb(TypeParam::camellia128_ecb_decrypt_context_t(key), iv, cipher.data(), length);
+
+    for (size_t i = 0; i <= length; i += 16)
+    {
+        // two calls, out-of-place
+        std::array<std::byte, length> x{};
+        auto context = TypeParam::camellia128_cbc_decrypt_context_t(key, iv);
+        context->process_blocks(x.data(), cipher.data(), i);
+        context->process_blocks(x.data() + i, cipher.data() + i, length - i);
+        EXPECT_EQ(memcmp(x.data(), expected.data(), length), 0);
+
+        // two calls, in-place
+        std::array<std::byte, length> y{};
+        memcpy(y.data(), cipher.data(), length);
+        context = TypeParam::camellia128_cbc_decrypt_context_t(key, iv);
+        context->process_blocks(y.data(), y.data(), i);
+        context->process_blocks(y.data() + i, y.data() + i, length - i);
+        EXPECT_EQ(memcmp(y.data(), expected.data(), length), 0);
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, cbc_benchmark128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'01'02'03'04'05'06'07'08'09'0a'0b'0c'0d'0e'0f_byte_array;
+    auto& source = TestFixture::source_for_benchmark();
+    auto expected = cbc_decrypt_by_ecb(TypeParam::camellia128_ecb_decrypt_context_t(key), iv, source.data(), source.size());
+    auto buffer = source;
+    TypeParam::camellia128_cbc_decrypt_context_t(key, iv)->process_blocks(buffer.data(), buffer.data(), buffer.size());
+    EXPECT_EQ(memcmp(buffer.data(), expected.data(), buffer.size()), 0);
+}
+
+TYPED_TEST_P(CamelliaTest, cbc_benchmark256)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    auto iv = 0x00'01'02'03'04'05'06'07'08'09'0a'0b'0c'0d'0e'0f_byte_array;
+    auto& source = TestFixture::source_for_benchmark();
+    auto expected = cbc_decrypt_by_ecb(TypeParam::camellia256_ecb_decrypt_context_t(key), iv, source.data(), source.size());
+    auto buffer = source;
+    TypeParam::camellia256_cbc_decrypt_context_t(key, iv)->process_blocks(buffer.data(), buffer.data(), buffer.size());
+    EXPECT_EQ(memcmp(buffer.data(), expected.data(), buffer.size()), 0);
+}
+
+TYPED_TEST_P(CamelliaTest, cbc_encrypt_jobs128)
+{
+    auto& source = TestFixture::source_for_benchmark();
+    constexpr size_t job_count = 100;
+
+    std::vector<key_128bit_t> keys(job_count);
+    std::vector<cbc_iv_t> ivs(job_count);
+    std::vector<std::vector<std::byte>> outputs(job_count);
+    std::vector<cbc_encrypt_job_t<key_128bit_t>> jobs(job_count);
+    for (size_t i = 0; i < job_count; i++)
+    {
+        memcpy(keys[i].data(), source.data() + i * 16, 16);
+        memcpy(ivs[i].data(), source.data() + i * 16 + 8, 16);
+        outputs[i].resize((i * 7 % 67) * 16);
+        jobs[i] = {&keys[i], &ivs[i], i % 3 ? outputs[i].data() : nullptr, source.data() + i * 16, outputs[i].size()};
+    }
+
+    TypeParam::process_cbc_encrypt_jobs(jobs.data(), jobs.size());
+
+    for (size_t i = 0; i < job_count; i++)
+    {
+        // serial cbc-mode encryption
+        auto ecb = TypeParam::camellia128_ecb_encrypt_context_t(keys[i]);
+        std::array<std::byte, 16> c{};
+        memcpy(c.data(), source.data() + i * 16 + 8, 16);
+        for (size_t j = 0; j < outputs[i].size(); j += 16)
+        {
+            for (size_t k = 0; k < 16; k++) c[k] ^= source[i * 16 + j + k];
+            ecb->process_blocks(c.data(), c.data(), 16);
+            if (i % 3) { EXPECT_EQ(memcmp(outputs[i].data() + j, c.data(), 16), 0); }
+        }
+        EXPECT_EQ(ivs[i], c);
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, cbc_encrypt_jobs_benchmark256)
+{
+    auto& source = TestFixture::source_for_benchmark();
+    constexpr size_t record_size = 4096;
+    const size_t job_count = source.size() / record_size;
+
+    std::vector<key_256bit_t> keys(job_count);
+    std::vector<cbc_iv_t> ivs(job_count);
+    std::vector<std::byte> buffer(source.size());
+    std::vector<cbc_encrypt_job_t<key_256bit_t>> jobs(job_count);
+    for (size_t i = 0; i < job_count; i++)
+    {
+        memcpy(keys[i].data(), source.data() + i * record_size, 32);
+        ivs[i] = {};
+        jobs[i] = {&keys[i], &ivs[i], buffer.data() + i * record_size, source.data() + i * record_size, record_size};
+    }
+
+    TypeParam::process_cbc_encrypt_jobs(jobs.data(), jobs.size());
+
+    for (size_t i = 0; i < job_count; i++)
+    {
+        EXPECT_EQ(memcmp(ivs[i].data(), buffer.data() + (i + 1) * record_size - 16, 16), 0);
+        TypeParam::camellia256_cbc_decrypt_context_t(keys[i], cbc_iv_t{})->process_blocks(buffer.data() + i * record_size, buffer.data() + i * record_size, record_size);
+    }
+    EXPECT_EQ(memcmp(buffer.data(), source.data(), buffer.size()), 0);
+}
+
+TEST(CamelliaGhashTest, gcm_spec_test_vectors)
+{
+    // "The Galois/Counter Mode of Operation (GCM)" test case 2, 3, 4: GHASH(H, A, C)
+    auto ghash = [](const byte_array<16>& h, const auto& a, const auto& c)
+    {
+        const auto k = arkana::camellia::ghash::ref::generate_ghash_key(h);
+        byte_array<16> y{};
+        arkana::camellia::ghash::ref::ghash_update(y, k, a.data(), a.size());
+        arkana::camellia::ghash::ref::ghash_update(y, k, c.data(), c.size());
+        uint64_t lengths[2] = {arkana::bit::byteswap<uint64_t>(a.size() * 8), arkana::bit::byteswap<uint64_t>(c.size() * 8)};
+        arkana::camellia::ghash::ref::ghash_update(y, k, lengths, sizeof(lengths));
+        return y;
+    };
+
+    {
+        auto h = 0x66'e9'4b'd4'ef'8a'2c'3b'88'4c'fa'59'ca'34'2b'2e_byte_array;
+        auto c = 0x03'88'da'ce'60'b6'a3'92'f3'28'c2'b9'71'b2'fe'78_byte_array;
+        EXPECT_EQ(ghash(h, std::array<std::byte, 0>{}, c), 0xf3'8c'bb'1a'd6'92'23'dc'c3'45'7a'e5'b6'b0'f8'85_byte_array);
+    }
+
+    {
+        auto h = 0xb8'3b'53'37'08'bf'53'5d'0a'a6'e5'29'80'd5'3b'78_byte_array;
+        auto c = 0x42'83'1e'c2'21'77'74'24'4b'72'21'b7'84'd0'd4'9c'e3'aa'21'2f'2c'02'a4'e0'35'c1'7e'23'29'ac'a1'2e'21'd5'14'b2'54'66'93'1c'7d'8f'6a'5a'ac'84'aa'05'1b'a3'0b'39'6a'0a'ac'97'3d'58'e0'91'47'3f'59'85_byte_array;
+        EXPECT_EQ(ghash(h, std::array<std::byte, 0>{}, c), 0x7f'1b'32'b8'1b'82'0d'02'61'4f'88'95'ac'1d'4e'ac_byte_array);
+    }
+
+    {
+        auto h = 0xb8'3b'53'37'08'bf'53'5d'0a'a6'e5'29'80'd5'3b'78_byte_array;
+        auto a = 0xfe'ed'fa'ce'de'ad'be'ef'fe'ed'fa'ce'de'ad'be'ef'ab'ad'da'd2_byte_array;
+        auto c = 0x42'83'1e'c2'21'77'74'24'4b'72'21'b7'84'd0'd4'9c'e3'aa'21'2f'2c'02'a4'e0'35'c1'7e'23'29'ac'a1'2e'21'd5'14'b2'54'66'93'1c'7d'8f'6a'5a'ac'84'aa'05'1b'a3'0b'39'6a'0a'ac'97'3d'58'e0'91_byte_array;
+        EXPECT_EQ(ghash(h, a, c), 0x69'8e'57'f7'0e'6e'cc'7f'd9'46'3b'72'60'a9'ae'5f_byte_array);
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, gcm_partial128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0xca'fe'ba'be'fa'ce'db'ad'de'ca'f8'88_byte_array;
+    auto& source = TestFixture::source_for_benchmark();
+    auto context = TypeParam::camellia128_gcm_context_t(key);
+
+    // reference: H = E(0), E(J0) and the payload keystream from rfc5528 ctr-mode.
+    byte_array<16> h{};
+    TypeParam::camellia128_ecb_encrypt_context_t(key)->process_blocks(h.data(), h.data(), h.size());
+    const auto hash_key = arkana::camellia::ghash::ref::generate_ghash_key(h);
+    ctr_nonce_t nonce{};
+    ctr_iv_t ctr_iv{};
+    memcpy(nonce.data(), iv.data(), 4);
+    memcpy(ctr_iv.data(), iv.data() + 4, 8);
+    auto ctr = TypeParam::camellia128_ctr_context_t(key, ctr_iv, nonce);
+
+    for (size_t length : {0, 1, 15, 16, 17, 255, 256, 511, 512, 4095, 4096, 4097, 9999})
+    {
+        const size_t aad_length = length % 29;
+        const std::byte* aad = source.data() + source.size() - aad_length;
+
+        std::vector<std::byte> expected(length);
+        ctr->process_bytes(expected.data(), source.data(), 16, length);
+        byte_array<16> expected_tag{};
+        arkana::camellia::ghash::ref::ghash_update(expected_tag, hash_key, aad, aad_length);
+        arkana::camellia::ghash::ref::ghash_update(expected_tag, hash_key, expected.data(), length);
+        uint64_t lengths[2] = {arkana::bit::byteswap<uint64_t>(aad_length * 8), arkana::bit::byteswap<uint64_t>(length * 8)};
+        arkana::camellia::ghash::ref::ghash_update(expected_tag, hash_key, lengths, sizeof(lengths));
+        ctr->process_bytes(expected_tag.data(), expected_tag.data(), 0, expected_tag.size());
+
+        // encrypt
+        std::vector<std::byte> buffer(source.begin(), source.begin() + length);
+        gcm_tag_t tag{};
+        context->encrypt(buffer.data(), buffer.data(), length, &iv, aad, aad_length, &tag);
+        EXPECT_EQ(memcmp(buffer.data(), expected.data(), length), 0);
+        EXPECT_EQ(tag, expected_tag);
+
+        // decrypt
+        EXPECT_TRUE(context->decrypt(buffer.data(), buffer.data(), length, &iv, aad, aad_length, &tag));
+        EXPECT_EQ(memcmp(buffer.data(), source.data(), length), 0);
+
+        // tampered
+        tag[length % 16] ^= std::byte{1};
+        std::vector<std::byte> rejected(length, std::byte{0xCC});
+        EXPECT_FALSE(context->decrypt(rejected.data(), expected.data(), length, &iv, aad, aad_length, &tag));
+        EXPECT_TRUE(std::all_of(rejected.begin(), rejected.end(), [](std::byte b) { return b == std::byte{}; }));
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, gcm_benchmark256)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    auto iv = 0xca'fe'ba'be'fa'ce'db'ad'de'ca'f8'88_byte_array;
+    auto aad = 0xfe'ed'fa'ce'de'ad'be'ef'fe'ed'fa'ce'de'ad'be'ef'ab'ad'da'd2_byte_array;
+    auto& source = TestFixture::source_for_benchmark();
+    auto buffer = source;
+    gcm_tag_t tag{};
+    TypeParam::camellia256_gcm_context_t(key)->encrypt(buffer.data(), buffer.data(), buffer.size(), &iv, aad.data(), aad.size(), &tag);
+    EXPECT_TRUE(TypeParam::camellia256_gcm_context_t(key)->decrypt(buffer.data(), buffer.data(), buffer.size(), &iv, aad.data(), aad.size(), &tag));
+    EXPECT_EQ(source, buffer);
+}
+
+namespace
+{
+    // reference xts encryption: c[j] = ecb_encrypt(p[j] ^ t[j]) ^ t[j], t[j] = ecb_encrypt_tweak(sector index) * alpha^j
+    template <class ecb_context_t>
+    std::vector<std::byte> xts_encrypt_by_ecb(ecb_context_t ecb_encrypt_context, ecb_context_t ecb_tweak_context, uint64_t sector_index, size_t sector_size, const std::byte* plain, size_t length)
+    {
+        std::vector<std::byte> cipher(length);
+        for (size_t s = 0; s < length / sector_size; s++)
+        {
+            uint64_t t[2] = {sector_index + s, 0};
+            ecb_tweak_context->process_blocks(t, t, sizeof(t));
+            for (size_t j = 0; j < sector_size; j += 16)
+            {
+                std::byte* c = cipher.data() + s * sector_size + j;
+                for (size_t k = 0; k < 16; k++) c[k] = plain[s * sector_size + j + k] ^ reinterpret_cast<const std::byte*>(t)[k];
+                ecb_encrypt_context->process_blocks(c, c, 16);
+                for (size_t k = 0; k < 16; k++) c[k] ^= reinterpret_cast<const std::byte*>(t)[k];
+
+                const uint64_t carry = t[1] >> 63;
+                t[1] = t[1] << 1 | t[0] >> 63;
+                t[0] = t[0] << 1 ^ carry * 0x87;
+            }
+        }
+        return cipher;
+    }
+}
+
+TYPED_TEST_P(CamelliaTest, xts_sectors128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto tweak_key = 0x00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    auto& source = TestFixture::source_for_benchmark();
+
+    for (size_t sector_size : {16, 48, 512, 528, 4096})
+    {
+        const uint64_t sector_index = 0xFFFFFFFE;
+        const size_t length = sector_size * 5;
+        auto expected = xts_encrypt_by_ecb(TypeParam::camellia128_ecb_encrypt_context_t(key), TypeParam::camellia128_ecb_encrypt_context_t(tweak_key), sector_index, sector_size, source.data(), length);
+
+        // encrypt: out-of-place
+        std::vector<std::byte> buffer(length);
+        TypeParam::camellia128_xts_encrypt_context_t(key, tweak_key)->process_sectors(buffer.data(), source.data(), sector_index, sector_size, length);
+        EXPECT_EQ(buffer, expected);
+
+        // decrypt: in-place, sector by sector
+        auto context = TypeParam::camellia128_xts_decrypt_context_t(key, tweak_key);
+        for (size_t s = 0; s < 5; s++)
+            context->process_sectors(buffer.data() + s * sector_size, buffer.data() + s * sector_size, sector_index + s, sector_size, sector_size);
+        EXPECT_EQ(memcmp(buffer.data(), source.data(), length), 0);
+    }
+
+    EXPECT_THROW(TypeParam::camellia128_xts_encrypt_context_t(key, tweak_key)->process_sectors(nullptr, nullptr, 0, 24, 48), std::invalid_argument);
+    EXPECT_THROW(TypeParam::camellia128_xts_encrypt_context_t(key, tweak_key)->process_sectors(nullptr, nullptr, 0, 512, 1000), std::invalid_argument);
+}
+
+TYPED_TEST_P(CamelliaTest, xts_benchmark256)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    auto tweak_key = 0xff'ee'dd'cc'bb'aa'99'88'77'66'55'44'33'22'11'00'10'32'54'76'98'ba'dc'fe'ef'cd'ab'89'67'45'23'01_byte_array;
+    auto& source = TestFixture::source_for_benchmark();
+    auto buffer = source;
+    TypeParam::camellia256_xts_encrypt_context_t(key, tweak_key)->process_sectors(buffer.data(), buffer.data(), 0, 4096, buffer.size());
+    TypeParam::camellia256_xts_decrypt_context_t(key, tweak_key)->process_sectors(buffer.data(), buffer.data(), 0, 4096, buffer.size());
+    EXPECT_EQ(source, buffer);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     CamelliaTest,
     rfc3713_test_vectors,
@@ -296,10 +732,164 @@ REGISTER_TYPED_TEST_SUITE_P(
     rfc5528_test_vectors,
     ctr_partial128,
     ctr_partial256,
+    ctr_layouts128,
+    ctr_generate128,
+    ctr_segments128,
     ecb_benchmark128,
     ecb_benchmark256,
     ctr_benchmark128,
-    ctr_benchmark256);
+    ctr_benchmark256,
+    cbc_partial128,
+    cbc_benchmark128,
+    cbc_benchmark256,
+    cbc_encrypt_jobs128,
+    cbc_encrypt_jobs_benchmark256,
+    gcm_partial128,
+    gcm_benchmark256,
+    xts_sectors128,
+    xts_benchmark256);
+
+// reference implementation (camellia-ref.h): the baseline for the other backends.
+namespace ref_contexts
+{
+    template <class key_vector_t>
+    struct ecb_context_impl_t final : public ecb_context_t
+    {
+        const key_vector_t key_vector_;
+        explicit ecb_context_impl_t(key_vector_t kv) : key_vector_(kv) { }
+        void process_blocks(void* dst, const void* src, size_t length) override { return ref::process_blocks_ecb(dst, src, length, key_vector_); }
+    };
+
+    template <class key_vector_t>
+    struct cbc_decrypt_context_impl_t final : public cbc_decrypt_context_t
+    {
+        const key_vector_t key_vector_;
+        cbc_iv_t iv_;
+        explicit cbc_decrypt_context_impl_t(key_vector_t kv, const cbc_iv_t& iv) : key_vector_(kv), iv_(iv) { }
+        void process_blocks(void* dst, const void* src, size_t length) override { return ref::process_blocks_cbc_decrypt(dst, src, length, key_vector_, iv_); }
+    };
+
+    template <class key_vector_t>
+    struct ctr_context_impl_t final : public ctr_context_t
+    {
+        const key_vector_t key_vector_;
+        const ref::ctr_vector_t ctr_vector_;
+        explicit ctr_context_impl_t(key_vector_t kv, ref::ctr_vector_t cv) : key_vector_(kv), ctr_vector_(cv) { }
+        void process_bytes(void* dst, const void* src, size_t position, size_t length) override { return ref::process_bytes_ctr(dst, src, position, length, key_vector_, ctr_vector_); }
+    };
+
+    template <class key_vector_t>
+    struct ctr_layout_context_impl_t final : public ctr_context_t
+    {
+        const key_vector_t key_vector_;
+        const block_t initial_;
+        const ctr_layout_t layout_;
+        explicit ctr_layout_context_impl_t(key_vector_t kv, const block_t& initial, ctr_layout_t layout) : key_vector_(kv), initial_(initial), layout_(layout) { }
+
+        void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+        {
+            switch (layout_)
+            {
+            case ctr_layout_t::be128: return ref::process_bytes_ctr(dst, src, position, length, key_vector_, functions::ctr_layout_be128::make_ctr_provider(initial_));
+            case ctr_layout_t::be64: return ref::process_bytes_ctr(dst, src, position, length, key_vector_, functions::ctr_layout_be64::make_ctr_provider(initial_));
+            case ctr_layout_t::be32: return ref::process_bytes_ctr(dst, src, position, length, key_vector_, functions::ctr_layout_be32::make_ctr_provider(initial_));
+            case ctr_layout_t::le32: return ref::process_bytes_ctr(dst, src, position, length, key_vector_, functions::ctr_layout_le32::make_ctr_provider(initial_));
+            }
+            throw std::invalid_argument("invalid layout.");
+        }
+    };
+
+    template <class key_vector_t>
+    struct gcm_context_impl_t final : public gcm_context_t
+    {
+        const key_vector_t key_vector_;
+        ghash::ref::ghash_key_t hash_key_;
+
+        explicit gcm_context_impl_t(key_vector_t kv) : key_vector_(kv), hash_key_()
+        {
+            ghash::ghash_block_t h{};
+            ref::process_blocks_ecb(h.data(), h.data(), h.size(), key_vector_); // H = E(0^128)
+            hash_key_ = ghash::ref::generate_ghash_key(h);
+        }
+
+        void encrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, gcm_tag_t* tag) override
+        {
+            const ref::ctr_vector_t cv = ref::generate_gcm_ctr_vector(*iv);
+            return functions::process_bytes_gcm_encrypt(
+                dst, src, length, aad, aad_length, *tag,
+                [&](void* d, const void* s, size_t position, size_t len) { return ref::process_bytes_ctr(d, s, position, len, key_vector_, cv); },
+                [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::ref::ghash_update(y, hash_key_, data, len); });
+        }
+
+        bool decrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, const gcm_tag_t* tag) override
+        {
+            const ref::ctr_vector_t cv = ref::generate_gcm_ctr_vector(*iv);
+            return functions::process_bytes_gcm_decrypt(
+                dst, src, length, aad, aad_length, *tag,
+                [&](void* d, const void* s, size_t position, size_t len) { return ref::process_bytes_ctr(d, s, position, len, key_vector_, cv); },
+                [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::ref::ghash_update(y, hash_key_, data, len); });
+        }
+    };
+
+    template <class key_vector_t>
+    struct xts_context_impl_t final : public xts_context_t
+    {
+        const key_vector_t key_vector_;
+        const key_vector_t tweak_key_vector_;
+        explicit xts_context_impl_t(key_vector_t kv, key_vector_t tweak_kv) : key_vector_(kv), tweak_key_vector_(tweak_kv) { }
+        void process_sectors(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length) override { return ref::process_sectors_xts(dst, src, sector_index, sector_size, length, key_vector_, tweak_key_vector_); }
+    };
+
+    template <class key_vector_t> static std::unique_ptr<ecb_context_t> make_ecb_context(key_vector_t kv) { return std::make_unique<ecb_context_impl_t<key_vector_t>>(kv); }
+    template <class key_vector_t> static std::unique_ptr<cbc_decrypt_context_t> make_cbc_decrypt_context(key_vector_t kv, const cbc_iv_t& iv) { return std::make_unique<cbc_decrypt_context_impl_t<key_vector_t>>(kv, iv); }
+    template <class key_vector_t> static std::unique_ptr<ctr_context_t> make_ctr_context(key_vector_t kv, ref::ctr_vector_t cv) { return std::make_unique<ctr_context_impl_t<key_vector_t>>(kv, cv); }
+    template <class key_vector_t> static std::unique_ptr<ctr_context_t> make_ctr_context(key_vector_t kv, const block_t& initial, ctr_layout_t layout) { return std::make_unique<ctr_layout_context_impl_t<key_vector_t>>(kv, initial, layout); }
+    template <class key_vector_t> static std::unique_ptr<gcm_context_t> make_gcm_context(key_vector_t kv) { return std::make_unique<gcm_context_impl_t<key_vector_t>>(kv); }
+    template <class key_vector_t> static std::unique_ptr<xts_context_t> make_xts_context(key_vector_t kv, key_vector_t tweak_kv) { return std::make_unique<xts_context_impl_t<key_vector_t>>(kv, tweak_kv); }
+
+    template <class key_t>
+    static void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_t>* jobs, size_t count)
+    {
+        using key_vector_t = decltype(ref::generate_key_vector_encrypt(std::declval<const key_t&>()));
+        std::vector<key_vector_t> key_vectors(count);
+        std::vector<ref::cbc_encrypt_job_t<key_vector_t>> key_vector_jobs(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            key_vectors[i] = ref::generate_key_vector_encrypt(*jobs[i].key);
+            key_vector_jobs[i] = {&key_vectors[i], jobs[i].iv, jobs[i].dst, jobs[i].src, jobs[i].length};
+        }
+        ref::process_cbc_encrypt_jobs(key_vector_jobs.data(), count);
+    }
+}
+
+struct ref_impl
+{
+    static auto camellia128_ecb_encrypt_context_t(const key_128bit_t& key) { return ref_contexts::make_ecb_context(ref::generate_key_vector_encrypt(key)); }
+    static auto camellia192_ecb_encrypt_context_t(const key_192bit_t& key) { return ref_contexts::make_ecb_context(ref::generate_key_vector_encrypt(key)); }
+    static auto camellia256_ecb_encrypt_context_t(const key_256bit_t& key) { return ref_contexts::make_ecb_context(ref::generate_key_vector_encrypt(key)); }
+    static auto camellia128_ecb_decrypt_context_t(const key_128bit_t& key) { return ref_contexts::make_ecb_context(ref::generate_key_vector_decrypt(key)); }
+    static auto camellia192_ecb_decrypt_context_t(const key_192bit_t& key) { return ref_contexts::make_ecb_context(ref::generate_key_vector_decrypt(key)); }
+    static auto camellia256_ecb_decrypt_context_t(const key_256bit_t& key) { return ref_contexts::make_ecb_context(ref::generate_key_vector_decrypt(key)); }
+    static auto camellia128_cbc_decrypt_context_t(const key_128bit_t& key, const cbc_iv_t& iv) { return ref_contexts::make_cbc_decrypt_context(ref::generate_key_vector_decrypt(key), iv); }
+    static auto camellia192_cbc_decrypt_context_t(const key_192bit_t& key, const cbc_iv_t& iv) { return ref_contexts::make_cbc_decrypt_context(ref::generate_key_vector_decrypt(key), iv); }
+    static auto camellia256_cbc_decrypt_context_t(const key_256bit_t& key, const cbc_iv_t& iv) { return ref_contexts::make_cbc_decrypt_context(ref::generate_key_vector_decrypt(key), iv); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return ref_contexts::make_ctr_context(ref::generate_key_vector_encrypt(key), ref::generate_ctr_vector(iv, nonce)); }
+    static auto camellia192_ctr_context_t(const key_192bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return ref_contexts::make_ctr_context(ref::generate_key_vector_encrypt(key), ref::generate_ctr_vector(iv, nonce)); }
+    static auto camellia256_ctr_context_t(const key_256bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return ref_contexts::make_ctr_context(ref::generate_key_vector_encrypt(key), ref::generate_ctr_vector(iv, nonce)); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const block_t& initial, ctr_layout_t layout) { return ref_contexts::make_ctr_context(ref::generate_key_vector_encrypt(key), initial, layout); }
+    static auto camellia128_gcm_context_t(const key_128bit_t& key) { return ref_contexts::make_gcm_context(ref::generate_key_vector_encrypt(key)); }
+    static auto camellia192_gcm_context_t(const key_192bit_t& key) { return ref_contexts::make_gcm_context(ref::generate_key_vector_encrypt(key)); }
+    static auto camellia256_gcm_context_t(const key_256bit_t& key) { return ref_contexts::make_gcm_context(ref::generate_key_vector_encrypt(key)); }
+    static auto camellia128_xts_encrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return ref_contexts::make_xts_context(ref::generate_key_vector_encrypt(key), ref::generate_key_vector_encrypt(tweak_key)); }
+    static auto camellia192_xts_encrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return ref_contexts::make_xts_context(ref::generate_key_vector_encrypt(key), ref::generate_key_vector_encrypt(tweak_key)); }
+    static auto camellia256_xts_encrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return ref_contexts::make_xts_context(ref::generate_key_vector_encrypt(key), ref::generate_key_vector_encrypt(tweak_key)); }
+    static auto camellia128_xts_decrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return ref_contexts::make_xts_context(ref::generate_key_vector_decrypt(key), ref::generate_key_vector_encrypt(tweak_key)); }
+    static auto camellia192_xts_decrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return ref_contexts::make_xts_context(ref::generate_key_vector_decrypt(key), ref::generate_key_vector_encrypt(tweak_key)); }
+    static auto camellia256_xts_decrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return ref_contexts::make_xts_context(ref::generate_key_vector_decrypt(key), ref::generate_key_vector_encrypt(tweak_key)); }
+    template <class job_t> static void process_cbc_encrypt_jobs(const job_t* jobs, size_t count) { return ref_contexts::process_cbc_encrypt_jobs(jobs, count); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(ref, CamelliaTest, ref_impl);
 
 struct ia32_impl
 {
@@ -309,9 +899,23 @@ struct ia32_impl
     static auto camellia128_ecb_decrypt_context_t(const key_128bit_t& key) { return create_ecb_decrypt_context_ia32(&key); }
     static auto camellia192_ecb_decrypt_context_t(const key_192bit_t& key) { return create_ecb_decrypt_context_ia32(&key); }
     static auto camellia256_ecb_decrypt_context_t(const key_256bit_t& key) { return create_ecb_decrypt_context_ia32(&key); }
+    static auto camellia128_cbc_decrypt_context_t(const key_128bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_ia32(&key, &iv); }
+    static auto camellia192_cbc_decrypt_context_t(const key_192bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_ia32(&key, &iv); }
+    static auto camellia256_cbc_decrypt_context_t(const key_256bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_ia32(&key, &iv); }
     static auto camellia128_ctr_context_t(const key_128bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_ia32(&key, &iv, &nonce); }
     static auto camellia192_ctr_context_t(const key_192bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_ia32(&key, &iv, &nonce); }
     static auto camellia256_ctr_context_t(const key_256bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_ia32(&key, &iv, &nonce); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const block_t& initial, ctr_layout_t layout) { return create_ctr_context_ia32(&key, &initial, layout); }
+    static auto camellia128_gcm_context_t(const key_128bit_t& key) { return create_gcm_context_ia32(&key); }
+    static auto camellia192_gcm_context_t(const key_192bit_t& key) { return create_gcm_context_ia32(&key); }
+    static auto camellia256_gcm_context_t(const key_256bit_t& key) { return create_gcm_context_ia32(&key); }
+    static auto camellia128_xts_encrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_encrypt_context_ia32(&key, &tweak_key); }
+    static auto camellia192_xts_encrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_encrypt_context_ia32(&key, &tweak_key); }
+    static auto camellia256_xts_encrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_encrypt_context_ia32(&key, &tweak_key); }
+    static auto camellia128_xts_decrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_decrypt_context_ia32(&key, &tweak_key); }
+    static auto camellia192_xts_decrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_decrypt_context_ia32(&key, &tweak_key); }
+    static auto camellia256_xts_decrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_decrypt_context_ia32(&key, &tweak_key); }
+    template <class job_t> static void process_cbc_encrypt_jobs(const job_t* jobs, size_t count) { return process_cbc_encrypt_jobs_ia32(jobs, count); }
 };
 
 INSTANTIATE_TYPED_TEST_SUITE_P(ia32, CamelliaTest, ia32_impl);
@@ -324,9 +928,23 @@ struct avx2_impl
     static auto camellia128_ecb_decrypt_context_t(const key_128bit_t& key) { return create_ecb_decrypt_context_avx2(&key); }
     static auto camellia192_ecb_decrypt_context_t(const key_192bit_t& key) { return create_ecb_decrypt_context_avx2(&key); }
     static auto camellia256_ecb_decrypt_context_t(const key_256bit_t& key) { return create_ecb_decrypt_context_avx2(&key); }
+    static auto camellia128_cbc_decrypt_context_t(const key_128bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_avx2(&key, &iv); }
+    static auto camellia192_cbc_decrypt_context_t(const key_192bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_avx2(&key, &iv); }
+    static auto camellia256_cbc_decrypt_context_t(const key_256bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_avx2(&key, &iv); }
     static auto camellia128_ctr_context_t(const key_128bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_avx2(&key, &iv, &nonce); }
     static auto camellia192_ctr_context_t(const key_192bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_avx2(&key, &iv, &nonce); }
     static auto camellia256_ctr_context_t(const key_256bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_avx2(&key, &iv, &nonce); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const block_t& initial, ctr_layout_t layout) { return create_ctr_context_avx2(&key, &initial, layout); }
+    static auto camellia128_gcm_context_t(const key_128bit_t& key) { return create_gcm_context_avx2(&key); }
+    static auto camellia192_gcm_context_t(const key_192bit_t& key) { return create_gcm_context_avx2(&key); }
+    static auto camellia256_gcm_context_t(const key_256bit_t& key) { return create_gcm_context_avx2(&key); }
+    static auto camellia128_xts_encrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_encrypt_context_avx2(&key, &tweak_key); }
+    static auto camellia192_xts_encrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_encrypt_context_avx2(&key, &tweak_key); }
+    static auto camellia256_xts_encrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_encrypt_context_avx2(&key, &tweak_key); }
+    static auto camellia128_xts_decrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_decrypt_context_avx2(&key, &tweak_key); }
+    static auto camellia192_xts_decrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_decrypt_context_avx2(&key, &tweak_key); }
+    static auto camellia256_xts_decrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_decrypt_context_avx2(&key, &tweak_key); }
+    template <class job_t> static void process_cbc_encrypt_jobs(const job_t* jobs, size_t count) { return process_cbc_encrypt_jobs_avx2(jobs, count); }
 };
 
 INSTANTIATE_TYPED_TEST_SUITE_P(avx2, CamelliaTest, avx2_impl);
@@ -339,9 +957,1144 @@ struct avx2aesni_impl
     static auto camellia128_ecb_decrypt_context_t(const key_128bit_t& key) { return create_ecb_decrypt_context_avx2aesni(&key); }
     static auto camellia192_ecb_decrypt_context_t(const key_192bit_t& key) { return create_ecb_decrypt_context_avx2aesni(&key); }
     static auto camellia256_ecb_decrypt_context_t(const key_256bit_t& key) { return create_ecb_decrypt_context_avx2aesni(&key); }
+    static auto camellia128_cbc_decrypt_context_t(const key_128bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_avx2aesni(&key, &iv); }
+    static auto camellia192_cbc_decrypt_context_t(const key_192bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_avx2aesni(&key, &iv); }
+    static auto camellia256_cbc_decrypt_context_t(const key_256bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_avx2aesni(&key, &iv); }
     static auto camellia128_ctr_context_t(const key_128bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_avx2aesni(&key, &iv, &nonce); }
     static auto camellia192_ctr_context_t(const key_192bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_avx2aesni(&key, &iv, &nonce); }
     static auto camellia256_ctr_context_t(const key_256bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_avx2aesni(&key, &iv, &nonce); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const block_t& initial, ctr_layout_t layout) { return create_ctr_context_avx2aesni(&key, &initial, layout); }
+    static auto camellia128_gcm_context_t(const key_128bit_t& key) { return create_gcm_context_avx2aesni(&key); }
+    static auto camellia192_gcm_context_t(const key_192bit_t& key) { return create_gcm_context_avx2aesni(&key); }
+    static auto camellia256_gcm_context_t(const key_256bit_t& key) { return create_gcm_context_avx2aesni(&key); }
+    static auto camellia128_xts_encrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_encrypt_context_avx2aesni(&key, &tweak_key); }
+    static auto camellia192_xts_encrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_encrypt_context_avx2aesni(&key, &tweak_key); }
+    static auto camellia256_xts_encrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_encrypt_context_avx2aesni(&key, &tweak_key); }
+    static auto camellia128_xts_decrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_decrypt_context_avx2aesni(&key, &tweak_key); }
+    static auto camellia192_xts_decrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_decrypt_context_avx2aesni(&key, &tweak_key); }
+    static auto camellia256_xts_decrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_decrypt_context_avx2aesni(&key, &tweak_key); }
+    template <class job_t> static void process_cbc_encrypt_jobs(const job_t* jobs, size_t count) { return process_cbc_encrypt_jobs_avx2aesni(jobs, count); }
 };
 
 INSTANTIATE_TYPED_TEST_SUITE_P(avx2aesni, CamelliaTest, avx2aesni_impl);
+
+struct sseaesni_impl
+{
+    static auto camellia128_ecb_encrypt_context_t(const key_128bit_t& key) { return create_ecb_encrypt_context_sseaesni(&key); }
+    static auto camellia192_ecb_encrypt_context_t(const key_192bit_t& key) { return create_ecb_encrypt_context_sseaesni(&key); }
+    static auto camellia256_ecb_encrypt_context_t(const key_256bit_t& key) { return create_ecb_encrypt_context_sseaesni(&key); }
+    static auto camellia128_ecb_decrypt_context_t(const key_128bit_t& key) { return create_ecb_decrypt_context_sseaesni(&key); }
+    static auto camellia192_ecb_decrypt_context_t(const key_192bit_t& key) { return create_ecb_decrypt_context_sseaesni(&key); }
+    static auto camellia256_ecb_decrypt_context_t(const key_256bit_t& key) { return create_ecb_decrypt_context_sseaesni(&key); }
+    static auto camellia128_cbc_decrypt_context_t(const key_128bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_sseaesni(&key, &iv); }
+    static auto camellia192_cbc_decrypt_context_t(const key_192bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_sseaesni(&key, &iv); }
+    static auto camellia256_cbc_decrypt_context_t(const key_256bit_t& key, const cbc_iv_t& iv) { return create_cbc_decrypt_context_sseaesni(&key, &iv); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_sseaesni(&key, &iv, &nonce); }
+    static auto camellia192_ctr_context_t(const key_192bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_sseaesni(&key, &iv, &nonce); }
+    static auto camellia256_ctr_context_t(const key_256bit_t& key, const ctr_iv_t& iv, const ctr_nonce_t& nonce) { return create_ctr_context_sseaesni(&key, &iv, &nonce); }
+    static auto camellia128_ctr_context_t(const key_128bit_t& key, const block_t& initial, ctr_layout_t layout) { return create_ctr_context_sseaesni(&key, &initial, layout); }
+    static auto camellia128_gcm_context_t(const key_128bit_t& key) { return create_gcm_context_sseaesni(&key); }
+    static auto camellia192_gcm_context_t(const key_192bit_t& key) { return create_gcm_context_sseaesni(&key); }
+    static auto camellia256_gcm_context_t(const key_256bit_t& key) { return create_gcm_context_sseaesni(&key); }
+    static auto camellia128_xts_encrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_encrypt_context_sseaesni(&key, &tweak_key); }
+    static auto camellia192_xts_encrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_encrypt_context_sseaesni(&key, &tweak_key); }
+    static auto camellia256_xts_encrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_encrypt_context_sseaesni(&key, &tweak_key); }
+    static auto camellia128_xts_decrypt_context_t(const key_128bit_t& key, const key_128bit_t& tweak_key) { return create_xts_decrypt_context_sseaesni(&key, &tweak_key); }
+    static auto camellia192_xts_decrypt_context_t(const key_192bit_t& key, const key_192bit_t& tweak_key) { return create_xts_decrypt_context_sseaesni(&key, &tweak_key); }
+    static auto camellia256_xts_decrypt_context_t(const key_256bit_t& key, const key_256bit_t& tweak_key) { return create_xts_decrypt_context_sseaesni(&key, &tweak_key); }
+    template <class job_t> static void process_cbc_encrypt_jobs(const job_t* jobs, size_t count) { return process_cbc_encrypt_jobs_sseaesni(jobs, count); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(sseaesni, CamelliaTest, sseaesni_impl);
+
+TEST(CamelliaParallelTest, parallel_ctr_partial128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+
+    // keystream
+    constexpr size_t size = 5 * 1024 * 1024;
+    std::vector<std::byte> expected(size);
+    create_ctr_context(&key, &iv, &nonce)->process_bytes(expected.data(), expected.data(), 0, expected.size());
+
+    for (size_t threads : {1, 2, 3, 8})
+    {
+        auto ctx = create_parallel_ctr_context(&key, &iv, &nonce, threads);
+        for (size_t i : {0, 1, 15, 16, 17, 262143, 262144, 262145, 1000001})
+            for (size_t j : {0, 1, 1048575, 1048576, 1048577, 3000001, 4242879})
+            {
+                if (i + j > size) continue;
+                std::vector<std::byte> x(j + 2);
+                ctx->process_bytes(x.data() + 1, x.data() + 1, i, j);
+                EXPECT_EQ(x[0], std::byte{});
+                EXPECT_EQ(memcmp(x.data() + 1, expected.data() + i, j), 0) << "threads=" << threads << " i=" << i << " j=" << j;
+                EXPECT_EQ(x[j + 1], std::byte{});
+            }
+    }
+}
+
+TEST(CamelliaParallelTest, parallel_ctr_benchmark128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    auto nonce = 0x00'00'00'30_byte_array;
+#ifndef NDEBUG
+    auto& source = static_random_bytes_1m();
+#else
+    auto& source = static_random_bytes_256m();
+#endif
+    auto buffer = source;
+    auto ctx = create_parallel_ctr_context(&key, &iv, &nonce);
+    ctx->process_bytes(buffer.data(), buffer.data(), 0, buffer.size());
+    ctx->process_bytes(buffer.data(), buffer.data(), 0, buffer.size());
+    EXPECT_EQ(source, buffer);
+}
+
+TEST(CamelliaCachedCtrTest, cached_ctr_partial128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+
+    std::vector<std::byte> expected(plain.size());
+    create_ctr_context(&key, &iv, &nonce)->process_bytes(expected.data(), plain.data(), 0, plain.size());
+
+    // sequential small writes
+    {
+        auto ctx = create_cached_ctr_context(&key, &iv, &nonce);
+        std::vector<std::byte> x(plain.size());
+        for (size_t i = 0, n = 0; i < plain.size(); i += n)
+        {
+            n = std::min<size_t>(20 + i * 37 % 181, plain.size() - i);
+            ctx->process_bytes(x.data() + i, plain.data() + i, i, n);
+        }
+        EXPECT_EQ(x, expected);
+    }
+
+    // random access
+    {
+        auto ctx = create_cached_ctr_context(&key, &iv, &nonce);
+        for (size_t i : {0, 1, 5, 511, 512, 513, 1000, 7, 4095, 4096, 100000, 3})
+            for (size_t j : {0, 1, 5, 200, 511, 512, 513, 1024, 1536, 5000})
+            {
+                std::vector<std::byte> x(j + 2);
+                ctx->process_bytes(x.data() + 1, plain.data() + i, i, j);
+                EXPECT_EQ(x[0], std::byte{});
+                EXPECT_EQ(memcmp(x.data() + 1, expected.data() + i, j), 0) << "i=" << i << " j=" << j;
+                EXPECT_EQ(x[j + 1], std::byte{});
+            }
+    }
+}
+
+TEST(CamelliaCachedCtrTest, cached_ctr_small_writes_benchmark128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    auto nonce = 0x00'00'00'30_byte_array;
+#ifndef NDEBUG
+    auto& source = static_random_bytes_1m();
+#else
+    auto& source = static_random_bytes_256m();
+#endif
+    auto buffer = source;
+    auto ctx = create_cached_ctr_context(&key, &iv, &nonce);
+    for (int k = 0; k < 2; k++)
+        for (size_t i = 0, n = 0; i < buffer.size(); i += n)
+        {
+            n = std::min<size_t>(20 + i * 37 % 181, buffer.size() - i);
+            ctx->process_bytes(buffer.data() + i, buffer.data() + i, i, n);
+        }
+    EXPECT_EQ(source, buffer);
+}
+
+TEST(CamelliaPrecomputedCtrTest, precomputed_ctr_partial128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+
+    std::vector<std::byte> expected(plain.size());
+    create_ctr_context(&key, &iv, &nonce)->process_bytes(expected.data(), plain.data(), 0, plain.size());
+
+    // sequential packets (with pauses for the precomputation to catch up), keystream only, and random access
+    for (size_t ahead : {size_t{0}, size_t{64} << 10})
+    {
+        auto ctx = create_precomputed_ctr_context(&key, &iv, &nonce, ahead);
+        std::vector<std::byte> x(plain.size());
+        for (size_t i = 0, n = 0, k = 0; i < plain.size(); i += n, k++)
+        {
+            n = std::min<size_t>(20 + i * 37 % 1500, plain.size() - i);
+            ctx->process_bytes(x.data() + i, plain.data() + i, i, n);
+            if (k % 64 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(x, expected);
+
+        std::vector<std::byte> keystream(10000);
+        ctx->generate(keystream.data(), 5000, keystream.size());
+        for (size_t i = 0; i < keystream.size(); i++)
+            ASSERT_EQ(keystream[i] ^ plain[5000 + i], expected[5000 + i]) << "i=" << i;
+
+        for (size_t i : {0, 1, 5, 4095, 4096, 100000, 7, 3})
+            for (size_t j : {0, 1, 5, 200, 4095, 4096, 4097, 20000})
+            {
+                std::vector<std::byte> y(j + 2);
+                ctx->process_bytes(y.data() + 1, plain.data() + i, i, j);
+                EXPECT_EQ(y[0], std::byte{});
+                EXPECT_EQ(memcmp(y.data() + 1, expected.data() + i, j), 0) << "i=" << i << " j=" << j;
+                EXPECT_EQ(y[j + 1], std::byte{});
+            }
+    }
+}
+
+TEST(CamelliaFileReaderTest, ctr_file_reader128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& source = static_random_bytes_1m();
+    const std::vector<std::byte> plain(source.begin(), source.end() - 100); // not a multiple of the extent size
+
+    const auto path = std::filesystem::temp_directory_path() / "arkana-test-ctr-file-reader.bin";
+    {
+        std::vector<std::byte> cipher(plain.size());
+        create_ctr_context(&key, &iv, &nonce)->process_bytes(cipher.data(), plain.data(), 0, plain.size());
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(cipher.data()), static_cast<std::streamsize>(cipher.size()));
+    }
+
+    for (size_t cache_capacity : {size_t{0}, size_t{16384}, size_t{4} << 20})
+    {
+        auto reader = create_ctr_file_reader(path, create_ctr_context(&key, &iv, &nonce), 4096, cache_capacity);
+        EXPECT_EQ(reader->size(), plain.size());
+
+        // first miss, second miss (cached), hit; across extents; large (uncached) reads
+        for (int k = 0; k < 3; k++)
+            for (size_t i : {0, 1, 5, 4095, 4096, 4097, 100000, 7, 300000, 12345, 3})
+                for (size_t j : {0, 1, 16, 200, 4095, 4096, 4097, 10000, 300000})
+                {
+                    std::vector<std::byte> x(j + 2);
+                    EXPECT_EQ(reader->read(x.data() + 1, i, j), j);
+                    EXPECT_EQ(x[0], std::byte{});
+                    EXPECT_EQ(memcmp(x.data() + 1, plain.data() + i, j), 0) << "i=" << i << " j=" << j << " cache=" << cache_capacity;
+                    EXPECT_EQ(x[j + 1], std::byte{});
+                }
+
+        // end of file
+        std::vector<std::byte> x(5000);
+        EXPECT_EQ(reader->read(x.data(), plain.size() - 10, x.size()), 10u);
+        EXPECT_EQ(memcmp(x.data(), plain.data() + plain.size() - 10, 10), 0);
+        EXPECT_EQ(reader->read(x.data(), plain.size(), x.size()), 0u);
+        EXPECT_EQ(reader->read(x.data(), plain.size() + 5000, x.size()), 0u);
+    }
+
+    EXPECT_THROW(create_ctr_file_reader(path, create_ctr_context(&key, &iv, &nonce), 100), std::invalid_argument);
+    EXPECT_THROW(create_ctr_file_reader(path, nullptr), std::invalid_argument);
+    std::filesystem::remove(path);
+    EXPECT_THROW(create_ctr_file_reader(path, create_ctr_context(&key, &iv, &nonce)), std::system_error);
+
+    // empty file
+    std::ofstream(path, std::ios::binary).close();
+    {
+        auto reader = create_ctr_file_reader(path, create_ctr_context(&key, &iv, &nonce));
+        std::byte b{};
+        EXPECT_EQ(reader->size(), 0u);
+        EXPECT_EQ(reader->read(&b, 0, 1), 0u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(CamelliaContainerTest, container128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& source = static_random_bytes_1m();
+    const std::vector<std::byte> plain(source.begin(), source.end() - 100); // the last chunk is shorter
+    constexpr size_t chunk_size = 65536;
+
+    std::vector<std::byte> expected(plain.size());
+    create_ctr_context(&key, &iv, &nonce)->process_bytes(expected.data(), plain.data(), 0, plain.size());
+
+    const auto path = std::filesystem::temp_directory_path() / "arkana-test-container.bin";
+    for (auto tag : {container_tag_t::crc32, container_tag_t::sha256})
+    {
+        const size_t tag_size = tag == container_tag_t::crc32 ? 4 : 32;
+        {
+            std::ofstream file(path, std::ios::binary);
+            auto writer = create_container_writer(&file, &key, &iv, &nonce, tag, chunk_size, 4);
+            for (size_t i = 0, n = 0; i < plain.size(); i += n)
+            {
+                n = std::min<size_t>(1000 + i * 37 % 100000, plain.size() - i);
+                writer->write(plain.data() + i, n);
+            }
+            writer->finish();
+            EXPECT_THROW(writer->write(plain.data(), 1), std::logic_error);
+        }
+
+        // layout: header, chunks (one ctr stream), index, footer
+        const size_t chunk_count = (plain.size() + chunk_size - 1) / chunk_size;
+        EXPECT_EQ(std::filesystem::file_size(path), 64 + plain.size() + chunk_count * tag_size + 32);
+        {
+            std::vector<std::byte> file(std::filesystem::file_size(path));
+            std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(file.data()), static_cast<std::streamsize>(file.size()));
+            EXPECT_EQ(memcmp(file.data() + 64, expected.data(), expected.size()), 0);
+            if (tag == container_tag_t::crc32)
+            {
+                const auto crc = arkana::crc32::calculate_crc32(expected.data() + chunk_size, chunk_size);
+                EXPECT_EQ(memcmp(file.data() + 64 + plain.size() + 4, &crc, 4), 0);
+            }
+        }
+
+        {
+            auto reader = create_container_reader(path, &key, 4);
+            EXPECT_EQ(reader->size(), plain.size());
+            EXPECT_EQ(reader->chunk_size(), chunk_size);
+            EXPECT_EQ(reader->chunk_count(), chunk_count);
+
+            for (size_t i : {0, 1, 65535, 65536, 65537, 300000, 7})
+                for (size_t j : {0, 1, 200, 65535, 65536, 200000, 2000000})
+                {
+                    std::vector<std::byte> x(std::min(j, plain.size() - i) + 2);
+                    EXPECT_EQ(reader->read(x.data() + 1, i, j), x.size() - 2);
+                    EXPECT_EQ(x[0], std::byte{});
+                    EXPECT_EQ(memcmp(x.data() + 1, plain.data() + i, x.size() - 2), 0) << "i=" << i << " j=" << j;
+                    EXPECT_EQ(x.back(), std::byte{});
+                }
+
+            EXPECT_EQ(reader->verify(), chunk_count);
+        }
+
+        // corrupted chunk: detected only when it is read
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(64 + 3 * chunk_size + 100));
+            file.put('\x5a' ^ static_cast<char>(expected[3 * chunk_size + 100]));
+        }
+        {
+            auto reader = create_container_reader(path, &key);
+            std::vector<std::byte> x(chunk_size * 2);
+            EXPECT_EQ(reader->read(x.data(), chunk_size, chunk_size), chunk_size);
+            EXPECT_EQ(memcmp(x.data(), plain.data() + chunk_size, chunk_size), 0);
+            EXPECT_THROW(reader->read(x.data(), 2 * chunk_size + 10, 2 * chunk_size), std::runtime_error);
+            EXPECT_EQ(x, std::vector<std::byte>(x.size()));
+            EXPECT_THROW(reader->read(x.data(), 3 * chunk_size, chunk_size), std::runtime_error);
+            EXPECT_EQ(reader->verify(), 3u);
+        }
+
+        const key_256bit_t key256{};
+        EXPECT_THROW(create_container_reader(path, &key256), std::invalid_argument);
+        const key_128bit_t wrong_key{};
+        EXPECT_THROW(create_container_reader(path, &wrong_key), std::invalid_argument);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        EXPECT_THROW(create_container_reader(path, &key), std::runtime_error);
+    }
+
+    std::ostringstream stream;
+    EXPECT_THROW(create_container_writer(&stream, &key, &iv, &nonce, container_tag_t::crc32, 100), std::invalid_argument);
+
+    // the RFC 5528 block counter wraps after 2^36 bytes: longer writes are rejected before any byte is read.
+    if constexpr (sizeof(size_t) > sizeof(uint32_t))
+    {
+        auto writer = create_container_writer(&stream, &key, &iv, &nonce, container_tag_t::crc32, chunk_size, 1);
+        writer->write(plain.data(), 100);
+        EXPECT_THROW(writer->write(plain.data(), (size_t{1} << 36) - 99), std::length_error);
+        writer->write(plain.data(), 100);
+        writer->finish();
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(CamelliaCtrGenerateTest, generate_wrappers128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+
+    constexpr size_t size = 5 * 1024 * 1024;
+    std::vector<std::byte> expected(size);
+    create_ctr_context(&key, &iv, &nonce)->process_bytes(expected.data(), expected.data(), 0, expected.size());
+
+    for (auto ctx : {
+             std::shared_ptr<ctr_context_t>(create_ctr_context(&key, &iv, &nonce)),
+             std::shared_ptr<ctr_context_t>(create_parallel_ctr_context(&key, &iv, &nonce, 3)),
+             std::shared_ptr<ctr_context_t>(create_cached_ctr_context(&key, &iv, &nonce)),
+         })
+        for (size_t i : {0, 1, 17, 511, 512, 513, 262145})
+            for (size_t j : {0, 1, 5, 511, 512, 513, 1536, 4242879})
+            {
+                std::vector<std::byte> x(j + 2);
+                ctx->generate(x.data() + 1, i, j);
+                EXPECT_EQ(x[0], std::byte{});
+                EXPECT_EQ(memcmp(x.data() + 1, expected.data() + i, j), 0) << "i=" << i << " j=" << j;
+                EXPECT_EQ(x[j + 1], std::byte{});
+            }
+}
+
+TEST(CamelliaCtrDrbgTest, ctr_drbg128)
+{
+    const auto entropy = 0x00'01'02'03'04'05'06'07'08'09'0a'0b'0c'0d'0e'0f'10'11'12'13'14'15'16'17'18'19'1a'1b'1c'1d'1e'1f_byte_array;
+    const auto personalization = 0x80'81'82'83'84'85'86'87_byte_array;
+    const auto additional = 0xc0'c1'c2'c3'c4'c5'c6'c7'c8'c9'ca'cb_byte_array;
+
+    // SP 800-90A 10.2.1 (no derivation function) on ECB, block by block
+    struct reference_t
+    {
+        key_128bit_t key{};
+        block_t v{};
+
+        void increment()
+        {
+            for (size_t i = v.size(); i--;)
+                if ((v[i] = static_cast<std::byte>(static_cast<uint8_t>(v[i]) + 1)) != std::byte{}) break;
+        }
+
+        block_t next_block()
+        {
+            increment();
+            block_t b{};
+            create_ecb_encrypt_context(&key)->process_blocks(&b, &v, sizeof(b));
+            return b;
+        }
+
+        void update(byte_array<32> provided)
+        {
+            block_t b0 = next_block();
+            block_t b1 = next_block();
+            for (size_t i = 0; i < 16; i++) provided[i] ^= b0[i];
+            for (size_t i = 0; i < 16; i++) provided[16 + i] ^= b1[i];
+            memcpy(key.data(), provided.data(), 16);
+            memcpy(v.data(), provided.data() + 16, 16);
+        }
+
+        std::vector<std::byte> generate(size_t length, byte_array<32> input)
+        {
+            std::vector<std::byte> r;
+            while (r.size() < length)
+            {
+                block_t b = next_block();
+                r.insert(r.end(), b.begin(), b.begin() + std::min<size_t>(16, length - r.size()));
+            }
+            update(input);
+            return r;
+        }
+    } reference;
+
+    byte_array<32> seed = entropy;
+    for (size_t i = 0; i < personalization.size(); i++) seed[i] ^= personalization[i];
+    reference.update(seed);
+
+    auto drbg = create_ctr_drbg_context(128, entropy.data(), entropy.size(), personalization.data(), personalization.size());
+    for (size_t length : {0, 1, 15, 16, 17, 100, 1000, 4097})
+    {
+        std::vector<std::byte> x(length);
+        drbg->generate(x.data(), x.size());
+        EXPECT_EQ(x, reference.generate(length, {})) << "length=" << length;
+    }
+
+    // additional input
+    {
+        byte_array<32> input{};
+        memcpy(input.data(), additional.data(), additional.size());
+        reference.update(input);
+
+        std::vector<std::byte> x(1000);
+        drbg->generate(x.data(), x.size(), additional.data(), additional.size());
+        EXPECT_EQ(x, reference.generate(x.size(), input));
+    }
+
+    // reseed
+    {
+        byte_array<32> input = entropy;
+        for (size_t i = 0; i < additional.size(); i++) input[i] ^= additional[i];
+        reference.update(input);
+
+        drbg->reseed(entropy.data(), entropy.size(), additional.data(), additional.size());
+        std::vector<std::byte> x(333);
+        drbg->generate(x.data(), x.size());
+        EXPECT_EQ(x, reference.generate(x.size(), {}));
+    }
+
+    // requests over 64 KiB are split
+    {
+        std::vector<std::byte> x(65536 + 100);
+        drbg->generate(x.data(), x.size());
+        auto expected = reference.generate(65536, {});
+        auto rest = reference.generate(100, {});
+        expected.insert(expected.end(), rest.begin(), rest.end());
+        EXPECT_EQ(x, expected);
+    }
+
+    EXPECT_THROW(create_ctr_drbg_context(128, entropy.data(), 16), std::invalid_argument);
+    EXPECT_THROW(create_ctr_drbg_context(64, entropy.data(), entropy.size()), std::invalid_argument);
+    EXPECT_THROW(drbg->reseed(entropy.data(), entropy.size(), additional.data(), 33), std::invalid_argument);
+}
+
+TEST(CamelliaValueContextTest, ctr_value_context)
+{
+    const key_256bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    const ctr_iv_t iv2 = 0x01'02'03'04'05'06'07'08_byte_array;
+    auto& plain = static_random_bytes_1m();
+
+    const auto key128 = reinterpret_cast<const key_128bit_t*>(&key);
+    const auto key192 = reinterpret_cast<const key_192bit_t*>(&key);
+
+    const auto test = [&](auto& ctx, ctr_context_t* expected_context)
+    {
+        std::vector<std::byte> expected(4096);
+        expected_context->process_bytes(expected.data(), plain.data(), 0, expected.size());
+        for (size_t i : {0, 1, 15, 16, 17, 511, 512, 513})
+            for (size_t j : {0, 1, 15, 16, 17, 511, 512, 513, 3000})
+            {
+                std::vector<std::byte> x(j + 2);
+                ctx.process_bytes(x.data() + 1, plain.data() + i, i, j);
+                EXPECT_EQ(x[0], std::byte{});
+                EXPECT_EQ(memcmp(x.data() + 1, expected.data() + i, j), 0) << "backend=" << static_cast<int>(ctx.backend()) << " i=" << i << " j=" << j;
+                EXPECT_EQ(x[j + 1], std::byte{});
+            }
+    };
+
+    for (auto backend : {backend_t::automatic, backend_t::ia32, backend_t::avx2, backend_t::sseaesni, backend_t::avx2aesni})
+    {
+        if ((backend == backend_t::avx2 && !cpu_supports_avx2()) ||
+            (backend == backend_t::sseaesni && !cpu_supports_sseaesni()) ||
+            (backend == backend_t::avx2aesni && !cpu_supports_avx2aesni()))
+        {
+            EXPECT_THROW(ctr128_t(key128, &iv, &nonce, backend), std::invalid_argument);
+            continue;
+        }
+
+        ctr128_t ctx128(key128, &iv, &nonce, backend);
+        ctr192_t ctx192(key192, &iv, &nonce, backend);
+        ctr256_t ctx256(&key, &iv, &nonce, backend);
+        EXPECT_EQ(ctx128.backend(), backend);
+        test(ctx128, create_ctr_context(key128, &iv, &nonce).get());
+        test(ctx192, create_ctr_context(key192, &iv, &nonce).get());
+        test(ctx256, create_ctr_context(&key, &iv, &nonce).get());
+
+        // rekey in place
+        ctx128.rekey(key128, &iv2, &nonce);
+        EXPECT_EQ(ctx128.backend(), ctr128_t(key128, &iv, &nonce, backend).backend());
+        test(ctx128, create_ctr_context(key128, &iv2, &nonce).get());
+    }
+
+    // unkeyed context
+    ctr256_t ctx;
+    std::byte x[16]{};
+    EXPECT_THROW(ctx.process_bytes(x, x, 0, sizeof(x)), std::logic_error);
+    ctx.rekey(&key, &iv, &nonce);
+    test(ctx, create_ctr_context(&key, &iv, &nonce).get());
+
+    // moved-from context is wiped and unkeyed
+    ctr256_t moved = std::move(ctx);
+    test(moved, create_ctr_context(&key, &iv, &nonce).get());
+    EXPECT_THROW(ctx.generate(x, 0, sizeof(x)), std::logic_error);
+    ctx = std::move(moved);
+    test(ctx, create_ctr_context(&key, &iv, &nonce).get());
+    EXPECT_THROW(moved.generate(x, 0, sizeof(x)), std::logic_error);
+    moved.rekey(&key, &iv2, &nonce);
+    test(moved, create_ctr_context(&key, &iv2, &nonce).get());
+}
+
+namespace
+{
+    template <class ctr_t>
+    void test_batch_rekey()
+    {
+        using key_t = typename ctr_t::key_t;
+        auto& random = static_random_bytes_1m();
+        for (size_t count : {0, 1, 3, 31, 32, 33, 100})
+        {
+            std::vector<const key_t*> keys(count);
+            std::vector<const ctr_iv_t*> ivs(count);
+            std::vector<const ctr_nonce_t*> nonces(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                keys[i] = reinterpret_cast<const key_t*>(random.data() + i * 37);
+                ivs[i] = reinterpret_cast<const ctr_iv_t*>(random.data() + 65536 + i * 13);
+                nonces[i] = reinterpret_cast<const ctr_nonce_t*>(random.data() + 131072 + i * 7);
+            }
+
+            // half of the contexts are unkeyed, the other half are rekeyed over another key.
+            std::vector<ctr_t> contexts(count);
+            for (size_t i = 0; i < count; i += 2)
+                contexts[i].rekey(keys[count - 1 - i], ivs[0], nonces[0]);
+
+            ctr_t::rekey(contexts.data(), keys.data(), ivs.data(), nonces.data(), count);
+            for (size_t i = 0; i < count; i++)
+            {
+                std::array<std::byte, 100> expected{}, actual{};
+                create_ctr_context(keys[i], ivs[i], nonces[i])->generate(expected.data(), 5, expected.size());
+                contexts[i].generate(actual.data(), 5, actual.size());
+                EXPECT_EQ(actual, expected) << "key_bits=" << sizeof(key_t) * 8 << " count=" << count << " i=" << i;
+            }
+        }
+    }
+}
+
+TEST(CamelliaValueContextTest, batch_rekey)
+{
+    test_batch_rekey<ctr128_t>();
+    test_batch_rekey<ctr192_t>();
+    test_batch_rekey<ctr256_t>();
+}
+
+TEST(CamelliaMultiKeyJobsTest, ecb_jobs)
+{
+    auto& source = static_random_bytes_1m();
+
+    for (size_t job_count : {1, 5, 32, 100})
+    {
+        std::vector<key_256bit_t> keys(job_count);
+        std::vector<std::vector<std::byte>> outputs(job_count);
+        std::vector<ecb_job_t<key_256bit_t>> jobs(job_count);
+        for (size_t i = 0; i < job_count; i++)
+        {
+            memcpy(keys[i].data(), source.data() + i * 32, 32);
+            outputs[i].resize((i % 13 == 12 ? 4096 : i * 7 % 67) * 16);
+            jobs[i] = {&keys[i], outputs[i].data(), source.data() + i * 16, outputs[i].size()};
+        }
+
+        process_ecb_encrypt_jobs(jobs.data(), jobs.size());
+
+        for (size_t i = 0; i < job_count; i++)
+        {
+            std::vector<std::byte> expected(outputs[i].size());
+            create_ecb_encrypt_context(&keys[i])->process_blocks(expected.data(), source.data() + i * 16, expected.size());
+            EXPECT_EQ(outputs[i], expected) << "job_count=" << job_count << " i=" << i;
+            jobs[i].src = jobs[i].dst; // in-place
+        }
+
+        process_ecb_decrypt_jobs(jobs.data(), jobs.size());
+
+        for (size_t i = 0; i < job_count; i++)
+            EXPECT_EQ(memcmp(outputs[i].data(), source.data() + i * 16, outputs[i].size()), 0) << "job_count=" << job_count << " i=" << i;
+    }
+
+    // invalid length
+    key_128bit_t key{};
+    std::byte buf[17]{};
+    const ecb_job_t<key_128bit_t> job{&key, buf, buf, 17};
+    EXPECT_THROW(process_ecb_encrypt_jobs(&job, 1), std::invalid_argument);
+}
+
+TEST(CamelliaMultiKeyJobsTest, ctr_jobs)
+{
+    auto& source = static_random_bytes_1m();
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+
+    for (size_t job_count : {1, 5, 32, 100})
+    {
+        std::vector<key_128bit_t> keys(job_count);
+        std::vector<ctr_iv_t> ivs(job_count);
+        std::vector<std::vector<std::byte>> outputs(job_count);
+        std::vector<ctr_job_t<key_128bit_t>> jobs(job_count);
+        for (size_t i = 0; i < job_count; i++)
+        {
+            memcpy(keys[i].data(), source.data() + i * 16, 16);
+            memcpy(ivs[i].data(), source.data() + i * 16 + 3, 8);
+            outputs[i].resize(i % 13 == 12 ? 65536 + i : i * 37 % 301);
+            jobs[i] = {&keys[i], &ivs[i], &nonce, outputs[i].data(), i % 4 ? source.data() + i * 16 : nullptr, i * 5 % 33, outputs[i].size()};
+        }
+
+        process_ctr_jobs(jobs.data(), jobs.size());
+
+        for (size_t i = 0; i < job_count; i++)
+        {
+            std::vector<std::byte> expected(outputs[i].size());
+            create_ctr_context(&keys[i], &ivs[i], &nonce)->process_bytes(expected.data(), jobs[i].src, jobs[i].position, expected.size());
+            EXPECT_EQ(outputs[i], expected) << "job_count=" << job_count << " i=" << i;
+        }
+    }
+}
+
+namespace
+{
+    template <class key_t, class key_vector_t>
+    void test_batched_key_vectors(key_vector_t (*generate)(const key_t*), void (*generate_batch)(key_vector_t*, const key_t* const*, size_t))
+    {
+        auto& random = static_random_bytes_1m();
+        for (size_t count : {0, 1, 3, 4, 31, 32, 33, 100})
+        {
+            std::vector<const key_t*> keys(count);
+            for (size_t i = 0; i < count; i++)
+                keys[i] = reinterpret_cast<const key_t*>(random.data() + i * 37);
+
+            std::vector<key_vector_t> actual(count);
+            generate_batch(actual.data(), keys.data(), count);
+            for (size_t i = 0; i < count; i++)
+            {
+                const key_vector_t expected = generate(keys[i]);
+                EXPECT_EQ(memcmp(&actual[i], &expected, sizeof(key_vector_t)), 0) << "key_bits=" << sizeof(key_t) * 8 << " count=" << count << " i=" << i;
+            }
+        }
+    }
+}
+
+TEST(CamelliaKeyScheduleTest, batched_key_vectors)
+{
+    test_batched_key_vectors<key_128bit_t, key_vector_small_t>(generate_key_vector_encrypt, generate_key_vectors_encrypt);
+    test_batched_key_vectors<key_192bit_t, key_vector_large_t>(generate_key_vector_encrypt, generate_key_vectors_encrypt);
+    test_batched_key_vectors<key_256bit_t, key_vector_large_t>(generate_key_vector_encrypt, generate_key_vectors_encrypt);
+    test_batched_key_vectors<key_128bit_t, key_vector_small_t>(generate_key_vector_decrypt, generate_key_vectors_decrypt);
+    test_batched_key_vectors<key_192bit_t, key_vector_large_t>(generate_key_vector_decrypt, generate_key_vectors_decrypt);
+    test_batched_key_vectors<key_256bit_t, key_vector_large_t>(generate_key_vector_decrypt, generate_key_vectors_decrypt);
+
+    if (cpu_supports_avx2aesni())
+    {
+        test_batched_key_vectors<key_128bit_t, key_vector_small_t>(generate_key_vector_encrypt, generate_key_vectors_encrypt_avx2aesni);
+        test_batched_key_vectors<key_192bit_t, key_vector_large_t>(generate_key_vector_encrypt, generate_key_vectors_encrypt_avx2aesni);
+        test_batched_key_vectors<key_256bit_t, key_vector_large_t>(generate_key_vector_encrypt, generate_key_vectors_encrypt_avx2aesni);
+        test_batched_key_vectors<key_128bit_t, key_vector_small_t>(generate_key_vector_decrypt, generate_key_vectors_decrypt_avx2aesni);
+        test_batched_key_vectors<key_192bit_t, key_vector_large_t>(generate_key_vector_decrypt, generate_key_vectors_decrypt_avx2aesni);
+        test_batched_key_vectors<key_256bit_t, key_vector_large_t>(generate_key_vector_decrypt, generate_key_vectors_decrypt_avx2aesni);
+    }
+}
+
+TEST(CamelliaKeyScheduleTest, wipe_on_destruction)
+{
+    // key schedules are not cached (see README): each context wipes its own copy when it is destroyed.
+    // the stores are at the end of the objects' lifetime, so they would be elided as dead without the barrier in secure_memzero.
+    auto& random = static_random_bytes_1m();
+    const auto* key = reinterpret_cast<const key_256bit_t*>(random.data());
+    const auto* iv = reinterpret_cast<const ctr_iv_t*>(random.data() + 32);
+    const auto* nonce = reinterpret_cast<const ctr_nonce_t*>(random.data() + 40);
+
+    struct secret_t
+    {
+        key_vector_large_t kv;
+        ~secret_t() { arkana::bit::secure_be_zero(kv); }
+    };
+
+    {
+        alignas(secret_t) std::byte storage[sizeof(secret_t)];
+        auto* secret = new(storage) secret_t{generate_key_vector_encrypt(key)};
+        secret->~secret_t();
+        EXPECT_TRUE(std::all_of(std::begin(storage), std::end(storage), [](std::byte b) { return b == std::byte{}; }));
+    }
+
+    {
+        const key_vector_large_t kv = generate_key_vector_encrypt(key);
+        alignas(ctr256_t) std::byte storage[sizeof(ctr256_t)];
+        auto* ctx = new(storage) ctr256_t(key, iv, nonce);
+        ctx->~ctr256_t();
+        for (size_t i = 0; i + 8 <= sizeof(kv); i += 8)
+            EXPECT_EQ(std::search(std::begin(storage), std::end(storage), kv.buffer.data() + i, kv.buffer.data() + i + 8), std::end(storage)) << "i=" << i;
+    }
+}
+
+TEST(CamelliaCmacTest, cmac_test_vectors)
+{
+    // RFC 4493 messages, tags by an independent implementation (OpenSSL CMAC with CAMELLIA-*-CBC)
+    const auto message = 0x6b'c1'be'e2'2e'40'9f'96'e9'3d'7e'11'73'93'17'2a'ae'2d'8a'57'1e'03'ac'9c'9e'b7'6f'ac'45'af'8e'51'30'c8'1c'46'a3'5c'e4'11'e5'fb'c1'19'1a'0a'52'ef'f6'9f'24'45'df'4f'9b'17'ad'2b'41'7b'e6'6c'37'10_byte_array;
+
+    {
+        const key_128bit_t key = 0x2b'7e'15'16'28'ae'd2'a6'ab'f7'15'88'09'cf'4f'3c_byte_array;
+        auto ctx = create_cmac_context(&key);
+        ctx->process_bytes(message.data(), 0);
+        EXPECT_EQ(ctx->finalize(), 0xba'92'57'82'aa'a1'f5'd9'a0'0f'89'64'80'94'fc'71_byte_array);
+        ctx->process_bytes(message.data(), 16);
+        EXPECT_EQ(ctx->finalize(), 0x6d'96'28'54'a3'b9'fd'a5'6d'7d'45'a9'5e'e1'79'93_byte_array);
+        ctx->process_bytes(message.data(), 40);
+        EXPECT_EQ(ctx->finalize(), 0x5c'18'd1'19'cc'd6'76'61'44'ac'18'66'13'1d'9f'22_byte_array);
+        ctx->process_bytes(message.data(), 64);
+        EXPECT_EQ(ctx->finalize(), 0xc2'69'9a'6e'ba'55'ce'9d'93'9a'8a'4e'19'46'6e'e9_byte_array);
+    }
+
+    {
+        const key_256bit_t key = 0x60'3d'eb'10'15'ca'71'be'2b'73'ae'f0'85'7d'77'81'1f'35'2c'07'3b'61'08'd7'2d'98'10'a3'09'14'df'f4_byte_array;
+        auto ctx = create_cmac_context(&key);
+        EXPECT_EQ(ctx->finalize(), 0x01'e1'f2'fd'ac'3a'30'05'5b'3d'ba'fd'ea'11'90'78_byte_array);
+        ctx->process_bytes(message.data(), 40);
+        EXPECT_EQ(ctx->finalize(), 0x78'00'be'58'2a'd6'2c'ae'e6'a0'2e'c6'8c'5e'cd'67_byte_array);
+    }
+}
+
+TEST(CamelliaCmacTest, cmac_partial128)
+{
+    const key_128bit_t key = 0x2b'7e'15'16'28'ae'd2'a6'ab'f7'15'88'09'cf'4f'3c_byte_array;
+    auto& message = static_random_bytes_1m();
+    auto ctx = create_cmac_context(&key);
+
+    for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 4096, 4097, 65536})
+    {
+        ctx->process_bytes(message.data(), length);
+        const auto expected = ctx->finalize();
+
+        for (size_t piece : {1, 7, 16, 17, 48, 1000})
+        {
+            for (size_t i = 0; i < length; i += piece)
+                ctx->process_bytes(message.data() + i, std::min(piece, length - i));
+            EXPECT_EQ(ctx->finalize(), expected) << "length=" << length << " piece=" << piece;
+        }
+    }
+}
+
+TEST(CamelliaCmacTest, cmac_jobs)
+{
+    auto& message = static_random_bytes_1m();
+
+    for (size_t job_count : {1, 5, 32, 100})
+    {
+        std::vector<key_256bit_t> keys(job_count);
+        std::vector<cmac_tag_t> tags(job_count);
+        std::vector<cmac_job_t<key_256bit_t>> jobs(job_count);
+        for (size_t i = 0; i < job_count; i++)
+        {
+            memcpy(keys[i].data(), message.data() + i * 32, 32);
+            jobs[i] = {&keys[i], message.data() + i * 509, i * 37 % 600, &tags[i]};
+        }
+
+        process_cmac_jobs(jobs.data(), jobs.size());
+
+        for (size_t i = 0; i < job_count; i++)
+        {
+            auto ctx = create_cmac_context(&keys[i]);
+            ctx->process_bytes(jobs[i].src, jobs[i].length);
+            EXPECT_EQ(tags[i], ctx->finalize()) << "job_count=" << job_count << " i=" << i;
+        }
+    }
+}
+
+TEST(CamelliaCcmTest, ccm_test_vectors)
+{
+    // ciphertext || tag by an independent implementation (RFC 3610 formatting over OpenSSL CAMELLIA-*-ECB)
+    auto test = [](auto ctx, const auto& nonce, const auto& aad, const auto& plain, const auto& cipher, const auto& tag)
+    {
+        std::vector<std::byte> buffer(plain.size());
+        std::vector<std::byte> t(tag.size());
+        ctx->encrypt(buffer.data(), plain.data(), plain.size(), nonce.data(), nonce.size(), aad.data(), aad.size(), t.data(), t.size());
+        EXPECT_EQ(memcmp(buffer.data(), cipher.data(), cipher.size()), 0);
+        EXPECT_EQ(memcmp(t.data(), tag.data(), tag.size()), 0);
+
+        EXPECT_TRUE(ctx->decrypt(buffer.data(), buffer.data(), buffer.size(), nonce.data(), nonce.size(), aad.data(), aad.size(), t.data(), t.size()));
+        EXPECT_EQ(memcmp(buffer.data(), plain.data(), plain.size()), 0);
+
+        t[0] ^= std::byte{1};
+        EXPECT_FALSE(ctx->decrypt(buffer.data(), cipher.data(), cipher.size(), nonce.data(), nonce.size(), aad.data(), aad.size(), t.data(), t.size()));
+        EXPECT_EQ(buffer, std::vector<std::byte>(buffer.size()));
+    };
+
+    const auto message = 0x6b'c1'be'e2'2e'40'9f'96'e9'3d'7e'11'73'93'17'2a'ae'2d'8a'57'1e'03'ac'9c'9e'b7'6f'ac'45'af'8e'51'30'c8'1c'46'a3'5c'e4'11'e5'fb'c1'19'1a'0a'52'ef'f6'9f'24'45'df'4f'9b'17'ad'2b'41'7b'e6'6c'37'10_byte_array;
+
+    {
+        // RFC 5528 packet vector #1
+        const key_128bit_t key = 0xc0'c1'c2'c3'c4'c5'c6'c7'c8'c9'ca'cb'cc'cd'ce'cf_byte_array;
+        test(create_ccm_context(&key),
+             0x00'00'00'03'02'01'00'a0'a1'a2'a3'a4'a5_byte_array,
+             0x00'01'02'03'04'05'06'07_byte_array,
+             0x08'09'0a'0b'0c'0d'0e'0f'10'11'12'13'14'15'16'17'18'19'1a'1b'1c'1d'1e_byte_array,
+             0xba'73'71'85'e7'19'31'04'92'f3'8a'5f'12'51'da'55'fa'fb'c9'49'84'8a'0d_byte_array,
+             0xfc'ae'ce'74'6b'3d'b9'ad_byte_array);
+    }
+
+    {
+        // 96-bit nonce, no aad, 128-bit tag
+        const key_256bit_t key = 0x60'3d'eb'10'15'ca'71'be'2b'73'ae'f0'85'7d'77'81'1f'35'2c'07'3b'61'08'd7'2d'98'10'a3'09'14'df'f4_byte_array;
+        std::array<std::byte, 40> plain{};
+        memcpy(plain.data(), message.data(), plain.size());
+        test(create_ccm_context(&key),
+             0x00'01'02'03'04'05'06'07'08'09'0a'0b_byte_array,
+             std::array<std::byte, 0>{},
+             plain,
+             0x24'af'12'a6'0f'b0'9d'83'5a'd6'd9'6b'53'12'24'b1'22'e1'75'bf'15'5d'd4'f2'2c'a5'd4'4b'48'6d'01'e0'aa'b0'74'42'71'c4'31'61_byte_array,
+             0x42'74'd1'5a'7f'dd'19'19'0e'fc'68'f3'd9'5f'04'c8_byte_array);
+    }
+
+    {
+        // 56-bit nonce, 300-byte aad, 32-bit tag
+        const key_128bit_t key = 0x2b'7e'15'16'28'ae'd2'a6'ab'f7'15'88'09'cf'4f'3c_byte_array;
+        std::array<std::byte, 300> aad{};
+        for (size_t i = 0; i < aad.size(); i++) aad[i] = static_cast<std::byte>(i);
+        test(create_ccm_context(&key),
+             0x00'01'02'03'04'05'06_byte_array,
+             aad,
+             message,
+             0x8c'd5'0c'73'11'd2'35'8a'92'ac'8a'61'01'46'42'6b'ff'16'12'56'bb'6f'85'38'c5'b9'06'7e'dc'f3'e7'c9'a0'c0'fe'fd'44'8c'44'32'd1'48'f0'a9'c6'59'fb'64'b6'1a'6f'84'de'25'a7'b0'19'04'76'57'83'a6'0e'f0_byte_array,
+             0x47'39'ba'87_byte_array);
+    }
+
+    {
+        // 64 KiB aad (6-byte length encoding), payload across chunks
+        const key_128bit_t key = 0x2b'7e'15'16'28'ae'd2'a6'ab'f7'15'88'09'cf'4f'3c_byte_array;
+        const auto nonce = 0x00'01'02'03'04'05'06'07'08'09'0a'0b'0c_byte_array;
+        std::vector<std::byte> aad(65536), plain(5000), cipher(plain.size());
+        for (size_t i = 0; i < aad.size(); i++) aad[i] = static_cast<std::byte>(i * 7);
+        for (size_t i = 0; i < plain.size(); i++) plain[i] = static_cast<std::byte>(i * 13);
+
+        // payload keystream: be128 counter blocks from A_0 = (L - 1) || nonce || 0, at position 16
+        block_t a0{};
+        a0[0] = std::byte{1};
+        memcpy(a0.data() + 1, nonce.data(), nonce.size());
+        create_ctr_context(&key, &a0, ctr_layout_t::be128)->process_bytes(cipher.data(), plain.data(), 16, plain.size());
+
+        test(create_ccm_context(&key), nonce, aad, plain, cipher, 0xdb'fa'2f'fb'74'c2'62'2d'1d'd8'62'52'11'dd'6c'65_byte_array);
+    }
+}
+
+TEST(CamelliaCcmTest, ccm_partial128)
+{
+    const key_128bit_t key = 0xc0'c1'c2'c3'c4'c5'c6'c7'c8'c9'ca'cb'cc'cd'ce'cf_byte_array;
+    const auto nonce = 0x00'00'00'03'02'01'00'a0'a1'a2'a3'a4'a5_byte_array;
+    auto& plain = static_random_bytes_1m();
+    auto ctx = create_ccm_context(&key);
+
+    for (size_t length : {0, 1, 15, 16, 17, 511, 512, 4095, 4096, 4097, 12345})
+        for (size_t aad_length : {0, 1, 14, 15, 16, 100})
+        {
+            std::vector<std::byte> buffer(length);
+            block_t tag{};
+            ctx->encrypt(buffer.data(), plain.data(), length, nonce.data(), nonce.size(), plain.data() + length, aad_length, tag.data(), tag.size());
+            EXPECT_TRUE(ctx->decrypt(buffer.data(), buffer.data(), length, nonce.data(), nonce.size(), plain.data() + length, aad_length, tag.data(), tag.size()));
+            EXPECT_EQ(memcmp(buffer.data(), plain.data(), length), 0) << "length=" << length << " aad_length=" << aad_length;
+
+            // in-place, with a forged tag
+            ctx->encrypt(buffer.data(), buffer.data(), length, nonce.data(), nonce.size(), plain.data() + length, aad_length, tag.data(), 8);
+            tag[7] ^= std::byte{0x80};
+            EXPECT_FALSE(ctx->decrypt(buffer.data(), buffer.data(), length, nonce.data(), nonce.size(), plain.data() + length, aad_length, tag.data(), 8));
+            EXPECT_EQ(buffer, std::vector<std::byte>(length));
+        }
+
+    std::vector<std::byte> buffer(65536);
+    block_t tag{};
+    EXPECT_THROW(ctx->encrypt(buffer.data(), plain.data(), 16, nonce.data(), 6, nullptr, 0, tag.data(), 16), std::invalid_argument);
+    EXPECT_THROW(ctx->encrypt(buffer.data(), plain.data(), 16, nonce.data(), 13, nullptr, 0, tag.data(), 5), std::invalid_argument);
+    EXPECT_THROW(ctx->encrypt(buffer.data(), plain.data(), 65536, nonce.data(), 13, nullptr, 0, tag.data(), 16), std::invalid_argument);
+}
+
+TEST(CamelliaCtrCrc32Test, ctr_crc32_partial128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+    auto ctx = create_ctr_context(&key, &iv, &nonce);
+
+    std::vector<std::byte> expected(plain.size());
+    ctx->process_bytes(expected.data(), plain.data(), 0, plain.size());
+    const auto expected_crc = arkana::crc32::calculate_crc32(expected.data(), expected.size());
+
+    for (size_t n : {1, 15, 16, 17, 8191, 8192, 8193, 100000, 1048576})
+    {
+        // encrypt in place
+        auto buffer = plain;
+        arkana::crc32::crc32_value_t crc = 0;
+        for (size_t i = 0; i < buffer.size(); i += n)
+            crc = encrypt_bytes_ctr_crc32(ctx.get(), buffer.data() + i, buffer.data() + i, i, std::min(n, buffer.size() - i), crc);
+        EXPECT_EQ(buffer, expected) << "n=" << n;
+        EXPECT_EQ(crc, expected_crc) << "n=" << n;
+
+        // decrypt in place
+        crc = 0;
+        for (size_t i = 0; i < buffer.size(); i += n)
+            crc = decrypt_bytes_ctr_crc32(ctx.get(), buffer.data() + i, buffer.data() + i, i, std::min(n, buffer.size() - i), crc);
+        EXPECT_EQ(buffer, plain) << "n=" << n;
+        EXPECT_EQ(crc, expected_crc) << "n=" << n;
+    }
+}
+
+TEST(CamelliaCtrCrc32Test, ctr_crc32_benchmark128)
+{
+    auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    auto nonce = 0x00'00'00'30_byte_array;
+#ifndef NDEBUG
+    auto& source = static_random_bytes_1m();
+#else
+    auto& source = static_random_bytes_256m();
+#endif
+    auto buffer = source;
+    auto ctx = create_ctr_context(&key, &iv, &nonce);
+    auto crc1 = encrypt_bytes_ctr_crc32(ctx.get(), buffer.data(), buffer.data(), 0, buffer.size());
+    auto crc2 = decrypt_bytes_ctr_crc32(ctx.get(), buffer.data(), buffer.data(), 0, buffer.size());
+    EXPECT_EQ(crc1, crc2);
+    EXPECT_EQ(source, buffer);
+}
+
+TEST(CamelliaCtrSha256Test, ctr_hmac_sha256_partial128)
+{
+    const key_128bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    const auto mac_key = 0x00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    auto& plain = static_random_bytes_1m();
+    auto ctx = create_ctr_context(&key, &iv, &nonce);
+
+    std::vector<std::byte> expected(plain.size());
+    ctx->process_bytes(expected.data(), plain.data(), 0, plain.size());
+    auto expected_mac = arkana::sha2::create_hmac_sha256_context(mac_key.data(), mac_key.size());
+    expected_mac->process_bytes(expected.data(), expected.size());
+    const auto expected_digest = expected_mac->finalize();
+
+    for (size_t n : {1, 63, 64, 65, 16383, 16384, 16385, 100000, 1048576})
+    {
+        // encrypt in place
+        auto buffer = plain;
+        auto mac = arkana::sha2::create_hmac_sha256_context(mac_key.data(), mac_key.size());
+        for (size_t i = 0; i < buffer.size(); i += n)
+            encrypt_bytes_ctr_sha256(ctx.get(), mac.get(), buffer.data() + i, buffer.data() + i, i, std::min(n, buffer.size() - i));
+        EXPECT_EQ(buffer, expected) << "n=" << n;
+        EXPECT_EQ(mac->finalize(), expected_digest) << "n=" << n;
+
+        // decrypt in place
+        mac = arkana::sha2::create_hmac_sha256_context(mac_key.data(), mac_key.size());
+        for (size_t i = 0; i < buffer.size(); i += n)
+            decrypt_bytes_ctr_sha256(ctx.get(), mac.get(), buffer.data() + i, buffer.data() + i, i, std::min(n, buffer.size() - i));
+        EXPECT_EQ(buffer, plain) << "n=" << n;
+        EXPECT_EQ(mac->finalize(), expected_digest) << "n=" << n;
+    }
+}
+
+TEST(CamelliaDispatchTest, backend_thresholds)
+{
+    const key_256bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+
+    const auto default_thresholds = get_backend_thresholds();
+    for (backend_thresholds_t thresholds : {backend_thresholds_t{0, 0, 0, SIZE_MAX}, {64, 160, 64, SIZE_MAX}, {48, 48, 48, SIZE_MAX}, {48, 1024, 256, SIZE_MAX}, {1024, 1024, 1024, SIZE_MAX}, {SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX}})
+    {
+        set_backend_thresholds(thresholds);
+        EXPECT_EQ(get_backend_thresholds().avx2, thresholds.avx2);
+        EXPECT_EQ(get_backend_thresholds().avx2aesni, thresholds.avx2aesni);
+        EXPECT_EQ(get_backend_thresholds().sseaesni, thresholds.sseaesni);
+
+        auto ecb = create_ecb_encrypt_context(&key);
+        auto ecb_inv = create_ecb_decrypt_context(&key);
+        auto ctr = create_ctr_context(&key, &iv, &nonce);
+        for (size_t length : {16, 32, 48, 64, 128, 160, 176, 512, 1024, 4096})
+        {
+            std::vector<std::byte> expected(length), actual(length);
+            create_ecb_encrypt_context_ia32(&key)->process_blocks(expected.data(), plain.data(), length);
+            ecb->process_blocks(actual.data(), plain.data(), length);
+            EXPECT_EQ(actual, expected);
+            ecb_inv->process_blocks(actual.data(), actual.data(), length);
+            EXPECT_EQ(memcmp(actual.data(), plain.data(), length), 0);
+
+            std::fill(expected.begin(), expected.end(), std::byte{});
+            std::fill(actual.begin(), actual.end(), std::byte{});
+            create_ctr_context_ia32(&key, &iv, &nonce)->process_bytes(expected.data(), plain.data(), 5, length - 1);
+            ctr->process_bytes(actual.data(), plain.data(), 5, length - 1);
+            EXPECT_EQ(actual, expected);
+        }
+    }
+    set_backend_thresholds(default_thresholds);
+}
+
+TEST(CamelliaDispatchTest, concurrent_first_use)
+{
+    const key_256bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+
+    std::vector<std::byte> expected(65536);
+    create_ctr_context_ia32(&key, &iv, &nonce)->process_bytes(expected.data(), plain.data(), 0, expected.size());
+
+    // the backends are built on their first selection, which may happen on several threads at once.
+    auto ctr = create_ctr_context(&key, &iv, &nonce);
+    std::vector<std::vector<std::byte>> actual(4, std::vector<std::byte>(expected.size()));
+    std::vector<std::thread> threads;
+    for (auto& a : actual)
+        threads.emplace_back([&] { ctr->process_bytes(a.data(), plain.data(), 0, a.size()); });
+    for (auto& t : threads) t.join();
+    for (auto& a : actual) EXPECT_EQ(a, expected);
+}
+
+TEST(CamelliaDispatchTest, streaming_stores)
+{
+    if (!cpu_supports_avx2aesni()) return;
+
+    const key_256bit_t key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+    const ctr_iv_t iv = 0x00'00'00'00'00'00'00'00_byte_array;
+    const ctr_nonce_t nonce = 0x00'00'00'30_byte_array;
+    auto& plain = static_random_bytes_1m();
+
+    const auto default_thresholds = get_backend_thresholds();
+    auto thresholds = default_thresholds;
+    thresholds.streaming = 0;
+    set_backend_thresholds(thresholds);
+    EXPECT_EQ(get_backend_thresholds().streaming, 0u);
+    auto ecb = create_ecb_encrypt_context_avx2aesni(&key);
+    auto ctr = create_ctr_context_avx2aesni(&key, &iv, &nonce);
+    set_backend_thresholds(default_thresholds);
+
+    auto ecb_ia32 = create_ecb_encrypt_context_ia32(&key);
+    auto ctr_ia32 = create_ctr_context_ia32(&key, &iv, &nonce);
+    std::vector<std::byte> expected(65536 + 64), actual(65536 + 64);
+    for (size_t offset : {0, 8, 16, 32, 48})
+    {
+        for (size_t length : {16, 32, 512, 528, 4096, 4112, 65536})
+        {
+            std::fill(expected.begin(), expected.end(), std::byte{});
+            std::fill(actual.begin(), actual.end(), std::byte{});
+            ecb_ia32->process_blocks(expected.data() + offset, plain.data(), length);
+            ecb->process_blocks(actual.data() + offset, plain.data(), length);
+            EXPECT_EQ(actual, expected) << "offset=" << offset << " length=" << length;
+
+            for (size_t position : {0, 16, 37, 512})
+            {
+                std::fill(expected.begin(), expected.end(), std::byte{});
+                std::fill(actual.begin(), actual.end(), std::byte{});
+                ctr_ia32->process_bytes(expected.data() + offset, plain.data(), position, length - 3);
+                ctr->process_bytes(actual.data() + offset, plain.data(), position, length - 3);
+                EXPECT_EQ(actual, expected) << "offset=" << offset << " position=" << position << " length=" << length - 3;
+                ctr->generate(actual.data() + offset, position, length);
+                ctr_ia32->generate(expected.data() + offset, position, length);
+                EXPECT_EQ(actual, expected) << "offset=" << offset << " position=" << position << " length=" << length << " (keystream)";
+            }
+        }
+    }
+}
+
+// compares avx2aesni ecb/ctr over the whole benchmark source with and without non-temporal stores.
+struct CamelliaStreamingTest : testing::Test
+{
+    static const auto& source_for_benchmark() { return CamelliaTest<void>::source_for_benchmark(); }
+
+    static void ecb_benchmark256(size_t streaming)
+    {
+        if (!cpu_supports_avx2aesni()) return;
+        auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+        auto& source = source_for_benchmark();
+        auto buffer = source;
+
+        const auto default_thresholds = get_backend_thresholds();
+        set_backend_thresholds({default_thresholds.avx2, default_thresholds.avx2aesni, default_thresholds.sseaesni, streaming});
+        auto encrypt = create_ecb_encrypt_context_avx2aesni(&key);
+        auto decrypt = create_ecb_decrypt_context_avx2aesni(&key);
+        set_backend_thresholds(default_thresholds);
+
+        encrypt->process_blocks(buffer.data(), buffer.data(), buffer.size());
+        decrypt->process_blocks(buffer.data(), buffer.data(), buffer.size());
+        EXPECT_EQ(source, buffer);
+    }
+
+    static void ctr_benchmark256(size_t streaming)
+    {
+        if (!cpu_supports_avx2aesni()) return;
+        auto key = 0x01'23'45'67'89'ab'cd'ef'fe'dc'ba'98'76'54'32'10'00'11'22'33'44'55'66'77'88'99'aa'bb'cc'dd'ee'ff_byte_array;
+        auto iv = 0x00'00'00'00'00'00'00'00_byte_array;
+        auto nonce = 0x00'00'00'30_byte_array;
+        auto& source = source_for_benchmark();
+        auto buffer = source;
+
+        const auto default_thresholds = get_backend_thresholds();
+        set_backend_thresholds({default_thresholds.avx2, default_thresholds.avx2aesni, default_thresholds.sseaesni, streaming});
+        auto ctr = create_ctr_context_avx2aesni(&key, &iv, &nonce);
+        set_backend_thresholds(default_thresholds);
+
+        ctr->process_bytes(buffer.data(), buffer.data(), 0, buffer.size());
+        ctr->process_bytes(buffer.data(), buffer.data(), 0, buffer.size());
+        EXPECT_EQ(source, buffer);
+    }
+};
+
+TEST_F(CamelliaStreamingTest, ecb_benchmark256_temporal) { ecb_benchmark256(SIZE_MAX); }
+TEST_F(CamelliaStreamingTest, ecb_benchmark256_non_temporal) { ecb_benchmark256(0); }
+TEST_F(CamelliaStreamingTest, ctr_benchmark256_temporal) { ctr_benchmark256(SIZE_MAX); }
+TEST_F(CamelliaStreamingTest, ctr_benchmark256_non_temporal) { ctr_benchmark256(0); }
@@ -119,3 +119,99 @@ struct avx2clmul_impl
 };
 
 INSTANTIATE_TYPED_TEST_SUITE_P(avx2clmul, Crc32Test, avx2clmul_impl);
+
+struct Crc32cTestBase : testing::Test
+{
+#ifndef NDEBUG
+    static inline const auto& data = static_random_bytes_1m();
+#else
+    static inline const auto& data = static_random_bytes_256m();
+#endif
+
+    static inline const crc32_value_t expected_a = calculate_crc32(create_crc32c_context_ref(), data.data() + 0, data.size() - 0);
+    static inline const crc32_value_t expected_u = calculate_crc32(create_crc32c_context_ref(), data.data() + 1, data.size() - 2);
+};
+
+template <typename T>
+struct Crc32cTest : Crc32cTestBase
+{
+};
+
+TYPED_TEST_SUITE_P(Crc32cTest);
+
+TYPED_TEST_P(Crc32cTest, KnownVector)
+{
+    // RFC 3720 B.4. CRC Examples
+    std::array<std::byte, 32> zeros{};
+    std::array<std::byte, 32> ones{};
+    std::array<std::byte, 32> incrementing{};
+    std::array<std::byte, 32> decrementing{};
+    for (size_t i = 0; i < 32; i++)
+    {
+        ones[i] = std::byte{0xFF};
+        incrementing[i] = static_cast<std::byte>(i);
+        decrementing[i] = static_cast<std::byte>(31 - i);
+    }
+
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), zeros.data(), zeros.size()), 0x8A9136AAu);
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), ones.data(), ones.size()), 0x62A8AB43u);
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), incrementing.data(), incrementing.size()), 0x46DD794Eu);
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), decrementing.data(), decrementing.size()), 0x113FDB5Cu);
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), "123456789", 9), 0xE3069283u);
+}
+
+TYPED_TEST_P(Crc32cTest, MatchWithRefImplShort)
+{
+    // covers every block tier boundary and head alignment
+    for (size_t offset = 0; offset < 8; offset++)
+    {
+        for (size_t length = 0; length < 14000; length += length < 256 ? 1 : 61)
+        {
+            const auto* p = TestFixture::data.data() + offset;
+            EXPECT_EQ(calculate_crc32(TypeParam::create_context(), p, length), calculate_crc32c_ref(p, length)) << "offset=" << offset << " length=" << length;
+        }
+    }
+}
+
+TYPED_TEST_P(Crc32cTest, MatchWithRefImpl)
+{
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), TestFixture::data.data() + 0, TestFixture::data.size() - 0), TestFixture::expected_a);
+    EXPECT_EQ(calculate_crc32(TypeParam::create_context(), TestFixture::data.data() + 1, TestFixture::data.size() - 2), TestFixture::expected_u);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(Crc32cTest, KnownVector, MatchWithRefImplShort, MatchWithRefImpl);
+
+struct crc32c_ref_impl
+{
+    static auto create_context() { return create_crc32c_context_ref(); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(ref, Crc32cTest, crc32c_ref_impl);
+
+struct crc32c_ia32_impl
+{
+    static auto create_context() { return create_crc32c_context_ia32(); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(ia32, Crc32cTest, crc32c_ia32_impl);
+
+struct crc32c_avx2_impl
+{
+    static auto create_context() { return create_crc32c_context_avx2(); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(avx2, Crc32cTest, crc32c_avx2_impl);
+
+struct crc32c_avx2clmul_impl
+{
+    static auto create_context() { return create_crc32c_context_avx2clmul(); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(avx2clmul, Crc32cTest, crc32c_avx2clmul_impl);
+
+struct crc32c_sse42clmul_impl
+{
+    static auto create_context() { return create_crc32c_context_sse42clmul(); }
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(sse42clmul, Crc32cTest, crc32c_sse42clmul_impl);
@@ -178,3 +178,17 @@ struct avx2_impl
 };
 
 INSTANTIATE_TYPED_TEST_SUITE_P(avx2, Sha2Test, avx2_impl);
+
+TEST(HmacTest, HmacSha256_Rfc4231_TestVectors)
+{
+    auto hmac = [](const std::vector<std::byte>& key, std::string_view data)
+    {
+        auto ctx = create_hmac_sha256_context(key.data(), key.size());
+        ctx->process_bytes(data.data(), data.size());
+        return ctx->finalize();
+    };
+
+    EXPECT_EQ(hmac(std::vector<std::byte>(20, std::byte{0x0b}), "Hi There"), 0xb0344c61'd8db3853'5ca8afce'af0bf12b'881dc200'c9833da7'26e9376c'2e32cff7_byte_array);
+    EXPECT_EQ(hmac({std::byte{'J'}, std::byte{'e'}, std::byte{'f'}, std::byte{'e'}}, "what do ya want for nothing?"), 0x5bdcc146'bf60754e'6a042426'089575c7'5a003f08'9d273983'9dec58b9'64ec3843_byte_array);
+    EXPECT_EQ(hmac(std::vector<std::byte>(131, std::byte{0xaa}), "Test Using Larger Than Block-Size Key - Hash Key First"), 0x60e43159'1ee0b67f'0d8a26aa'cbf5b77f'8e0bc621'3728c514'0546040f'0ee37f54_byte_array);
+}
@@ -17,3 +17,4 @@
 #include "./ark/lutgen.h"
 #include "./ark/hexilit.h"
 #include "./ark/base64.h"
+#include "./ark/parallel.h"
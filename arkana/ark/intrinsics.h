@@ -27,11 +27,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <cassert>
 
 #include <utility>
 #include <type_traits>
 #include <numeric>
+#include <limits>
 
 namespace arkana::intrinsics
 {
@@ -90,10 +92,12 @@ namespace arkana::intrinsics
     static inline void secure_memzero(uint64_t* memory, size_t count) noexcept { ::__stosd(reinterpret_cast<unsigned long*>(memory), 0, 2 * count); }
 #endif
 #else
-    static inline void secure_memzero(uint8_t* memory, size_t count) { for (size_t i = 0; i < count; i++) static_cast<volatile uint8_t*>(memory)[i] = 0; }
-    static inline void secure_memzero(uint16_t* memory, size_t count) { for (size_t i = 0; i < count; i++) static_cast<volatile uint16_t*>(memory)[i] = 0; }
-    static inline void secure_memzero(uint32_t* memory, size_t count) { for (size_t i = 0; i < count; i++) static_cast<volatile uint32_t*>(memory)[i] = 0; }
-    static inline void secure_memzero(uint64_t* memory, size_t count) { for (size_t i = 0; i < count; i++) static_cast<volatile uint64_t*>(memory)[i] = 0; }
+    // memset followed by a compiler barrier on the memory: the stores cannot be elided as dead, and memset stays vectorized.
+    template <class T> static inline void secure_memzero_barrier(T* memory, size_t count) noexcept { memset(memory, 0, count * sizeof(T)); __asm__ __volatile__("" : : "r"(memory) : "memory"); }
+    static inline void secure_memzero(uint8_t* memory, size_t count) noexcept { secure_memzero_barrier(memory, count); }
+    static inline void secure_memzero(uint16_t* memory, size_t count) noexcept { secure_memzero_barrier(memory, count); }
+    static inline void secure_memzero(uint32_t* memory, size_t count) noexcept { secure_memzero_barrier(memory, count); }
+    static inline void secure_memzero(uint64_t* memory, size_t count) noexcept { secure_memzero_barrier(memory, count); }
 #endif
 
     template <class T, std::enable_if_t<std::is_trivially_destructible_v<T> && sizeof(T) % sizeof(uint32_t) != 0>* = nullptr>
@@ -0,0 +1,162 @@
+/// @file
+/// @brief	arkana::parallel - Simple fork-join worker pool
+/// @author Copyright(c) 2021 ttsuki
+///
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arkana::parallel
+{
+    /// Fork-join worker pool.
+    ///   parallel_for distributes indices [0, count) to the workers and the calling thread,
+    ///   and returns when all indices are processed.
+    class worker_pool_t final
+    {
+    public:
+        /// thread_count: total number of threads including the calling thread. (0: hardware concurrency)
+        explicit worker_pool_t(size_t thread_count = 0)
+        {
+            if (thread_count == 0) thread_count = std::thread::hardware_concurrency();
+            try
+            {
+                for (size_t i = 1; i < thread_count; i++)
+                    workers_.emplace_back([this] { worker_main(); });
+            }
+            catch (...)
+            {
+                // joinable threads must not be destroyed: stop and join the ones already started.
+                terminate_workers();
+                throw;
+            }
+        }
+
+        worker_pool_t(const worker_pool_t& other) = delete;
+        worker_pool_t(worker_pool_t&& other) noexcept = delete;
+        worker_pool_t& operator=(const worker_pool_t& other) = delete;
+        worker_pool_t& operator=(worker_pool_t&& other) noexcept = delete;
+
+        ~worker_pool_t()
+        {
+            terminate_workers();
+        }
+
+        /// Number of threads including the calling thread.
+        [[nodiscard]] size_t thread_count() const noexcept { return workers_.size() + 1; }
+
+        /// Calls f(i) for each i in [0, count) in parallel.
+        ///   The first exception thrown by f is rethrown on the calling thread.
+        template <class F>
+        void parallel_for(size_t count, F&& f)
+        {
+            if (count == 0) return;
+
+            if (workers_.empty() || count == 1)
+            {
+                for (size_t i = 0; i < count; i++) f(i);
+                return;
+            }
+
+            std::lock_guard job_lock(job_mutex_); // one job at a time
+            job_t job{std::function<void(size_t)>(std::ref(f)), count};
+            {
+                std::lock_guard lock(mutex_);
+                job_ = &job;
+                generation_++;
+            }
+            wake_.notify_all();
+
+            run(job);
+
+            {
+                std::unique_lock lock(mutex_);
+                done_.wait(lock, [&] { return job.running_workers == 0 && job.completed == count; });
+                job_ = nullptr;
+            }
+
+            if (job.exception) std::rethrow_exception(job.exception);
+        }
+
+    private:
+        struct job_t
+        {
+            std::function<void(size_t)> f;
+            size_t count;
+            std::atomic<size_t> next{0};
+            size_t completed{0};        // guarded by mutex_
+            size_t running_workers{0};  // guarded by mutex_
+            std::exception_ptr exception{};
+        };
+
+        std::vector<std::thread> workers_{};
+        std::mutex job_mutex_{};
+        std::mutex mutex_{};
+        std::condition_variable wake_{};
+        std::condition_variable done_{};
+        job_t* job_{};
+        size_t generation_{};
+        bool terminating_{};
+
+        void terminate_workers()
+        {
+            {
+                std::lock_guard lock(mutex_);
+                terminating_ = true;
+            }
+            wake_.notify_all();
+            for (auto& t : workers_) t.join();
+        }
+
+        void run(job_t& job)
+        {
+            size_t processed = 0;
+            std::exception_ptr exception{};
+            for (size_t i; (i = job.next.fetch_add(1, std::memory_order_relaxed)) < job.count; processed++)
+            {
+                if (exception) continue; // drain remaining indices
+                try { job.f(i); }
+                catch (...) { exception = std::current_exception(); }
+            }
+
+            std::lock_guard lock(mutex_);
+            job.completed += processed;
+            if (exception && !job.exception) job.exception = exception;
+            done_.notify_all();
+        }
+
+        void worker_main()
+        {
+            size_t seen_generation = 0;
+            while (true)
+            {
+                job_t* job;
+                {
+                    std::unique_lock lock(mutex_);
+                    wake_.wait(lock, [&] { return terminating_ || (job_ && generation_ != seen_generation); });
+                    if (terminating_) return;
+                    seen_generation = generation_;
+                    job = job_;
+                    job->running_workers++;
+                }
+
+                run(*job);
+
+                {
+                    std::lock_guard lock(mutex_);
+                    job->running_workers--;
+                }
+                done_.notify_all();
+            }
+        }
+    };
+}
@@ -4,6 +4,12 @@
 #include <cstdint>
 #include <array>
 
+#if defined(_MSC_VER)
+#define ARKANA_MAY_ALIAS
+#else
+#define ARKANA_MAY_ALIAS [[gnu::may_alias]]
+#endif
+
 namespace arkana
 {
     using byte_t = std::byte;
@@ -24,8 +30,10 @@ namespace arkana
     template <class T, class... Ts> static constexpr bool is_any_of_v = is_any_of<T, Ts...>::value;
 
     /// tagged_memory_buffer
+    ///   An opaque buffer which backends reinterpret as their own structure (see bit::type_punning_cast).
+    ///   It is declared may_alias, so that stores to it are not reordered with the backends' typed loads from it.
     template <class tag, size_t size, class alignment = void*>
-    struct alignas(alignment) tagged_memory_buffer final
+    struct alignas(alignment) ARKANA_MAY_ALIAS tagged_memory_buffer final
     {
         using tag_t = tag;
         byte_array<size> buffer;
@@ -156,9 +156,11 @@ namespace arkana::xmm
         explicit SHIFT(int64_t i) : i(i) { }
 
         ARKXMM_INLINE ARKXMM_VECTORCALL operator XMM<int64_t>() const { return {_mm_set1_epi64x(i)}; }
-        ARKXMM_INLINE ARKXMM_VECTORCALL operator YMM<int64_t>() const { return {_mm256_set1_epi64x(i)}; }
         ARKXMM_INLINE ARKXMM_VECTORCALL operator __m128i() const { return _mm_set1_epi64x(i); }
+#if defined(__AVX__) || defined(_MSC_VER) // returning 256-bit vectors by value needs AVX ABI
+        ARKXMM_INLINE ARKXMM_VECTORCALL operator YMM<int64_t>() const { return {_mm256_set1_epi64x(i)}; }
         ARKXMM_INLINE ARKXMM_VECTORCALL operator __m256i() const { return _mm256_set1_epi64x(i); }
+#endif
     };
 
     namespace enable
@@ -1080,6 +1082,9 @@ namespace arkana::xmm
     // NTA prefetch
     ARKXMM_API prefetch_nta(const void* p) -> void { return _mm_prefetch(static_cast<const char*>(p), _MM_HINT_NTA); }
 
+    // store fence (orders non-temporal stores)
+    ARKXMM_API store_fence() -> void { return _mm_sfence(); }
+
     // PCLMULQDQ carry-less integer multiplication
     template <int i0, int i1> ARKXMM_API clmul(vu64x2 a, vu64x2 b) -> vx128x1 { return {_mm_clmulepi64_si128(a.v, b.v, (i0 & 1) | (i1 & 1) << 4)}; } // PCLMULQDQ carry-less integer multiplication
 
@@ -0,0 +1,150 @@
+/// @file
+/// @brief	arkana::camellia
+///			- Random-access readers and chunked containers of CTR-mode encrypted files
+/// @author Copyright(c) 2021 ttsuki
+/// 
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+
+#include "./camellia.h"
+
+namespace arkana::camellia
+{
+    /// Random-access reader of a CTR-mode encrypted file
+    class ctr_file_reader_t
+    {
+    public:
+        ctr_file_reader_t() = default;
+        ctr_file_reader_t(const ctr_file_reader_t& other) = delete;
+        ctr_file_reader_t(ctr_file_reader_t&& other) noexcept = delete;
+        ctr_file_reader_t& operator=(const ctr_file_reader_t& other) = delete;
+        ctr_file_reader_t& operator=(ctr_file_reader_t&& other) noexcept = delete;
+        virtual ~ctr_file_reader_t() = default;
+
+    public:
+        // File size in bytes.
+        [[nodiscard]] virtual size_t size() const noexcept = 0;
+
+        // Reads plaintext bytes.
+        //   dst: destination buffer.
+        //   position: position in file in bytes.
+        //   length: length in bytes to read.
+        //   returns: length in bytes read. (shorter than length at the end of file)
+        virtual size_t read(void* dst, size_t position, size_t length) = 0;
+    };
+
+    /// Integrity tag of container chunks
+    enum class container_tag_t : uint32_t
+    {
+        crc32 = 1,  // crc32 of the chunk ciphertext
+        sha256 = 2, // SHA-256 of the chunk ciphertext
+    };
+
+    /// Chunked encrypted container writer
+    ///   Layout (integers are little-endian):
+    ///     header (64 bytes): "ARKCNTR\0", version (u32: 2), tag (u32), chunk_size (u32), key_bits (u32), ctr_iv_t, ctr_nonce_t, zero padding (4 bytes),
+    ///       key check (16 bytes: CMAC of the preceding 40 bytes under the key), zero padding.
+    ///     chunks: ciphertext of the plaintext split into chunk_size bytes (the last one may be shorter).
+    ///       chunk i is at offset 64 + i * chunk_size, and encrypted with the RFC 5528 stream positions from i * chunk_size.
+    ///     index: tag of each chunk (crc32: 4 bytes, sha256: 32 bytes).
+    ///     footer (32 bytes): plaintext length (u64), chunk count (u64), index offset (u64), "ARKCEND\0".
+    ///   The tags detect corruption of the ciphertext. They are not keyed, so they do not authenticate it.
+    ///   A container holds at most 2^36 bytes of plaintext, the length of an RFC 5528 stream (its block counter is 32-bit).
+    class container_writer_t
+    {
+    public:
+        container_writer_t() = default;
+        container_writer_t(const container_writer_t& other) = delete;
+        container_writer_t(container_writer_t&& other) noexcept = delete;
+        container_writer_t& operator=(const container_writer_t& other) = delete;
+        container_writer_t& operator=(container_writer_t&& other) noexcept = delete;
+        virtual ~container_writer_t() = default;
+
+    public:
+        // Appends plaintext bytes.
+        //   Buffered chunks are encrypted and tagged in parallel, then written to the stream in order.
+        // Throws std::length_error (and writes nothing) if the container would exceed 2^36 bytes.
+        virtual void write(const void* src, size_t length) = 0;
+
+        // Writes the rest of chunks, the index and the footer.
+        //   The container is incomplete without finish(). No bytes can be written after it.
+        // Throws std::runtime_error if the stream fails.
+        virtual void finish() = 0;
+    };
+
+    /// Chunked encrypted container reader
+    ///   read() is thread-safe.
+    class container_reader_t
+    {
+    public:
+        container_reader_t() = default;
+        container_reader_t(const container_reader_t& other) = delete;
+        container_reader_t(container_reader_t&& other) noexcept = delete;
+        container_reader_t& operator=(const container_reader_t& other) = delete;
+        container_reader_t& operator=(container_reader_t&& other) noexcept = delete;
+        virtual ~container_reader_t() = default;
+
+    public:
+        // Plaintext length in bytes.
+        [[nodiscard]] virtual size_t size() const noexcept = 0;
+
+        // Chunk size in bytes.
+        [[nodiscard]] virtual size_t chunk_size() const noexcept = 0;
+
+        // Number of chunks.
+        [[nodiscard]] virtual size_t chunk_count() const noexcept = 0;
+
+        // Reads plaintext bytes.
+        //   Only the chunks in the range are verified (once for each chunk), and they are decrypted in parallel.
+        //   dst: destination buffer.
+        //   position: position in plaintext in bytes.
+        //   length: length in bytes to read.
+        //   returns: length in bytes read. (shorter than length at the end)
+        // Throws std::runtime_error if a chunk is corrupted. (dst is zero-filled)
+        virtual size_t read(void* dst, size_t position, size_t length) = 0;
+
+        // Verifies all chunks in parallel.
+        //   returns: index of the first corrupted chunk, or chunk_count() if none.
+        virtual size_t verify() = 0;
+    };
+
+    // Opens a CTR-mode encrypted file for random-access reading.
+    //   The file is memory-mapped and decrypted on demand by extents, and least recently used plaintext extents are cached,
+    //   so a repeated read of a hot range costs a memcpy. An extent is cached on its second miss (the first miss decrypts
+    //   only the requested bytes), and reads larger than a quarter of the cache bypass it.
+    //   read() may be called from multiple threads at once if the context is stateless (e.g. created by create_ctr_context).
+    //   path: file to read.
+    //   context: ctr context of the file (stream position 0 at the file offset 0).
+    //   extent_size: decryption and caching unit in bytes (must be a non-zero multiple of 16). A miss costs decrypting a whole extent.
+    //   cache_capacity: maximum size in bytes of the cached plaintext. (0: no cache)
+    // Throws std::system_error if the file cannot be opened or mapped.
+    std::unique_ptr<ctr_file_reader_t> create_ctr_file_reader(const std::filesystem::path& path, std::unique_ptr<ctr_context_t> context, size_t extent_size = 512, size_t cache_capacity = 4u << 20);
+
+    // Creates a chunked encrypted container writer. (see container_writer_t for the layout)
+    //   stream: output stream. (must outlive the writer)
+    //   iv, nonce: RFC 5528 counter block of the container. (must be unique for the key)
+    //   tag: integrity tag of chunks.
+    //   chunk_size: chunk size in bytes (must be a non-zero multiple of 16, less than 4 GiB).
+    //   thread_count: number of threads including the calling thread. (0: hardware concurrency)
+    // The writer buffers min(2 * thread_count, 16) chunks of plaintext and as much ciphertext,
+    // i.e. at most 32 * chunk_size bytes (32 MiB with the default chunk size).
+    std::unique_ptr<container_writer_t> create_container_writer(std::ostream* stream, const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag = container_tag_t::crc32, size_t chunk_size = 1u << 20, size_t thread_count = 0);
+    std::unique_ptr<container_writer_t> create_container_writer(std::ostream* stream, const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag = container_tag_t::crc32, size_t chunk_size = 1u << 20, size_t thread_count = 0);
+    std::unique_ptr<container_writer_t> create_container_writer(std::ostream* stream, const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag = container_tag_t::crc32, size_t chunk_size = 1u << 20, size_t thread_count = 0);
+
+    // Opens a chunked encrypted container. The file is memory-mapped, and a chunk is located in O(1).
+    //   thread_count: number of threads including the calling thread. (0: hardware concurrency)
+    // Throws std::system_error if the file cannot be opened or mapped, std::runtime_error if the header or the footer is broken,
+    // and std::invalid_argument if the key (or its length) does not match the container.
+    std::unique_ptr<container_reader_t> create_container_reader(const std::filesystem::path& path, const key_128bit_t* key, size_t thread_count = 0);
+    std::unique_ptr<container_reader_t> create_container_reader(const std::filesystem::path& path, const key_192bit_t* key, size_t thread_count = 0);
+    std::unique_ptr<container_reader_t> create_container_reader(const std::filesystem::path& path, const key_256bit_t* key, size_t thread_count = 0);
+}
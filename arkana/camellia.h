@@ -15,6 +15,11 @@
 #include <climits>
 #include <array>
 #include <memory>
+#include <type_traits>
+
+#include "./ark/types.h"
+#include "./crc32.h"
+#include "./sha2.h"
 
 namespace arkana::camellia
 {
@@ -24,9 +29,16 @@ namespace arkana::camellia
     using key_192bit_t = std::array<std::byte, 192 / CHAR_BIT>;
     using key_256bit_t = std::array<std::byte, 256 / CHAR_BIT>;
 
+    using cbc_iv_t = std::array<std::byte, 16>;
+
     using ctr_iv_t = std::array<std::byte, 8>;
     using ctr_nonce_t = std::array<std::byte, 4>;
 
+    using gcm_iv_t = std::array<std::byte, 12>;
+    using gcm_tag_t = std::array<std::byte, 16>;
+
+    using cmac_tag_t = std::array<std::byte, 16>;
+
     /// RFC 3713 context
     class ecb_context_t
     {
@@ -46,6 +58,94 @@ namespace arkana::camellia
         virtual void process_blocks(void* dst, const void* src, size_t length) = 0;
     };
 
+    /// CBC mode decryption context
+    class cbc_decrypt_context_t
+    {
+    public:
+        cbc_decrypt_context_t() = default;
+        cbc_decrypt_context_t(const cbc_decrypt_context_t& other) = default;
+        cbc_decrypt_context_t(cbc_decrypt_context_t&& other) noexcept = default;
+        cbc_decrypt_context_t& operator=(const cbc_decrypt_context_t& other) = default;
+        cbc_decrypt_context_t& operator=(cbc_decrypt_context_t&& other) noexcept = default;
+        virtual ~cbc_decrypt_context_t() = default;
+
+    public:
+        // Process blocks.
+        //   dst: destination buffer (may be the same as src).
+        //   src: source buffer.
+        //   length: length in bytes to process (must be a multiple of 16).
+        // The chaining value is carried over to the next call.
+        virtual void process_blocks(void* dst, const void* src, size_t length) = 0;
+    };
+
+    /// Multi-stream CBC mode encryption job
+    template <class key_t>
+    struct cbc_encrypt_job_t
+    {
+        const key_t* key; // key.
+        cbc_iv_t* iv;     // initial vector. it is updated to the last cipher block (= CBC-MAC value) when the job is done.
+        void* dst;        // destination buffer. (nullptr: cipher blocks are not stored. computes CBC-MAC only.)
+        const void* src;  // source buffer.
+        size_t length;    // length in bytes to process (must be a multiple of 16).
+    };
+
+    /// Multi-key ECB mode job
+    template <class key_t>
+    struct ecb_job_t
+    {
+        const key_t* key; // key.
+        void* dst;        // destination buffer (may be the same as src).
+        const void* src;  // source buffer.
+        size_t length;    // length in bytes to process (must be a multiple of 16).
+    };
+
+    /// Multi-key CTR mode (RFC 5528) job
+    template <class key_t>
+    struct ctr_job_t
+    {
+        const key_t* key;         // key.
+        const ctr_iv_t* iv;       // initial vector.
+        const ctr_nonce_t* nonce; // nonce.
+        void* dst;                // destination buffer (may be the same as src).
+        const void* src;          // source buffer. (nullptr: stores keystream only)
+        size_t position;          // position in bytes from the beginning of the stream.
+        size_t length;            // length in bytes to process.
+    };
+
+    /// Multi-message CMAC job
+    template <class key_t>
+    struct cmac_job_t
+    {
+        const key_t* key; // key.
+        const void* src;  // message.
+        size_t length;    // length in bytes of message.
+        cmac_tag_t* tag;  // [out] message authentication code.
+    };
+
+    /// Built-in counter block layouts for CTR-mode (other than RFC 5528)
+    ///   The counter field is incremented per block (mod 2^bits), and the rest of the block is kept as a nonce.
+    enum class ctr_layout_t
+    {
+        be128, // 128-bit big-endian counter
+        be64,  // 64-bit nonce || 64-bit big-endian counter
+        be32,  // 96-bit nonce || 32-bit big-endian counter (GCM inc32)
+        le32,  // 96-bit nonce || 32-bit little-endian counter
+    };
+
+    /// Scatter/gather buffer segment (iovec)
+    struct buffer_segment_t
+    {
+        void* data;    // segment buffer.
+        size_t length; // segment length in bytes.
+    };
+
+    /// Scatter/gather source buffer segment (iovec)
+    struct const_buffer_segment_t
+    {
+        const void* data; // segment buffer.
+        size_t length;    // segment length in bytes.
+    };
+
     /// RFC 5528 context
     class ctr_context_t
     {
@@ -60,12 +160,270 @@ namespace arkana::camellia
     public:
         // Process bytes.
         //   dst: destination buffer.
-        //   src: source buffer.
+        //   src: source buffer. (nullptr: stores keystream only)
         //   position: current position in stream in bytes.
         //   length: length in bytes to process.
         virtual void process_bytes(void* dst, const void* src, size_t position, size_t length) = 0;
+
+        // Generates keystream bytes.
+        //   dst: destination buffer.
+        //   position: current position in stream in bytes.
+        //   length: length in bytes to generate.
+        void generate(void* dst, size_t position, size_t length) { return process_bytes(dst, nullptr, position, length); }
+
+        // Process bytes in scattered segments as one contiguous stream.
+        //   Keystream batches are kept full across segment boundaries.
+        //   dst_iov, dst_count: destination segments.
+        //   src_iov, src_count: source segments. (nullptr: stores keystream only) The total length must equal to that of dst.
+        //   position: current position in stream in bytes.
+        void process_segments(const buffer_segment_t* dst_iov, size_t dst_count, const const_buffer_segment_t* src_iov, size_t src_count, size_t position);
+    };
+
+    /// RFC 6367 GCM context (authenticated encryption)
+    class gcm_context_t
+    {
+    public:
+        gcm_context_t() = default;
+        gcm_context_t(const gcm_context_t& other) = default;
+        gcm_context_t(gcm_context_t&& other) noexcept = default;
+        gcm_context_t& operator=(const gcm_context_t& other) = default;
+        gcm_context_t& operator=(gcm_context_t&& other) noexcept = default;
+        virtual ~gcm_context_t() = default;
+
+    public:
+        // Encrypts bytes and generates the authentication tag.
+        //   dst: destination buffer (may be the same as src).
+        //   src: source buffer.
+        //   length: length in bytes to process.
+        //   iv: 96-bit initial vector (RFC 6367: salt || explicit IV). must not be reused with the same key.
+        //   aad: additional authenticated data.
+        //   aad_length: length in bytes of aad.
+        //   tag: [out] authentication tag.
+        virtual void encrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, gcm_tag_t* tag) = 0;
+
+        // Decrypts bytes and verifies the authentication tag.
+        //   dst: destination buffer (may be the same as src).
+        //   src: source buffer.
+        //   length: length in bytes to process.
+        //   iv: 96-bit initial vector.
+        //   aad: additional authenticated data.
+        //   aad_length: length in bytes of aad.
+        //   tag: authentication tag to verify.
+        // Returns false if the tag does not match. In that case, dst is filled with zero.
+        virtual bool decrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, const gcm_tag_t* tag) = 0;
+    };
+
+    /// NIST SP 800-38C CCM context (authenticated encryption, RFC 3610 formatting)
+    class ccm_context_t
+    {
+    public:
+        ccm_context_t() = default;
+        ccm_context_t(const ccm_context_t& other) = default;
+        ccm_context_t(ccm_context_t&& other) noexcept = default;
+        ccm_context_t& operator=(const ccm_context_t& other) = default;
+        ccm_context_t& operator=(ccm_context_t&& other) noexcept = default;
+        virtual ~ccm_context_t() = default;
+
+    public:
+        // Encrypts bytes and generates the authentication tag.
+        //   dst: destination buffer (may be the same as src).
+        //   src: source buffer.
+        //   length: length in bytes to process (must be less than 2^(8 * (15 - nonce_length))).
+        //   nonce: nonce. must not be reused with the same key.
+        //   nonce_length: length in bytes of nonce (7 to 13).
+        //   aad: additional authenticated data.
+        //   aad_length: length in bytes of aad.
+        //   tag: [out] authentication tag.
+        //   tag_length: length in bytes of tag (4, 6, 8, 10, 12, 14 or 16).
+        virtual void encrypt(void* dst, const void* src, size_t length, const void* nonce, size_t nonce_length, const void* aad, size_t aad_length, void* tag, size_t tag_length) = 0;
+
+        // Decrypts bytes and verifies the authentication tag.
+        //   dst: destination buffer (may be the same as src).
+        //   src: source buffer.
+        //   length: length in bytes to process.
+        //   nonce: nonce.
+        //   nonce_length: length in bytes of nonce (7 to 13).
+        //   aad: additional authenticated data.
+        //   aad_length: length in bytes of aad.
+        //   tag: authentication tag to verify.
+        //   tag_length: length in bytes of tag (4, 6, 8, 10, 12, 14 or 16).
+        // Returns false if the tag does not match. In that case, dst is filled with zero.
+        virtual bool decrypt(void* dst, const void* src, size_t length, const void* nonce, size_t nonce_length, const void* aad, size_t aad_length, const void* tag, size_t tag_length) = 0;
+    };
+
+    /// NIST SP 800-38B CMAC context (message authentication)
+    class cmac_context_t
+    {
+    public:
+        cmac_context_t() = default;
+        cmac_context_t(const cmac_context_t& other) = default;
+        cmac_context_t(cmac_context_t&& other) noexcept = default;
+        cmac_context_t& operator=(const cmac_context_t& other) = default;
+        cmac_context_t& operator=(cmac_context_t&& other) noexcept = default;
+        virtual ~cmac_context_t() = default;
+
+    public:
+        // Absorbs message bytes.
+        //   src: message.
+        //   length: length in bytes of message.
+        virtual void process_bytes(const void* src, size_t length) = 0;
+
+        // Finalizes the message and returns its authentication code.
+        // The context is reset for the next message.
+        virtual cmac_tag_t finalize() = 0;
+    };
+
+    /// IEEE 1619 XTS context (sector encryption)
+    class xts_context_t
+    {
+    public:
+        xts_context_t() = default;
+        xts_context_t(const xts_context_t& other) = default;
+        xts_context_t(xts_context_t&& other) noexcept = default;
+        xts_context_t& operator=(const xts_context_t& other) = default;
+        xts_context_t& operator=(xts_context_t&& other) noexcept = default;
+        virtual ~xts_context_t() = default;
+
+    public:
+        // Process sectors.
+        //   dst: destination buffer (may be the same as src).
+        //   src: source buffer.
+        //   sector_index: data unit sequence number of the first sector. following sectors are numbered consecutively.
+        //   sector_size: size in bytes of a sector (must be a multiple of 16).
+        //   length: length in bytes to process (must be a multiple of sector_size).
+        virtual void process_sectors(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length) = 0;
+    };
+
+    /// NIST SP 800-90A CTR_DRBG context (Camellia, no derivation function)
+    class ctr_drbg_context_t
+    {
+    public:
+        ctr_drbg_context_t() = default;
+        ctr_drbg_context_t(const ctr_drbg_context_t& other) = default;
+        ctr_drbg_context_t(ctr_drbg_context_t&& other) noexcept = default;
+        ctr_drbg_context_t& operator=(const ctr_drbg_context_t& other) = default;
+        ctr_drbg_context_t& operator=(ctr_drbg_context_t&& other) noexcept = default;
+        virtual ~ctr_drbg_context_t() = default;
+
+    public:
+        // Reseeds the generator.
+        //   entropy: entropy input.
+        //   entropy_length: length in bytes of entropy (must be the seed length: key length + 16).
+        //   additional: additional input. (nullptr: none)
+        //   additional_length: length in bytes of additional (up to the seed length).
+        virtual void reseed(const void* entropy, size_t entropy_length, const void* additional = nullptr, size_t additional_length = 0) = 0;
+
+        // Generates pseudo-random bytes.
+        //   dst: destination buffer.
+        //   length: length in bytes to generate. (split into requests of 64 KiB, the SP 800-90A maximum)
+        //   additional: additional input for the first request. (nullptr: none)
+        //   additional_length: length in bytes of additional (up to the seed length).
+        // Throws std::runtime_error if the generator must be reseeded (2^48 requests since the last seeding).
+        virtual void generate(void* dst, size_t length, const void* additional = nullptr, size_t additional_length = 0) = 0;
+    };
+
+    /// Crossover points of the dispatching contexts (ecb and ctr).
+    ///   Each call is routed by its length to the fastest available backend:
+    ///   avx2aesni from `avx2aesni` bytes, sseaesni from `sseaesni` bytes, avx2 from `avx2` bytes, ia32 otherwise.
+    ///   The defaults are measured on a few cpus: call set_backend_thresholds(measure_backend_thresholds()) to tune them for the running one.
+    ///   From `streaming` bytes, avx2aesni ecb/ctr contexts write output with non-temporal stores and prefetch input ahead,
+    ///   so that a huge buffer does not evict the whole cache. (0: always, SIZE_MAX: never, the default)
+    struct backend_thresholds_t
+    {
+        size_t avx2;        // minimum length in bytes to use avx2 backend.
+        size_t avx2aesni;   // minimum length in bytes to use avx2aesni backend.
+        size_t sseaesni;    // minimum length in bytes to use sseaesni backend.
+        size_t streaming;   // minimum length in bytes to use non-temporal stores.
+    };
+
+    // Sets crossover points. Applies to contexts created (and ctr_t values rekeyed) afterward.
+    void set_backend_thresholds(const backend_thresholds_t& thresholds);
+    backend_thresholds_t get_backend_thresholds();
+
+    // Measures crossover points on the running cpu (takes about 0.2s), e.g. set_backend_thresholds(measure_backend_thresholds()).
+    //   `streaming` is not measured: it is copied from get_backend_thresholds().
+    backend_thresholds_t measure_backend_thresholds();
+
+    /// Backend of value-type contexts
+    enum class backend_t
+    {
+        automatic, // routes each call by its length to the fastest one the cpu supports (see backend_thresholds_t)
+        ia32,
+        avx2,
+        sseaesni,
+        avx2aesni,
+    };
+
+    /// Scheduled keys (opaque: each backend reinterprets them as its own layout)
+    struct key_vector_small_tag;
+    struct key_vector_large_tag;
+    struct ctr_vector_tag;
+    using key_vector_small_t = tagged_memory_buffer<key_vector_small_tag, sizeof(uint64_t) * 26>;
+    using key_vector_large_t = tagged_memory_buffer<key_vector_large_tag, sizeof(uint64_t) * 34>;
+    using ctr_vector_t = tagged_memory_buffer<ctr_vector_tag, sizeof(uint32_t) * 4>;
+
+    /// RFC 5528 context (value type)
+    ///   Needs no heap allocation. An explicit backend is called through a function pointer resolved once,
+    ///   and backend_t::automatic routes each call by its length with the thresholds taken at (re)keying.
+    ///   It can be placed on the stack or in another object, and rekeyed in place.
+    template <size_t key_bits>
+    class ctr_t
+    {
+        static_assert(key_bits == 128 || key_bits == 192 || key_bits == 256);
+
+    public:
+        using key_t = std::array<std::byte, key_bits / CHAR_BIT>;
+
+        // Creates an unkeyed context. It must be rekeyed before processing (processing throws std::logic_error).
+        ctr_t() = default;
+
+        // Creates a keyed context.
+        //   backend: backend to use. throws std::invalid_argument if the cpu does not support it.
+        ctr_t(const key_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, backend_t backend = backend_t::automatic);
+
+        // Copying duplicates the key schedule: both contexts hold the key material until each is destroyed or moved from.
+        ctr_t(const ctr_t& other) = default;
+        ctr_t& operator=(const ctr_t& other) = default;
+
+        // A moved-from context is wiped and left unkeyed.
+        ctr_t(ctr_t&& other) noexcept;
+        ctr_t& operator=(ctr_t&& other) noexcept;
+
+        ~ctr_t();
+
+        // Replaces the key and the counter in place. The backend is kept, and the thresholds are taken again.
+        void rekey(const key_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+
+        // Rekeys `count` contexts at once: contexts[i] gets keys[i], ivs[i] and nonces[i].
+        //   The keys are scheduled in batches (32 keys at once on AVX2-AESNI), which is much cheaper than rekeying one by one.
+        static void rekey(ctr_t* contexts, const key_t* const* keys, const ctr_iv_t* const* ivs, const ctr_nonce_t* const* nonces, size_t count);
+
+        // Gets the backend. (automatic is kept: it is resolved on each call)
+        [[nodiscard]] backend_t backend() const noexcept { return backend_; }
+
+        // Process bytes. (see ctr_context_t::process_bytes)
+        void process_bytes(void* dst, const void* src, size_t position, size_t length) const { return function_(dst, src, position, length, key_vector_, ctr_vector_, thresholds_); }
+
+        // Generates keystream bytes. (see ctr_context_t::generate)
+        void generate(void* dst, size_t position, size_t length) const { return function_(dst, nullptr, position, length, key_vector_, ctr_vector_, thresholds_); }
+
+    private:
+        using key_vector_t = std::conditional_t<key_bits == 128, key_vector_small_t, key_vector_large_t>;
+        using function_t = void (*)(void* dst, const void* src, size_t position, size_t length, const key_vector_t& key_vector, const ctr_vector_t& ctr_vector, const backend_thresholds_t& thresholds);
+        static void process_bytes_unkeyed(void* dst, const void* src, size_t position, size_t length, const key_vector_t& key_vector, const ctr_vector_t& ctr_vector, const backend_thresholds_t& thresholds);
+        void wipe() noexcept;
+
+        function_t function_{&process_bytes_unkeyed};
+        backend_t backend_{};
+        backend_thresholds_t thresholds_{}; // used by backend_t::automatic
+        alignas(16) key_vector_t key_vector_{};
+        alignas(16) ctr_vector_t ctr_vector_{};
     };
 
+    using ctr128_t = ctr_t<128>;
+    using ctr192_t = ctr_t<192>;
+    using ctr256_t = ctr_t<256>;
+
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context(const key_192bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context(const key_256bit_t* key);
@@ -74,7 +432,128 @@ namespace arkana::camellia
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context(const key_192bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context(const key_256bit_t* key);
 
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context(const key_128bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context(const key_192bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context(const key_256bit_t* key, const cbc_iv_t* iv);
+
+    // Process independent CBC encryption (or CBC-MAC) jobs.
+    //   Serial CBC chains of jobs are interleaved across SIMD lanes (32 jobs at once on AVX2-AESNI).
+    //   jobs: jobs to process.
+    //   count: number of jobs.
+    void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count);
+
+    // Process independent ECB jobs, each under its own key.
+    //   Blocks of different jobs (keys) are processed in the SIMD lanes of a single batch (32 jobs at once on AVX2-AESNI).
+    //   jobs: jobs to process.
+    //   count: number of jobs.
+    void process_ecb_encrypt_jobs(const ecb_job_t<key_128bit_t>* jobs, size_t count);
+    void process_ecb_encrypt_jobs(const ecb_job_t<key_192bit_t>* jobs, size_t count);
+    void process_ecb_encrypt_jobs(const ecb_job_t<key_256bit_t>* jobs, size_t count);
+    void process_ecb_decrypt_jobs(const ecb_job_t<key_128bit_t>* jobs, size_t count);
+    void process_ecb_decrypt_jobs(const ecb_job_t<key_192bit_t>* jobs, size_t count);
+    void process_ecb_decrypt_jobs(const ecb_job_t<key_256bit_t>* jobs, size_t count);
+
+    // Process independent CTR (RFC 5528) jobs, each under its own key.
+    //   Blocks of different jobs (keys) are processed in the SIMD lanes of a single batch (32 jobs at once on AVX2-AESNI).
+    //   jobs: jobs to process.
+    //   count: number of jobs.
+    void process_ctr_jobs(const ctr_job_t<key_128bit_t>* jobs, size_t count);
+    void process_ctr_jobs(const ctr_job_t<key_192bit_t>* jobs, size_t count);
+    void process_ctr_jobs(const ctr_job_t<key_256bit_t>* jobs, size_t count);
+
     std::unique_ptr<ctr_context_t> create_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+
+    // Creates a CTR context with a built-in counter block layout.
+    //   initial_counter: counter block of stream position 0.
+    //   layout: counter block layout.
+    std::unique_ptr<ctr_context_t> create_ctr_context(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+
+    // Creates a CTR context which splits large process_bytes requests into slices and processes them on a worker pool.
+    //   The output is identical to the context created by create_ctr_context.
+    //   thread_count: number of threads including the calling thread. (0: hardware concurrency)
+    std::unique_ptr<ctr_context_t> create_parallel_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t thread_count = 0);
+    std::unique_ptr<ctr_context_t> create_parallel_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t thread_count = 0);
+    std::unique_ptr<ctr_context_t> create_parallel_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t thread_count = 0);
+
+    // Creates a CTR context which caches the last keystream batch (512 bytes).
+    //   Sequential small or unaligned writes reuse the cached keystream instead of regenerating a whole batch.
+    //   The context is stateful: a context must not be used from multiple threads at once.
+    std::unique_ptr<ctr_context_t> create_cached_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_cached_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_cached_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+
+    // Creates a CTR context which precomputes keystream ahead of the stream on a background thread.
+    //   The keystream following the last processed position is generated into a ring of 4 KiB slots,
+    //   so processing the next packet of a sequential stream costs only an XOR with precomputed bytes.
+    //   Other positions (or a stream outrunning the thread) are processed directly, and precomputation restarts after them.
+    //   The context is stateful: a context must not be used from multiple threads at once.
+    //   ahead: length in bytes of keystream to precompute. (rounded up to slots, at least 2 slots)
+    std::unique_ptr<ctr_context_t> create_precomputed_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t ahead = 64u << 10);
+    std::unique_ptr<ctr_context_t> create_precomputed_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t ahead = 64u << 10);
+    std::unique_ptr<ctr_context_t> create_precomputed_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t ahead = 64u << 10);
+
+    // Processes CTR-mode bytes and calculates crc32 of the ciphertext in a single pass.
+    //   The stream is processed in cache-sized chunks, each checksummed while still resident in L1,
+    //   so every byte goes through main memory once instead of twice.
+    //   encrypt: crc32 of dst (ciphertext output).
+    //   decrypt: crc32 of src (ciphertext input).
+    //   context: ctr context.
+    //   current: current crc32 value (for partial calculation)
+    //   returns: updated crc32 value.
+    crc32::crc32_value_t encrypt_bytes_ctr_crc32(ctr_context_t* context, void* dst, const void* src, size_t position, size_t length, crc32::crc32_value_t current = 0);
+    crc32::crc32_value_t decrypt_bytes_ctr_crc32(ctr_context_t* context, void* dst, const void* src, size_t position, size_t length, crc32::crc32_value_t current = 0);
+
+    // Processes CTR-mode bytes and feeds the ciphertext into a SHA-256 (or HMAC-SHA-256) context in a single pass (encrypt-then-MAC).
+    //   The stream is processed in 16 KiB chunks, each hashed while still resident in cache.
+    //   encrypt: hashes dst (ciphertext output).
+    //   decrypt: hashes src (ciphertext input).
+    //   digest: sha256 context (see sha2::create_sha256_context, sha2::create_hmac_sha256_context)
+    void encrypt_bytes_ctr_sha256(ctr_context_t* context, sha2::sha256_context_t* digest, void* dst, const void* src, size_t position, size_t length);
+    void decrypt_bytes_ctr_sha256(ctr_context_t* context, sha2::sha256_context_t* digest, void* dst, const void* src, size_t position, size_t length);
+
+    // Creates a CTR_DRBG context (NIST SP 800-90A, no derivation function).
+    //   The output blocks are generated by a be128-layout ctr context keystream.
+    //   key_bits: 128, 192 or 256.
+    //   entropy: entropy input (may include a nonce).
+    //   entropy_length: length in bytes of entropy (must be the seed length: key_bits / 8 + 16).
+    //   personalization: personalization string. (nullptr: none)
+    //   personalization_length: length in bytes of personalization (up to the seed length).
+    std::unique_ptr<ctr_drbg_context_t> create_ctr_drbg_context(size_t key_bits, const void* entropy, size_t entropy_length, const void* personalization = nullptr, size_t personalization_length = 0);
+
+    std::unique_ptr<gcm_context_t> create_gcm_context(const key_128bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context(const key_192bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context(const key_256bit_t* key);
+
+    // Creates a CCM context.
+    //   The CBC-MAC chain is serial, so the payload keystream is generated in batches on the fastest backend
+    //   while the chain runs on the backend with the shortest per-block latency.
+    std::unique_ptr<ccm_context_t> create_ccm_context(const key_128bit_t* key);
+    std::unique_ptr<ccm_context_t> create_ccm_context(const key_192bit_t* key);
+    std::unique_ptr<ccm_context_t> create_ccm_context(const key_256bit_t* key);
+
+    std::unique_ptr<cmac_context_t> create_cmac_context(const key_128bit_t* key);
+    std::unique_ptr<cmac_context_t> create_cmac_context(const key_192bit_t* key);
+    std::unique_ptr<cmac_context_t> create_cmac_context(const key_256bit_t* key);
+
+    // Calculates CMAC of independent messages, each under its own key.
+    //   Serial CBC-MAC chains of messages are interleaved across SIMD lanes (32 messages at once on AVX2-AESNI).
+    //   jobs: jobs to process.
+    //   count: number of jobs.
+    void process_cmac_jobs(const cmac_job_t<key_128bit_t>* jobs, size_t count);
+    void process_cmac_jobs(const cmac_job_t<key_192bit_t>* jobs, size_t count);
+    void process_cmac_jobs(const cmac_job_t<key_256bit_t>* jobs, size_t count);
+
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context(const key_256bit_t* key, const key_256bit_t* tweak_key);
+
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context(const key_256bit_t* key, const key_256bit_t* tweak_key);
 }
@@ -113,6 +113,65 @@ namespace arkana::camellia
                 xmm::store_u<v32>(&dst->r.l, reg.l.l);
                 xmm::store_u<v32>(&dst->r.r, reg.l.r);
             }
+
+            // xts-mode: multiplies the tweak of each lane (a 128-bit lane of YMM) by alpha^(8 * bytes).
+            template <int bytes, class YMM>
+            ARKXMM_API xts_multiply_alpha_bytes(YMM t) -> YMM
+            {
+                static_assert(bytes > 0 && bytes <= 4);
+                const vu64x4 v = reinterpret<vu64x4>(t);
+                const vu64x4 o = byte_shift_r_128<16 - bytes>(v); // overflowed bits (< 2^32)
+                return reinterpret<YMM>(byte_shift_l_128<bytes>(v) ^ o ^ o << 1 ^ o << 2 ^ o << 7); // x^128 = x^7 + x^2 + x + 1
+            }
+
+            // xts-mode: advances the tweaks of 8 lanes by 8 blocks (t *= alpha^8).
+            ARKXMM_API xts_next_tweak(v128& t) -> v128&
+            {
+                t.l.l = xts_multiply_alpha_bytes<1>(t.l.l);
+                t.l.r = xts_multiply_alpha_bytes<1>(t.l.r);
+                t.r.l = xts_multiply_alpha_bytes<1>(t.r.l);
+                t.r.r = xts_multiply_alpha_bytes<1>(t.r.r);
+                return t;
+            }
+
+            // per-lane keys
+            //   Each subkey is held as a transposed v64, so that every lane (block) of a batch has its own key.
+
+            ARKXMM_API camellia_prewhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                transpose_32x4x4(block.l.l, block.l.r, block.r.l, block.r.r);
+                block.l ^= kl;
+                block.r ^= kr;
+                return block;
+            }
+
+            ARKXMM_API camellia_postwhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                block.r ^= kl;
+                block.l ^= kr;
+                transpose_32x4x4(block.r.l, block.r.r, block.l.l, block.l.r);
+                return block;
+            }
+
+            // Transposes 8 key vectors into a per-lane key vector. lane[i] is the key vector of i-th block of a batch.
+            template <class lane_key_vector_t, class key_vector_t>
+            static inline void transpose_key_vectors(lane_key_vector_t& dst, const key_vector_t* const (&lane)[8]) noexcept
+            {
+                // a key vector is a sequence of 128-bit subkey pairs {kw_1, kw_2}, {k_1, k_2}, ..., which are transposed as blocks are.
+                constexpr size_t pair_count = sizeof(key_vector_t) / sizeof(key64[2]);
+                static_assert(sizeof(lane_key_vector_t) == sizeof(v128) * pair_count);
+
+                for (size_t p = 0; p < pair_count; p++)
+                {
+                    std::array<byte_array<16>, 8> buf;
+                    for (size_t i = 0; i < 8; i++)
+                        memcpy(&buf[i], reinterpret_cast<const byte_t*>(lane[i]) + p * 16, 16);
+
+                    v128 v = load_v128(reinterpret_cast<const v128*>(buf.data()));
+                    transpose_32x4x4(v.l.l, v.l.r, v.r.l, v.r.r);
+                    reinterpret_cast<v128*>(&dst)[p] = v;
+                }
+            }
         }
 
         namespace impl
@@ -140,6 +199,53 @@ namespace arkana::camellia
                     swap_store_v128>(dst, src, length, kv);
             }
 
+            using ref::impl::cbc_iv_t;
+
+            // cbc-mode decryption
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& kv, cbc_iv_t& iv)
+            {
+                using namespace functions;
+                cbc_mode::process_blocks_cbc_decrypt<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f_table_lookup_32<v64&, lookup_sbox32>,
+                    camellia_fl<v64&, rotl_be1>,
+                    camellia_fl_inv<v64&, rotl_be1>,
+                    camellia_postwhite,
+                    swap_xor128,
+                    store_v128>(dst, src, length, kv, iv);
+            }
+
+            using ref::impl::cbc_encrypt_job_t;
+
+            // multi-stream cbc-mode encryption: 8 jobs (lanes) at once
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using lane_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+                using namespace functions;
+                cbc_mode::process_cbc_encrypt_jobs<
+                    v128,
+                    lane_key_vector_t,
+                    transpose_key_vectors<lane_key_vector_t, key_vector_t>,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_table_lookup_32<v64&, lookup_sbox32, v64>,
+                    camellia_fl<v64&, rotl_be1, v64>,
+                    camellia_fl_inv<v64&, rotl_be1, v64>,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128,
+                    4, // an 8-block batch costs about 4 serial blocks.
+                    ref::impl::process_cbc_encrypt_jobs<key_vector_t>>(jobs, count);
+            }
+
             using ref::impl::ctr_iv_t;
             using ref::impl::ctr_nonce_t;
             using ref::impl::ctr_vector_t;
@@ -219,6 +325,28 @@ namespace arkana::camellia
                     return load_v128(reinterpret_cast<v128*>(v.data()));
                 });
             }
+
+            // ieee 1619 xts-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& kv, const key_vector_t& tweak_kv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f_table_lookup_32<v64&, lookup_sbox32>,
+                    camellia_fl<v64&, rotl_be1>,
+                    camellia_fl_inv<v64&, rotl_be1>,
+                    camellia_postwhite,
+                    xor_block<v128>,
+                    swap_xor128,
+                    store_v128,
+                    xts_next_tweak,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+            }
         }
 
         using impl::key_vector_small_t;
@@ -233,6 +361,16 @@ namespace arkana::camellia
         static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_small_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
         static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_large_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
 
+        using impl::cbc_iv_t;
+
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+
+        using impl::cbc_encrypt_job_t;
+
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+
         using impl::ctr_iv_t;
         using impl::ctr_nonce_t;
         using impl::ctr_vector_t;
@@ -242,5 +380,8 @@ namespace arkana::camellia
         static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
         template <class custom_ctr_generator_t, std::enable_if_t<impl::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
         template <class custom_ctr_generator_t, std::enable_if_t<impl::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
     }
 }
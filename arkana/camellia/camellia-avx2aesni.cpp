@@ -15,8 +15,11 @@
 
 #include "./camellia.h"
 #include "./camellia-avx2aesni.h"
+#include "./ghash-clmul.h"
 #include "../ark/cpuid.h"
 
+#include <stdexcept>
+
 namespace arkana::camellia
 {
     bool cpu_supports_avx2aesni() noexcept
@@ -24,6 +27,41 @@ namespace arkana::camellia
         return cpuid::cpu_supports::AVX2 && cpuid::cpu_supports::AESNI;
     }
 
+    bool cpu_supports_avx2aesniclmul() noexcept
+    {
+        return cpuid::cpu_supports::AVX2 && cpuid::cpu_supports::AESNI && cpuid::cpu_supports::PCLMULQDQ;
+    }
+
+    void generate_key_vectors_encrypt_avx2aesni(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count)
+    {
+        return avx2aesni::generate_key_vectors_encrypt(reinterpret_cast<avx2aesni::key_vector_small_t*>(dst), keys, count);
+    }
+
+    void generate_key_vectors_encrypt_avx2aesni(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count)
+    {
+        return avx2aesni::generate_key_vectors_encrypt(reinterpret_cast<avx2aesni::key_vector_large_t*>(dst), keys, count);
+    }
+
+    void generate_key_vectors_encrypt_avx2aesni(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count)
+    {
+        return avx2aesni::generate_key_vectors_encrypt(reinterpret_cast<avx2aesni::key_vector_large_t*>(dst), keys, count);
+    }
+
+    void generate_key_vectors_decrypt_avx2aesni(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count)
+    {
+        return avx2aesni::generate_key_vectors_decrypt(reinterpret_cast<avx2aesni::key_vector_small_t*>(dst), keys, count);
+    }
+
+    void generate_key_vectors_decrypt_avx2aesni(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count)
+    {
+        return avx2aesni::generate_key_vectors_decrypt(reinterpret_cast<avx2aesni::key_vector_large_t*>(dst), keys, count);
+    }
+
+    void generate_key_vectors_decrypt_avx2aesni(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count)
+    {
+        return avx2aesni::generate_key_vectors_decrypt(reinterpret_cast<avx2aesni::key_vector_large_t*>(dst), keys, count);
+    }
+
     void process_blocks_ecb_avx2aesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv)
     {
         return avx2aesni::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(kv));
@@ -34,6 +72,46 @@ namespace arkana::camellia
         return avx2aesni::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const avx2aesni::key_vector_large_t&>(kv));
     }
 
+    void process_blocks_cbc_decrypt_avx2aesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv)
+    {
+        return avx2aesni::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(kv), iv);
+    }
+
+    void process_blocks_cbc_decrypt_avx2aesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv)
+    {
+        return avx2aesni::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const avx2aesni::key_vector_large_t&>(kv), iv);
+    }
+
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count)
+    {
+        return avx2aesni::process_cbc_encrypt_jobs(reinterpret_cast<const avx2aesni::cbc_encrypt_job_t<avx2aesni::key_vector_small_t>*>(jobs), count);
+    }
+
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count)
+    {
+        return avx2aesni::process_cbc_encrypt_jobs(reinterpret_cast<const avx2aesni::cbc_encrypt_job_t<avx2aesni::key_vector_large_t>*>(jobs), count);
+    }
+
+    void process_ecb_jobs_avx2aesni(const ecb_job_t<key_vector_small_t>* jobs, size_t count)
+    {
+        return avx2aesni::process_ecb_jobs(reinterpret_cast<const avx2aesni::ecb_job_t<avx2aesni::key_vector_small_t>*>(jobs), count);
+    }
+
+    void process_ecb_jobs_avx2aesni(const ecb_job_t<key_vector_large_t>* jobs, size_t count)
+    {
+        return avx2aesni::process_ecb_jobs(reinterpret_cast<const avx2aesni::ecb_job_t<avx2aesni::key_vector_large_t>*>(jobs), count);
+    }
+
+    void process_ctr_jobs_avx2aesni(const ctr_job_t<key_vector_small_t>* jobs, size_t count)
+    {
+        return avx2aesni::process_ctr_jobs(reinterpret_cast<const avx2aesni::ctr_job_t<avx2aesni::key_vector_small_t>*>(jobs), count);
+    }
+
+    void process_ctr_jobs_avx2aesni(const ctr_job_t<key_vector_large_t>* jobs, size_t count)
+    {
+        return avx2aesni::process_ctr_jobs(reinterpret_cast<const avx2aesni::ctr_job_t<avx2aesni::key_vector_large_t>*>(jobs), count);
+    }
+
     void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv)
     {
         return avx2aesni::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(kv), bit::type_punning_cast<const avx2aesni::ctr_vector_t&>(cv));
@@ -45,41 +123,219 @@ namespace arkana::camellia
     }
 
     template <class key_vector_t>
-    static std::unique_ptr<ecb_context_t> make_avx2aesni_ecb_context(key_vector_t kv)
+    static void process_bytes_ctr_layout_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        switch (layout)
+        {
+        case ctr_layout_t::be128: return avx2aesni::process_bytes_ctr_layout<functions::ctr_layout_be128>(dst, src, position, length, kv, initial);
+        case ctr_layout_t::be64: return avx2aesni::process_bytes_ctr_layout<functions::ctr_layout_be64>(dst, src, position, length, kv, initial);
+        case ctr_layout_t::be32: return avx2aesni::process_bytes_ctr_layout<functions::ctr_layout_be32>(dst, src, position, length, kv, initial);
+        case ctr_layout_t::le32: return avx2aesni::process_bytes_ctr_layout<functions::ctr_layout_le32>(dst, src, position, length, kv, initial);
+        }
+        throw std::invalid_argument("invalid layout.");
+    }
+
+    void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout)
     {
+        return process_bytes_ctr_layout_avx2aesni(dst, src, position, length, bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(kv), initial, layout);
+    }
+
+    void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        return process_bytes_ctr_layout_avx2aesni(dst, src, position, length, bit::type_punning_cast<const avx2aesni::key_vector_large_t&>(kv), initial, layout);
+    }
+
+    void process_sectors_xts_avx2aesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv)
+    {
+        return avx2aesni::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(kv), bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(tweak_kv));
+    }
+
+    void process_sectors_xts_avx2aesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv)
+    {
+        return avx2aesni::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const avx2aesni::key_vector_large_t&>(kv), bit::type_punning_cast<const avx2aesni::key_vector_large_t&>(tweak_kv));
+    }
+
+    // expands a key vector into pre-broadcast layout
+    static avx2aesni::expanded_key_vector_small_t expand_key_vector_avx2aesni(const key_vector_small_t& kv) { return avx2aesni::expand_key_vector(bit::type_punning_cast<const avx2aesni::key_vector_small_t&>(kv)); }
+    static avx2aesni::expanded_key_vector_large_t expand_key_vector_avx2aesni(const key_vector_large_t& kv) { return avx2aesni::expand_key_vector(bit::type_punning_cast<const avx2aesni::key_vector_large_t&>(kv)); }
+
+    // streaming mode needs 32-byte aligned output batches:
+    //   ecb: dst itself (after skipping a 16-byte head), ctr: dst at every 512-byte keystream boundary.
+    static size_t streaming_head_ecb(const void* dst) { return reinterpret_cast<uintptr_t>(dst) % 32; }
+    static bool streaming_aligned_ctr(const void* dst, size_t position) { return (reinterpret_cast<uintptr_t>(dst) - position) % 32 == 0; }
+
+    template <class key_vector_t>
+    static std::unique_ptr<ecb_context_t> make_avx2aesni_ecb_context(key_vector_t kv, size_t streaming_threshold)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_avx2aesni(kv));
         struct ecb_context_impl_t final : public virtual ecb_context_t
         {
-            const key_vector_t key_vector_;
-            explicit ecb_context_impl_t(key_vector_t kv) : key_vector_(kv) { }
-            ~ecb_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)); }
-            void process_blocks(void* dst, const void* src, size_t length) override { return process_blocks_ecb_avx2aesni(dst, src, length, key_vector_); }
+            const expanded_key_vector_t key_vector_;
+            const size_t streaming_threshold_;
+            explicit ecb_context_impl_t(const key_vector_t& kv, size_t streaming_threshold) : key_vector_(expand_key_vector_avx2aesni(kv)), streaming_threshold_(streaming_threshold) { }
+            ~ecb_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)); }
+
+            void process_blocks(void* dst, const void* src, size_t length) override
+            {
+                if (length < streaming_threshold_ || length % 16 != 0)
+                    return avx2aesni::process_blocks_ecb(dst, src, length, key_vector_);
+
+                if (size_t head = streaming_head_ecb(dst))
+                {
+                    if (head != 16 || length <= head) return avx2aesni::process_blocks_ecb(dst, src, length, key_vector_);
+                    avx2aesni::process_blocks_ecb(dst, src, head, key_vector_);
+                    dst = static_cast<std::byte*>(dst) + head, src = static_cast<const std::byte*>(src) + head, length -= head;
+                }
+                return avx2aesni::process_blocks_ecb(dst, src, length, key_vector_, avx2aesni::non_temporal_t{});
+            }
+        };
+
+        return std::make_unique<ecb_context_impl_t>(kv, streaming_threshold);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<cbc_decrypt_context_t> make_avx2aesni_cbc_decrypt_context(key_vector_t kv, const cbc_iv_t* iv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_avx2aesni(kv));
+        struct cbc_decrypt_context_impl_t final : public virtual cbc_decrypt_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            cbc_iv_t iv_;
+            explicit cbc_decrypt_context_impl_t(const key_vector_t& kv, const cbc_iv_t& iv) : key_vector_(expand_key_vector_avx2aesni(kv)), iv_(iv) { }
+            ~cbc_decrypt_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(iv_); }
+            void process_blocks(void* dst, const void* src, size_t length) override { return avx2aesni::process_blocks_cbc_decrypt(dst, src, length, key_vector_, iv_); }
         };
 
-        return std::make_unique<ecb_context_impl_t>(kv);
+        return std::make_unique<cbc_decrypt_context_impl_t>(kv, *iv);
     }
 
     template <class key_vector_t, class ctr_vector_t>
-    static std::unique_ptr<ctr_context_t> make_avx2aesni_ctr_context(key_vector_t kv, ctr_vector_t cv)
+    static std::unique_ptr<ctr_context_t> make_avx2aesni_ctr_context(key_vector_t kv, ctr_vector_t cv, size_t streaming_threshold)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_avx2aesni(kv));
+        struct ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            const avx2aesni::ctr_vector_t ctr_vector_;
+            const size_t streaming_threshold_;
+            explicit ctr_context_impl_t(const key_vector_t& kv, const ctr_vector_t& cv, size_t streaming_threshold) : key_vector_(expand_key_vector_avx2aesni(kv)), ctr_vector_(bit::bit_cast<avx2aesni::ctr_vector_t>(cv)), streaming_threshold_(streaming_threshold) { }
+            ~ctr_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<avx2aesni::ctr_vector_t&>(ctr_vector_)); }
+
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+            {
+                if (length < streaming_threshold_ || !streaming_aligned_ctr(dst, position))
+                    return avx2aesni::process_bytes_ctr(dst, src, position, length, key_vector_, ctr_vector_);
+                return avx2aesni::process_bytes_ctr(dst, src, position, length, key_vector_, ctr_vector_, avx2aesni::non_temporal_t{});
+            }
+        };
+
+        return std::make_unique<ctr_context_impl_t>(kv, cv, streaming_threshold);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<ctr_context_t> make_avx2aesni_ctr_context(key_vector_t kv, const block_t& initial, ctr_layout_t layout)
     {
+        using expanded_key_vector_t = decltype(expand_key_vector_avx2aesni(kv));
         struct ctr_context_impl_t final : public virtual ctr_context_t
         {
-            const key_vector_t key_vector_;
-            const ctr_vector_t ctr_vector_;
-            explicit ctr_context_impl_t(key_vector_t kv, ctr_vector_t cv) : key_vector_(kv), ctr_vector_(cv) { }
-            ~ctr_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<ctr_vector_t&>(ctr_vector_)); }
-            void process_bytes(void* dst, const void* src, size_t position, size_t length) override { return process_bytes_ctr_avx2aesni(dst, src, position, length, key_vector_, ctr_vector_); }
+            const expanded_key_vector_t key_vector_;
+            const block_t initial_;
+            const ctr_layout_t layout_;
+            explicit ctr_context_impl_t(const key_vector_t& kv, const block_t& initial, ctr_layout_t layout) : key_vector_(expand_key_vector_avx2aesni(kv)), initial_(initial), layout_(layout) { }
+            ~ctr_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<block_t&>(initial_)); }
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override { return process_bytes_ctr_layout_avx2aesni(dst, src, position, length, key_vector_, initial_, layout_); }
+        };
+
+        return std::make_unique<ctr_context_impl_t>(kv, initial, layout);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<gcm_context_t> make_avx2aesni_gcm_context(key_vector_t kv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_avx2aesni(kv));
+        struct gcm_context_impl_t final : public virtual gcm_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            ghash::clmul::ghash_key_t hash_key_;
+
+            explicit gcm_context_impl_t(const key_vector_t& kv) : key_vector_(expand_key_vector_avx2aesni(kv)), hash_key_()
+            {
+                ghash::ghash_block_t h{};
+                avx2aesni::process_blocks_ecb(h.data(), h.data(), h.size(), key_vector_); // H = E(0^128)
+                hash_key_ = ghash::clmul::generate_ghash_key(h);
+                bit::secure_be_zero(h);
+            }
+
+            ~gcm_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(hash_key_); }
+
+            void encrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, gcm_tag_t* tag) override
+            {
+                const ctr_vector_t gcm_cv = generate_gcm_ctr_vector(iv);
+                const avx2aesni::ctr_vector_t cv = bit::type_punning_cast<const avx2aesni::ctr_vector_t&>(gcm_cv);
+                return functions::process_bytes_gcm_encrypt(
+                    dst, src, length, aad, aad_length, *tag,
+                    [&](void* d, const void* s, size_t position, size_t len) { return avx2aesni::process_bytes_ctr(d, s, position, len, key_vector_, cv); },
+                    [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::clmul::ghash_update(y, hash_key_, data, len); });
+            }
+
+            bool decrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, const gcm_tag_t* tag) override
+            {
+                const ctr_vector_t gcm_cv = generate_gcm_ctr_vector(iv);
+                const avx2aesni::ctr_vector_t cv = bit::type_punning_cast<const avx2aesni::ctr_vector_t&>(gcm_cv);
+                return functions::process_bytes_gcm_decrypt(
+                    dst, src, length, aad, aad_length, *tag,
+                    [&](void* d, const void* s, size_t position, size_t len) { return avx2aesni::process_bytes_ctr(d, s, position, len, key_vector_, cv); },
+                    [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::clmul::ghash_update(y, hash_key_, data, len); });
+            }
+        };
+
+        return std::make_unique<gcm_context_impl_t>(kv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<xts_context_t> make_avx2aesni_xts_context(key_vector_t kv, key_vector_t tweak_kv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_avx2aesni(kv));
+        struct xts_context_impl_t final : public virtual xts_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            const expanded_key_vector_t tweak_key_vector_;
+            explicit xts_context_impl_t(const key_vector_t& kv, const key_vector_t& tweak_kv) : key_vector_(expand_key_vector_avx2aesni(kv)), tweak_key_vector_(expand_key_vector_avx2aesni(tweak_kv)) { }
+            ~xts_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<expanded_key_vector_t&>(tweak_key_vector_)); }
+            void process_sectors(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length) override { return avx2aesni::process_sectors_xts(dst, src, sector_index, sector_size, length, key_vector_, tweak_key_vector_); }
         };
 
-        return std::make_unique<ctr_context_impl_t>(kv, cv);
+        return std::make_unique<xts_context_impl_t>(kv, tweak_kv);
     }
 
-    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_128bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_encrypt(key)); }
-    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_192bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_encrypt(key)); }
-    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_256bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_encrypt(key)); }
-    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_128bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_decrypt(key)); }
-    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_192bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_decrypt(key)); }
-    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_256bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_decrypt(key)); }
-    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
-    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
-    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_128bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_encrypt(key), get_backend_thresholds().streaming); }
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_192bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_encrypt(key), get_backend_thresholds().streaming); }
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_256bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_encrypt(key), get_backend_thresholds().streaming); }
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_128bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_decrypt(key), get_backend_thresholds().streaming); }
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_192bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_decrypt(key), get_backend_thresholds().streaming); }
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_256bit_t* key) { return make_avx2aesni_ecb_context(generate_key_vector_decrypt(key), get_backend_thresholds().streaming); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2aesni(const key_128bit_t* key, const cbc_iv_t* iv) { return make_avx2aesni_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2aesni(const key_192bit_t* key, const cbc_iv_t* iv) { return make_avx2aesni_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2aesni(const key_256bit_t* key, const cbc_iv_t* iv) { return make_avx2aesni_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce), get_backend_thresholds().streaming); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce), get_backend_thresholds().streaming); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce), get_backend_thresholds().streaming); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_avx2aesni_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2aesni(const key_128bit_t* key) { return make_avx2aesni_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2aesni(const key_192bit_t* key) { return make_avx2aesni_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2aesni(const key_256bit_t* key) { return make_avx2aesni_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2aesni(const key_128bit_t* key, const key_128bit_t* tweak_key) { return make_avx2aesni_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2aesni(const key_192bit_t* key, const key_192bit_t* tweak_key) { return make_avx2aesni_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2aesni(const key_256bit_t* key, const key_256bit_t* tweak_key) { return make_avx2aesni_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2aesni(const key_128bit_t* key, const key_128bit_t* tweak_key) { return make_avx2aesni_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2aesni(const key_192bit_t* key, const key_192bit_t* tweak_key) { return make_avx2aesni_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2aesni(const key_256bit_t* key, const key_256bit_t* tweak_key) { return make_avx2aesni_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_context_avx2aesni(const key_vector_small_t& kv, size_t streaming_threshold) { return make_avx2aesni_ecb_context(kv, streaming_threshold); }
+    std::unique_ptr<ecb_context_t> create_ecb_context_avx2aesni(const key_vector_large_t& kv, size_t streaming_threshold) { return make_avx2aesni_ecb_context(kv, streaming_threshold); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_small_t& kv, const ctr_vector_t& cv, size_t streaming_threshold) { return make_avx2aesni_ctr_context(kv, cv, streaming_threshold); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_large_t& kv, const ctr_vector_t& cv, size_t streaming_threshold) { return make_avx2aesni_ctr_context(kv, cv, streaming_threshold); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_small_t& kv, const block_t* initial_counter, ctr_layout_t layout) { return make_avx2aesni_ctr_context(kv, *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_large_t& kv, const block_t* initial_counter, ctr_layout_t layout) { return make_avx2aesni_ctr_context(kv, *initial_counter, layout); }
 }
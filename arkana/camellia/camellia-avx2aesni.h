@@ -225,22 +225,8 @@ namespace arkana::camellia
             }
 
 
-            ARKXMM_API camellia_f(v64& l, const v64& r, const key64& k) -> v64&
+            ARKXMM_API camellia_sp(v64& v) -> v64&
             {
-                auto v = r;
-
-                // k
-                const vi8x32 ze = zero<vi8x32>();
-                const vu64x4 kx = u64x4(k);
-                v.l.x0 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 0 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 0 * 8));
-                v.l.x1 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 1 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 1 * 8));
-                v.l.x2 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 2 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 2 * 8));
-                v.l.x3 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 3 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 3 * 8));
-                v.r.x0 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 4 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 4 * 8));
-                v.r.x1 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 5 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 5 * 8));
-                v.r.x2 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 6 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 6 * 8));
-                v.r.x3 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 7 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 7 * 8));
-
                 // s
                 const vu8x32 tf0l = u8x32(0x45, 0xe8, 0x40, 0xed, 0x2e, 0x83, 0x2b, 0x86, 0x4b, 0xe6, 0x4e, 0xe3, 0x20, 0x8d, 0x25, 0x88);
                 const vu8x32 tf0h = u8x32(0x00, 0x51, 0xf1, 0xa0, 0x8a, 0xdb, 0x7b, 0x2a, 0x09, 0x58, 0xf8, 0xa9, 0x83, 0xd2, 0x72, 0x23);
@@ -279,6 +265,28 @@ namespace arkana::camellia
                 v.r.x2 ^= v.l.x1;
                 v.r.x3 ^= v.l.x2;
 
+                return v;
+            }
+
+            ARKXMM_API camellia_f(v64& l, const v64& r, const key64& k) -> v64&
+            {
+                auto v = r;
+
+                // k
+                const vi8x32 ze = zero<vi8x32>();
+                const vu64x4 kx = u64x4(k);
+                v.l.x0 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 0 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 0 * 8));
+                v.l.x1 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 1 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 1 * 8));
+                v.l.x2 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 2 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 2 * 8));
+                v.l.x3 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 3 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 3 * 8));
+                v.r.x0 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 4 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 4 * 8));
+                v.r.x1 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 5 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 5 * 8));
+                v.r.x2 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 6 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 6 * 8));
+                v.r.x3 ^= reinterpret<vu8x32>(byte_shuffle_128(kx >> 7 * 8, ze)); // u8x32(static_cast<uint8_t>(k >> 7 * 8));
+
+                // s, p
+                v = camellia_sp(v);
+
                 // store
                 l.l ^= v.r;
                 l.r ^= v.l;
@@ -426,6 +434,42 @@ namespace arkana::camellia
                 xmm::store_u<vu8x32>(&dst->r.r.x3, reg.r.r.x3);
             }
 
+            // non-temporal store: dst must be 32-byte aligned.
+            ARKXMM_API stream_store_v128(v128* dst, const v128& reg)
+            {
+                xmm::store_s<vu8x32>(&dst->l.l.x0, reg.l.l.x0);
+                xmm::store_s<vu8x32>(&dst->l.l.x1, reg.l.l.x1);
+                xmm::store_s<vu8x32>(&dst->l.l.x2, reg.l.l.x2);
+                xmm::store_s<vu8x32>(&dst->l.l.x3, reg.l.l.x3);
+                xmm::store_s<vu8x32>(&dst->l.r.x0, reg.l.r.x0);
+                xmm::store_s<vu8x32>(&dst->l.r.x1, reg.l.r.x1);
+                xmm::store_s<vu8x32>(&dst->l.r.x2, reg.l.r.x2);
+                xmm::store_s<vu8x32>(&dst->l.r.x3, reg.l.r.x3);
+                xmm::store_s<vu8x32>(&dst->r.l.x0, reg.r.l.x0);
+                xmm::store_s<vu8x32>(&dst->r.l.x1, reg.r.l.x1);
+                xmm::store_s<vu8x32>(&dst->r.l.x2, reg.r.l.x2);
+                xmm::store_s<vu8x32>(&dst->r.l.x3, reg.r.l.x3);
+                xmm::store_s<vu8x32>(&dst->r.r.x0, reg.r.r.x0);
+                xmm::store_s<vu8x32>(&dst->r.r.x1, reg.r.r.x1);
+                xmm::store_s<vu8x32>(&dst->r.r.x2, reg.r.r.x2);
+                xmm::store_s<vu8x32>(&dst->r.r.x3, reg.r.r.x3);
+            }
+
+            // non-temporal store with the l/r swap of swap_store_v128: dst must be 32-byte aligned.
+            ARKXMM_API swap_stream_store_v128(v128* dst, const v128& reg)
+            {
+                stream_store_v128(dst, v128{reg.r, reg.l});
+            }
+
+            // loads a batch, prefetching the batch after next (streaming input).
+            ARKXMM_API prefetch_load_v128(const v128* src) -> v128
+            {
+                const auto* p = reinterpret_cast<const byte_t*>(src + 2);
+                for (size_t i = 0; i < sizeof(v128); i += 64)
+                    xmm::prefetch_nta(p + i);
+                return load_v128(src);
+            }
+
             ARKXMM_API swap_xor128(v128& v, const v128& k) -> v128&
             {
                 v.r.l ^= k.l.l;
@@ -454,6 +498,178 @@ namespace arkana::camellia
                 xmm::store_u<vu8x32>(&dst->r.r.x2, reg.l.r.x2);
                 xmm::store_u<vu8x32>(&dst->r.r.x3, reg.l.r.x3);
             }
+
+            // xts-mode: multiplies the tweak of each lane (a 128-bit lane of YMM) by alpha^(8 * bytes).
+            template <int bytes, class YMM>
+            ARKXMM_API xts_multiply_alpha_bytes(YMM t) -> YMM
+            {
+                static_assert(bytes > 0 && bytes <= 4);
+                const vu64x4 v = reinterpret<vu64x4>(t);
+                const vu64x4 o = byte_shift_r_128<16 - bytes>(v); // overflowed bits (< 2^32)
+                return reinterpret<YMM>(byte_shift_l_128<bytes>(v) ^ o ^ o << 1 ^ o << 2 ^ o << 7); // x^128 = x^7 + x^2 + x + 1
+            }
+
+            // xts-mode: advances the tweaks of 32 lanes by 32 blocks (t *= alpha^32).
+            ARKXMM_API xts_next_tweak(v128& t) -> v128&
+            {
+                t.l.l.x0 = xts_multiply_alpha_bytes<4>(t.l.l.x0);
+                t.l.l.x1 = xts_multiply_alpha_bytes<4>(t.l.l.x1);
+                t.l.l.x2 = xts_multiply_alpha_bytes<4>(t.l.l.x2);
+                t.l.l.x3 = xts_multiply_alpha_bytes<4>(t.l.l.x3);
+                t.l.r.x0 = xts_multiply_alpha_bytes<4>(t.l.r.x0);
+                t.l.r.x1 = xts_multiply_alpha_bytes<4>(t.l.r.x1);
+                t.l.r.x2 = xts_multiply_alpha_bytes<4>(t.l.r.x2);
+                t.l.r.x3 = xts_multiply_alpha_bytes<4>(t.l.r.x3);
+                t.r.l.x0 = xts_multiply_alpha_bytes<4>(t.r.l.x0);
+                t.r.l.x1 = xts_multiply_alpha_bytes<4>(t.r.l.x1);
+                t.r.l.x2 = xts_multiply_alpha_bytes<4>(t.r.l.x2);
+                t.r.l.x3 = xts_multiply_alpha_bytes<4>(t.r.l.x3);
+                t.r.r.x0 = xts_multiply_alpha_bytes<4>(t.r.r.x0);
+                t.r.r.x1 = xts_multiply_alpha_bytes<4>(t.r.r.x1);
+                t.r.r.x2 = xts_multiply_alpha_bytes<4>(t.r.r.x2);
+                t.r.r.x3 = xts_multiply_alpha_bytes<4>(t.r.r.x3);
+                return t;
+            }
+
+            // per-lane keys
+            //   Each subkey is held as a byte-sliced v64, so that every lane (block) of a batch has its own key.
+
+            ARKXMM_API operator ^=(v64& lhs, const v64& rhs) noexcept -> v64&
+            {
+                lhs.l ^= rhs.l;
+                lhs.r ^= rhs.r;
+                return lhs;
+            }
+
+            ARKXMM_API camellia_f_per_lane(v64& l, const v64& r, const v64& k) -> v64&
+            {
+                auto v = r;
+                v ^= k;
+                v = camellia_sp(v);
+                l.l ^= v.r;
+                l.r ^= v.l;
+                return l;
+            }
+
+            ARKXMM_API camellia_fl_per_lane(v64& l, const v64& k) -> v64&
+            {
+                v32 v = l.l;
+                v.x0 &= k.l.x0;
+                v.x1 &= k.l.x1;
+                v.x2 &= k.l.x2;
+                v.x3 &= k.l.x3;
+                v = rotl_be1(v);
+                v = l.r ^= v;
+
+                v.x0 |= k.r.x0;
+                v.x1 |= k.r.x1;
+                v.x2 |= k.r.x2;
+                v.x3 |= k.r.x3;
+                v = l.l ^= v;
+                return l;
+            }
+
+            ARKXMM_API camellia_fl_inv_per_lane(v64& r, const v64& k) -> v64&
+            {
+                v32 v = r.r;
+                v.x0 |= k.r.x0;
+                v.x1 |= k.r.x1;
+                v.x2 |= k.r.x2;
+                v.x3 |= k.r.x3;
+                v = r.l ^= v;
+
+                v.x0 &= k.l.x0;
+                v.x1 &= k.l.x1;
+                v.x2 &= k.l.x2;
+                v.x3 &= k.l.x3;
+                v = rotl_be1(v);
+                v = r.r ^= v;
+                return r;
+            }
+
+            ARKXMM_API camellia_prewhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                byte_slice_16x16(
+                    block.l.l.x0, block.l.l.x1, block.l.l.x2, block.l.l.x3,
+                    block.l.r.x0, block.l.r.x1, block.l.r.x2, block.l.r.x3,
+                    block.r.l.x0, block.r.l.x1, block.r.l.x2, block.r.l.x3,
+                    block.r.r.x0, block.r.r.x1, block.r.r.x2, block.r.r.x3);
+
+                block.l ^= kl;
+                block.r ^= kr;
+                return block;
+            }
+
+            ARKXMM_API camellia_postwhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                block.r ^= kl;
+                block.l ^= kr;
+
+                byte_slice_16x16(
+                    block.r.l.x0, block.r.r.x0, block.l.l.x0, block.l.r.x0,
+                    block.r.l.x1, block.r.r.x1, block.l.l.x1, block.l.r.x1,
+                    block.r.l.x2, block.r.r.x2, block.l.l.x2, block.l.r.x2,
+                    block.r.l.x3, block.r.r.x3, block.l.l.x3, block.l.r.x3);
+                return block;
+            }
+
+            // Slices 32 key vectors into a per-lane key vector. lane[i] is the key vector of i-th block of a batch.
+            template <class lane_key_vector_t, class key_vector_t>
+            static inline void slice_key_vectors(lane_key_vector_t& dst, const key_vector_t* const (&lane)[32]) noexcept
+            {
+                // a key vector is a sequence of 128-bit subkey pairs {kw_1, kw_2}, {k_1, k_2}, ..., which are sliced as blocks are.
+                constexpr size_t pair_count = sizeof(key_vector_t) / sizeof(key64[2]);
+                static_assert(sizeof(lane_key_vector_t) == sizeof(v128) * pair_count);
+
+                for (size_t p = 0; p < pair_count; p++)
+                {
+                    std::array<byte_array<16>, 32> buf;
+                    for (size_t i = 0; i < 32; i++)
+                        memcpy(&buf[i], reinterpret_cast<const byte_t*>(lane[i]) + p * 16, 16);
+
+                    v128 v = load_v128(reinterpret_cast<const v128*>(buf.data()));
+                    byte_slice_16x16(
+                        v.l.l.x0, v.l.l.x1, v.l.l.x2, v.l.l.x3,
+                        v.l.r.x0, v.l.r.x1, v.l.r.x2, v.l.r.x3,
+                        v.r.l.x0, v.r.l.x1, v.r.l.x2, v.r.l.x3,
+                        v.r.r.x0, v.r.r.x1, v.r.r.x2, v.r.r.x3);
+                    reinterpret_cast<v128*>(&dst)[p] = v;
+                }
+            }
+
+            // pre-broadcast keys
+            //   The key vector of a context is expanded once into the per-lane layout with every lane holding the same key,
+            //   so that the round function only loads and xors subkeys instead of broadcasting them with byte shuffles.
+
+            template <class key_vector_t>
+            using expanded_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+            template <class key_vector_t>
+            static inline auto expand_key_vector(const key_vector_t& kv) noexcept -> expanded_key_vector_t<key_vector_t>
+            {
+                // slicing identical lanes (see slice_key_vectors) leaves byte j of a subkey pair broadcast in register j,
+                // so the layout is built by broadcasts directly instead of transposing 32 copies.
+                constexpr size_t pair_count = sizeof(key_vector_t) / sizeof(key64[2]);
+                static_assert(sizeof(expanded_key_vector_t<key_vector_t>) == sizeof(v128) * pair_count);
+                static_assert(sizeof(v128) == sizeof(vu8x32) * 16);
+
+                expanded_key_vector_t<key_vector_t> ekv;
+                for (size_t p = 0; p < pair_count; p++)
+                {
+                    const auto* pair = reinterpret_cast<const uint8_t*>(&kv) + p * 16;
+                    auto* dst = reinterpret_cast<vu8x32*>(reinterpret_cast<v128*>(&ekv) + p);
+                    for (size_t j = 0; j < 16; j++) dst[j] = u8x32(pair[j]);
+                }
+                return ekv;
+            }
+
+            // prewhitening for byte-sliced input (ctr-mode)
+            ARKXMM_API camellia_sliced_prewhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                block.l ^= kl;
+                block.r ^= kr;
+                return block;
+            }
         }
 
         using ref::key_vector_small_t;
@@ -465,6 +681,73 @@ namespace arkana::camellia
             using ref::impl::key_vector_large_t;
             using ref::impl::generate_key_vector;
 
+            // batched key scheduling
+            //   KA and KB of 32 keys are derived at once by the byte-sliced F function,
+            //   then the key vector of each key is assembled from its rotated sub-keys.
+            template <size_t key_length, bool encrypting>
+            static inline void generate_key_vectors(
+                functions::key_vector_for_t<key_t<key_length>, key64>* dst, const key_t<key_length>* const* keys, size_t count,
+                bool_constant_t<encrypting>  = {}) noexcept
+            {
+                using functions::sub_key128_t;
+                using functions::key_schedule_sigma;
+                static_assert(sizeof(std::array<sub_key128_t, 32>) == sizeof(v128));
+
+                const auto slice = [](const std::array<sub_key128_t, 32>& k) -> v128
+                {
+                    v128 v = load_v128(reinterpret_cast<const v128*>(k.data()));
+                    return camellia_prewhite(v, 0, 0);
+                };
+
+                const auto unslice = [](std::array<sub_key128_t, 32>& k, const v128& v)
+                {
+                    v128 w{v.r, v.l}; // camellia_postwhite + swap_store_v128 emit {r, l} as the cipher output.
+                    swap_store_v128(reinterpret_cast<v128*>(k.data()), camellia_postwhite(w, 0, 0));
+                };
+
+                for (size_t i = 0; i < count; i += 32)
+                {
+                    const size_t n = std::min<size_t>(count - i, 32);
+
+                    // little endian 128bit sub-key {KL,KR,KA,KB} of each lane
+                    std::array<sub_key128_t, 32> kl{}, kr{}, ka{}, kb{};
+                    for (size_t j = 0; j < n; j++)
+                        std::tie(kl[j], kr[j]) = functions::load_key_kl_kr<key_length>(*keys[i + j]);
+
+                    v128 skl = slice(kl);
+                    v128 skr = slice(kr);
+                    v128 t = skl;
+                    t.l ^= skr.l;
+                    t.r ^= skr.r;
+                    camellia_f(t.r, t.l, key_schedule_sigma[0]);
+                    camellia_f(t.l, t.r, key_schedule_sigma[1]);
+                    t.l ^= skl.l;
+                    t.r ^= skl.r;
+                    camellia_f(t.r, t.l, key_schedule_sigma[2]);
+                    camellia_f(t.l, t.r, key_schedule_sigma[3]);
+                    unslice(ka, t);
+                    if constexpr (key_length * 8 != 128)
+                    {
+                        t.l ^= skr.l;
+                        t.r ^= skr.r;
+                        camellia_f(t.r, t.l, key_schedule_sigma[4]);
+                        camellia_f(t.l, t.r, key_schedule_sigma[5]);
+                        unslice(kb, t);
+                    }
+
+                    for (size_t j = 0; j < n; j++)
+                        dst[i + j] = functions::assemble_key_vector<key_length, encrypting>(kl[j].byteswap(), kr[j].byteswap(), ka[j].byteswap(), kb[j].byteswap());
+
+                    bit::secure_be_zero(kl);
+                    bit::secure_be_zero(kr);
+                    bit::secure_be_zero(ka);
+                    bit::secure_be_zero(kb);
+                }
+            }
+
+            using expanded_key_vector_small_t = expanded_key_vector_t<key_vector_small_t>;
+            using expanded_key_vector_large_t = expanded_key_vector_t<key_vector_large_t>;
+
             // rfc3713 ecb-mode
             template <
                 class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
@@ -483,34 +766,124 @@ namespace arkana::camellia
                     swap_store_v128>(dst, src, length, kv);
             }
 
-            using ref::impl::ctr_iv_t;
-            using ref::impl::ctr_nonce_t;
-            using ref::impl::ctr_vector_t;
-            using ref::impl::generate_rfc5528_ctr_vector;
-            using functions::is_ctr_generator_v;
+            // rfc3713 ecb-mode with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_t& ekv)
+            {
+                using namespace functions;
+                ecb_mode::process_blocks_ecb<
+                    v128,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128>(dst, src, length, ekv);
+            }
 
-            // rfc5528 ctr-mode
+            // streaming mode
+            //   Output batches are written with non-temporal stores, and input batches are prefetched ahead with NTA hint,
+            //   so that processing a huge buffer does not evict the whole cache. dst must be 32-byte aligned.
+            struct non_temporal_t { };
+
+            // rfc3713 ecb-mode with pre-broadcast keys (streaming)
             template <
-                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
             >
-            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv)
+            static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_t& ekv, non_temporal_t)
             {
-                ctr_vector_t ctr0 = bit::load_u<ctr_vector_t>(&kv);
-                ctr0.n ^= cv.n;
-                ctr0.ivl ^= cv.ivl;
-                ctr0.ivr ^= cv.ivr;
+                using namespace functions;
+                ecb_mode::process_blocks_ecb<
+                    v128,
+                    prefetch_load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_stream_store_v128>(dst, src, length, ekv);
+                xmm::store_fence();
+            }
+
+            using ref::impl::cbc_iv_t;
 
+            // cbc-mode decryption
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& kv, cbc_iv_t& iv)
+            {
                 using namespace functions;
-                ctr_mode::process_bytes_ctr<
+                cbc_mode::process_blocks_cbc_decrypt<
                     v128,
-                    camellia_thruwhite,
+                    load_v128,
+                    camellia_prewhite,
                     camellia_f,
                     camellia_fl,
                     camellia_fl_inv,
                     camellia_postwhite,
+                    swap_xor128,
+                    store_v128>(dst, src, length, kv, iv);
+            }
+
+            // cbc-mode decryption with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& ekv, cbc_iv_t& iv)
+            {
+                using namespace functions;
+                cbc_mode::process_blocks_cbc_decrypt<
+                    v128,
                     load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
                     swap_xor128,
-                    store_v128>(dst, src, position, length, kv, [ctr0](size_t index) -> v128
+                    store_v128>(dst, src, length, ekv, iv);
+            }
+
+            using ref::impl::cbc_encrypt_job_t;
+
+            // multi-stream cbc-mode encryption: 32 jobs (lanes) at once
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using lane_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+                using namespace functions;
+                cbc_mode::process_cbc_encrypt_jobs<
+                    v128,
+                    lane_key_vector_t,
+                    slice_key_vectors<lane_key_vector_t, key_vector_t>,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128,
+                    6, // a 32-block batch costs about 6 serial blocks.
+                    ref::impl::process_cbc_encrypt_jobs<key_vector_t>>(jobs, count);
+            }
+
+            using ref::impl::ctr_iv_t;
+            using ref::impl::ctr_nonce_t;
+            using ref::impl::ctr_vector_t;
+            using ref::impl::generate_rfc5528_ctr_vector;
+            using functions::is_ctr_generator_v;
+
+            // rfc5528 counter blocks generator: returns byte-sliced 32 counter blocks of index-th batch.
+            static inline auto rfc5528_ctr_generator(const ctr_vector_t& ctr0) noexcept
+            {
+                return [ctr0](size_t index) -> v128
                 {
                     const auto ze = zero<vi8x32>();
 
@@ -551,7 +924,141 @@ namespace arkana::camellia
                     v.r.r.x2 = u8x32(static_cast<uint8_t>(ctr0.ctr >> 2 * 8)) ^ ctr.x2; // prewhitening
                     v.r.r.x3 = u8x32(static_cast<uint8_t>(ctr0.ctr >> 3 * 8)) ^ ctr.x3; // prewhitening
                     return v;
-                });
+                };
+            }
+
+            // built-in layout counter blocks generator: returns byte-sliced 32 counter blocks of index-th batch, xored with `white`.
+            //   the batch head counter and its carry into the second byte are computed once in scalar,
+            //   then each lane adds its block offset to the lowest byte and picks the upper bytes by its carry.
+            template <class ctr_layout_t>
+            static inline auto layout_ctr_generator(const block_t& initial, const block_t& white) noexcept
+            {
+                return [initial, white](size_t index) -> v128
+                {
+                    const block_t lo = ctr_layout_t::add(initial, index * 32);
+                    const block_t hi = ctr_layout_t::add(lo, 256);
+                    const uint8_t lsb = static_cast<uint8_t>(lo[ctr_layout_t::lsb_index]);
+
+                    // block offset of each lane (in the byte-sliced order)
+                    const vi8x32 offset = i8x32(
+                        0, 8, 16, 24, 2, 10, 18, 26,
+                        4, 12, 20, 28, 6, 14, 22, 30,
+                        1, 9, 17, 25, 3, 11, 19, 27,
+                        5, 13, 21, 29, 7, 15, 23, 31);
+                    const vu8x32 carry = reinterpret<vu8x32>(offset > i8x32(static_cast<int8_t>(std::min(255 - lsb, 127))));
+
+                    std::array<vu8x32, 16> x;
+                    for (size_t k = 0; k < 16; k++)
+                        x[k] = blend(u8x32(static_cast<uint8_t>(lo[k])), u8x32(static_cast<uint8_t>(hi[k])), carry);
+                    x[ctr_layout_t::lsb_index] = u8x32(lsb) + reinterpret<vu8x32>(offset);
+
+                    for (size_t k = 0; k < 16; k++)
+                        x[k] ^= u8x32(static_cast<uint8_t>(white[k])); // prewhitening
+                    return bit::bit_cast<v128>(x);
+                };
+            }
+
+            // rfc5528 ctr-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv)
+            {
+                ctr_vector_t ctr0 = bit::load_u<ctr_vector_t>(&kv);
+                ctr0.n ^= cv.n;
+                ctr0.ivl ^= cv.ivl;
+                ctr0.ivr ^= cv.ivr;
+
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_thruwhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, kv, rfc5528_ctr_generator(ctr0));
+            }
+
+            // rfc5528 ctr-mode with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& ekv, const ctr_vector_t& cv)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_sliced_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, ekv, rfc5528_ctr_generator(cv));
+            }
+
+            // rfc5528 ctr-mode with pre-broadcast keys (streaming)
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& ekv, const ctr_vector_t& cv, non_temporal_t)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_sliced_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    prefetch_load_v128,
+                    swap_xor128,
+                    stream_store_v128>(dst, src, position, length, ekv, rfc5528_ctr_generator(cv));
+                xmm::store_fence();
+            }
+
+            // built-in layout ctr-mode
+            template <
+                class ctr_layout_t,
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_thruwhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, kv, layout_ctr_generator<ctr_layout_t>(initial, bit::load_u<block_t>(&kv)));
+            }
+
+            // built-in layout ctr-mode with pre-broadcast keys
+            template <
+                class ctr_layout_t,
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_t& ekv, const block_t& initial)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_sliced_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, ekv, layout_ctr_generator<ctr_layout_t>(initial, block_t{}));
             }
 
             // custom ctr-mode
@@ -615,6 +1122,103 @@ namespace arkana::camellia
                     return load_v128(reinterpret_cast<v128*>(v.data()));
                 });
             }
+
+            // ieee 1619 xts-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& kv, const key_vector_t& tweak_kv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    xor_block<v128>,
+                    swap_xor128,
+                    store_v128,
+                    xts_next_tweak,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+            }
+
+            // ieee 1619 xts-mode with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& ekv, const key_vector_t& tweak_ekv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    xor_block<v128>,
+                    swap_xor128,
+                    store_v128,
+                    xts_next_tweak,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, ekv, tweak_ekv);
+            }
+
+            using ref::impl::ecb_job_t;
+            using ref::impl::ctr_job_t;
+
+            // multi-key ecb-mode: blocks of 32 jobs (lanes) at once
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_ecb_jobs(const ecb_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using lane_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+                using namespace functions;
+                multi_key_mode::process_block_jobs<
+                    v128,
+                    lane_key_vector_t,
+                    slice_key_vectors<lane_key_vector_t, key_vector_t>,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128,
+                    ecb_job_blocks,
+                    6, // the rest of a few jobs is processed with broadcast keys.
+                    process_ecb_job_rest<static_cast<void(*)(void*, const void*, size_t, const key_vector_t&)>(process_blocks_ecb<key_vector_t>), key_vector_t>>(jobs, count);
+            }
+
+            // multi-key ctr-mode: blocks of 32 jobs (lanes) at once
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_ctr_jobs(const ctr_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using lane_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+                using namespace functions;
+                multi_key_mode::process_block_jobs<
+                    v128,
+                    lane_key_vector_t,
+                    slice_key_vectors<lane_key_vector_t, key_vector_t>,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128,
+                    ctr_job_blocks,
+                    6, // the rest of a few jobs is processed with broadcast keys.
+                    process_ctr_job_rest<static_cast<void(*)(void*, const void*, size_t, size_t, const key_vector_t&, const ctr_vector_t&)>(process_bytes_ctr<key_vector_t>), key_vector_t>>(jobs, count);
+            }
         }
 
         using impl::key_vector_small_t;
@@ -626,9 +1230,48 @@ namespace arkana::camellia
         static inline key_vector_small_t generate_key_vector_decrypt(const key_128bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
         static inline key_vector_large_t generate_key_vector_decrypt(const key_192bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
         static inline key_vector_large_t generate_key_vector_decrypt(const key_256bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline void generate_key_vectors_encrypt(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count) { return impl::generate_key_vectors(dst, keys, count, true_t{}); }
+        static inline void generate_key_vectors_encrypt(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count) { return impl::generate_key_vectors(dst, keys, count, true_t{}); }
+        static inline void generate_key_vectors_encrypt(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count) { return impl::generate_key_vectors(dst, keys, count, true_t{}); }
+        static inline void generate_key_vectors_decrypt(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count) { return impl::generate_key_vectors(dst, keys, count, false_t{}); }
+        static inline void generate_key_vectors_decrypt(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count) { return impl::generate_key_vectors(dst, keys, count, false_t{}); }
+        static inline void generate_key_vectors_decrypt(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count) { return impl::generate_key_vectors(dst, keys, count, false_t{}); }
         static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_small_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
         static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_large_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
 
+        using impl::expanded_key_vector_small_t;
+        using impl::expanded_key_vector_large_t;
+
+        static inline expanded_key_vector_small_t expand_key_vector(const key_vector_small_t& kv) { return impl::expand_key_vector(kv); }
+        static inline expanded_key_vector_large_t expand_key_vector(const key_vector_large_t& kv) { return impl::expand_key_vector(kv); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const expanded_key_vector_small_t& ekv) { return impl::process_blocks_ecb(dst, src, length, ekv); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const expanded_key_vector_large_t& ekv) { return impl::process_blocks_ecb(dst, src, length, ekv); }
+
+        using impl::non_temporal_t;
+
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const expanded_key_vector_small_t& ekv, non_temporal_t nt) { return impl::process_blocks_ecb(dst, src, length, ekv, nt); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const expanded_key_vector_large_t& ekv, non_temporal_t nt) { return impl::process_blocks_ecb(dst, src, length, ekv, nt); }
+
+        using impl::cbc_iv_t;
+
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const expanded_key_vector_small_t& ekv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, ekv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const expanded_key_vector_large_t& ekv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, ekv, iv); }
+
+        using impl::cbc_encrypt_job_t;
+
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+
+        using impl::ecb_job_t;
+        using impl::ctr_job_t;
+
+        static inline void process_ecb_jobs(const ecb_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_ecb_jobs(jobs, count); }
+        static inline void process_ecb_jobs(const ecb_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_ecb_jobs(jobs, count); }
+        static inline void process_ctr_jobs(const ctr_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_ctr_jobs(jobs, count); }
+        static inline void process_ctr_jobs(const ctr_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_ctr_jobs(jobs, count); }
+
         using impl::ctr_iv_t;
         using impl::ctr_nonce_t;
         using impl::ctr_vector_t;
@@ -636,7 +1279,20 @@ namespace arkana::camellia
         static inline ctr_vector_t generate_ctr_vector(const ctr_iv_t& ctr_iv, const ctr_nonce_t& ctr_nonce) { return impl::generate_rfc5528_ctr_vector(ctr_iv, ctr_nonce); }
         static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
         static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_small_t& ekv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, ekv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_large_t& ekv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, ekv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_small_t& ekv, const ctr_vector_t& ctr, non_temporal_t nt) { return impl::process_bytes_ctr(dst, src, position, length, ekv, ctr, nt); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_large_t& ekv, const ctr_vector_t& ctr, non_temporal_t nt) { return impl::process_bytes_ctr(dst, src, position, length, ekv, ctr, nt); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, kv, initial); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, kv, initial); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_small_t& ekv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, ekv, initial); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_large_t& ekv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, ekv, initial); }
         template <class custom_ctr_generator_t, std::enable_if_t<functions::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
         template <class custom_ctr_generator_t, std::enable_if_t<functions::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const expanded_key_vector_small_t& ekv, const expanded_key_vector_small_t& tweak_ekv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, ekv, tweak_ekv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const expanded_key_vector_large_t& ekv, const expanded_key_vector_large_t& tweak_ekv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, ekv, tweak_ekv); }
     }
 }
@@ -0,0 +1,621 @@
+/// @file
+/// @brief	arkana::camellia
+///			- Random-access readers and chunked containers of CTR-mode encrypted files
+/// @author Copyright(c) 2021 ttsuki
+///
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+
+#include "../camellia-file.h"
+#include "./camellia.h"
+#include "../ark/intrinsics.h"
+#include "../ark/parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace arkana::camellia
+{
+    // Read-only memory mapping of a whole file.
+    class mapped_file_t final
+    {
+    public:
+        explicit mapped_file_t(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "CreateFileW failed.");
+
+            LARGE_INTEGER size{};
+            if (!::GetFileSizeEx(file, &size))
+            {
+                const DWORD error = ::GetLastError();
+                ::CloseHandle(file);
+                throw std::system_error(static_cast<int>(error), std::system_category(), "GetFileSizeEx failed.");
+            }
+
+            if (static_cast<uint64_t>(size.QuadPart) > SIZE_MAX)
+            {
+                ::CloseHandle(file);
+                throw std::system_error(std::make_error_code(std::errc::file_too_large), "file is too large to map.");
+            }
+
+            size_ = static_cast<size_t>(size.QuadPart);
+            if (size_ != 0) // an empty file cannot be mapped.
+            {
+                HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                const DWORD error = ::GetLastError();
+                ::CloseHandle(file);
+                if (!mapping)
+                    throw std::system_error(static_cast<int>(error), std::system_category(), "CreateFileMappingW failed.");
+
+                data_ = static_cast<const byte_t*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                const DWORD view_error = ::GetLastError();
+                ::CloseHandle(mapping); // the view keeps the mapping alive.
+                if (!data_)
+                    throw std::system_error(static_cast<int>(view_error), std::system_category(), "MapViewOfFile failed.");
+            }
+            else
+            {
+                ::CloseHandle(file);
+            }
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "open failed.");
+
+            struct stat st{};
+            if (::fstat(fd, &st) != 0)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat failed.");
+            }
+
+            if (static_cast<uintmax_t>(st.st_size) > SIZE_MAX)
+            {
+                ::close(fd);
+                throw std::system_error(std::make_error_code(std::errc::file_too_large), "file is too large to map.");
+            }
+
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ != 0) // an empty file cannot be mapped.
+            {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+                const int error = errno;
+                ::close(fd); // the mapping keeps the file alive.
+                if (p == MAP_FAILED)
+                    throw std::system_error(error, std::generic_category(), "mmap failed.");
+
+                ::madvise(p, size_, MADV_RANDOM); // point reads: no read-ahead.
+                data_ = static_cast<const byte_t*>(p);
+            }
+            else
+            {
+                ::close(fd);
+            }
+#endif
+        }
+
+        mapped_file_t(const mapped_file_t& other) = delete;
+        mapped_file_t(mapped_file_t&& other) noexcept = delete;
+        mapped_file_t& operator=(const mapped_file_t& other) = delete;
+        mapped_file_t& operator=(mapped_file_t&& other) noexcept = delete;
+
+        ~mapped_file_t()
+        {
+            if (!data_) return;
+#if defined(_WIN32)
+            ::UnmapViewOfFile(data_);
+#else
+            ::munmap(const_cast<byte_t*>(data_), size_);
+#endif
+        }
+
+        [[nodiscard]] const byte_t* data() const noexcept { return data_; }
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    private:
+        const byte_t* data_{};
+        size_t size_{};
+    };
+
+    std::unique_ptr<ctr_file_reader_t> create_ctr_file_reader(const std::filesystem::path& path, std::unique_ptr<ctr_context_t> context, size_t extent_size, size_t cache_capacity)
+    {
+        struct ctr_file_reader_impl_t final : public virtual ctr_file_reader_t
+        {
+            struct extent_t
+            {
+                size_t index;               // extent number in file
+                std::vector<byte_t> plain;  // decrypted extent
+            };
+
+            using extent_list_t = std::list<extent_t>;
+
+            const mapped_file_t file_;
+            const std::unique_ptr<ctr_context_t> context_;
+            const size_t extent_size_;
+            const size_t extent_capacity_; // maximum number of cached extents
+            const size_t bypass_length_;   // reads at least this long are not cached
+
+            std::mutex mutex_{};
+            extent_list_t cache_{};                                         // guarded by mutex_, most recently used first
+            extent_list_t spare_{};                                         // guarded by mutex_, evicted extents to be reused (wiped)
+            std::unordered_map<size_t, extent_list_t::iterator> index_{}; // guarded by mutex_, extent number -> cache_ entry
+            std::vector<size_t> seen_{};                                    // guarded by mutex_, recently missed extents (direct-mapped, extent number + 1)
+
+            ctr_file_reader_impl_t(const std::filesystem::path& path, std::unique_ptr<ctr_context_t> ctx, size_t extent_size, size_t cache_capacity)
+                : file_(path)
+                , context_(std::move(ctx))
+                , extent_size_(extent_size)
+                , extent_capacity_(cache_capacity / extent_size)
+                , bypass_length_(std::max(cache_capacity / 4, extent_size))
+            {
+                index_.reserve(extent_capacity_);
+                size_t seen_size = 16;
+                while (seen_size < extent_capacity_ * 2) seen_size *= 2;
+                seen_.resize(seen_size);
+            }
+
+            ~ctr_file_reader_impl_t() override
+            {
+                for (auto& e : cache_) wipe(e);
+            }
+
+            static void wipe(extent_t& e) noexcept
+            {
+                bit::secure_memzero(reinterpret_cast<uint8_t*>(e.plain.data()), e.plain.size());
+            }
+
+            [[nodiscard]] size_t size() const noexcept override { return file_.size(); }
+
+            // Copies a part of an extent from the cache.
+            //   An extent is cached on its second miss: the first miss decrypts only the requested bytes,
+            //   so a one-off read costs no more than without the cache and does not evict hot extents.
+            void read_extent(byte_t* dst, size_t index, size_t offset, size_t length)
+            {
+                const size_t position = index * extent_size_;
+                extent_list_t e;
+                {
+                    std::lock_guard lock(mutex_);
+                    if (auto it = index_.find(index); it != index_.end())
+                    {
+                        cache_.splice(cache_.begin(), cache_, it->second); // most recently used
+                        memcpy(dst, it->second->plain.data() + offset, length);
+                        return;
+                    }
+
+                    size_t& seen = seen_[static_cast<size_t>(static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15 >> 32) & (seen_.size() - 1)];
+                    if (seen == index + 1)
+                    {
+                        if (!spare_.empty()) e.splice(e.begin(), spare_, spare_.begin());
+                        else e.push_back(extent_t{0, std::vector<byte_t>(extent_size_)});
+                    }
+                    seen = index + 1;
+                }
+
+                if (e.empty()) // first miss
+                {
+                    context_->process_bytes(dst, file_.data() + position + offset, position + offset, length);
+                    return;
+                }
+
+                // Decrypts the extent without the lock: other threads may read cached extents meanwhile.
+                extent_t& x = e.front();
+                const size_t size = std::min(extent_size_, file_.size() - position);
+                x.index = index;
+                context_->process_bytes(x.plain.data(), file_.data() + position, position, size);
+                memcpy(dst, x.plain.data() + offset, length);
+
+                std::lock_guard lock(mutex_);
+                if (index_.count(index)) // decrypted by another thread meanwhile
+                {
+                    wipe(x);
+                    spare_.splice(spare_.begin(), e);
+                    return;
+                }
+
+                cache_.splice(cache_.begin(), e);
+                index_.emplace(index, cache_.begin());
+                while (cache_.size() > extent_capacity_)
+                {
+                    const auto last = std::prev(cache_.end());
+                    index_.erase(last->index);
+                    wipe(*last);
+                    spare_.splice(spare_.begin(), cache_, last);
+                }
+            }
+
+            size_t read(void* dst, size_t position, size_t length) override
+            {
+                if (position >= file_.size()) return 0;
+                length = std::min(length, file_.size() - position);
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+
+                // Large reads are decrypted directly, so that a bulk scan does not flush hot extents.
+                if (extent_capacity_ == 0 || length >= bypass_length_)
+                {
+                    context_->process_bytes(dst_ptr, file_.data() + position, position, length);
+                    return length;
+                }
+
+                for (size_t done = 0; done < length;)
+                {
+                    const size_t p = position + done;
+                    const size_t offset = p % extent_size_;
+                    const size_t sz = std::min(extent_size_ - offset, length - done);
+                    read_extent(dst_ptr + done, p / extent_size_, offset, sz);
+                    done += sz;
+                }
+                return length;
+            }
+        };
+
+        if (!context)
+            throw std::invalid_argument("context must not be null.");
+
+        if (extent_size == 0 || extent_size % 16 != 0)
+            throw std::invalid_argument("invalid extent_size. extent_size must be a non-zero multiple of 16.");
+
+        return std::make_unique<ctr_file_reader_impl_t>(path, std::move(context), extent_size, cache_capacity);
+    }
+
+    static constexpr size_t container_header_size = 64;
+    static constexpr size_t container_footer_size = 32;
+    static constexpr byte_array<8> container_header_magic{byte_t{'A'}, byte_t{'R'}, byte_t{'K'}, byte_t{'C'}, byte_t{'N'}, byte_t{'T'}, byte_t{'R'}, byte_t{0}};
+    static constexpr byte_array<8> container_footer_magic{byte_t{'A'}, byte_t{'R'}, byte_t{'K'}, byte_t{'C'}, byte_t{'E'}, byte_t{'N'}, byte_t{'D'}, byte_t{0}};
+    static constexpr uint32_t container_version = 2;
+    static constexpr size_t container_key_check_offset = 40;
+    static constexpr uint64_t container_max_length = uint64_t{16} << 32; // the RFC 5528 block counter is 32-bit
+    static constexpr size_t container_writer_max_pending_chunks = 16; // bounds the writer buffers regardless of the thread count
+
+    // Key check value: CMAC of the header fields before it, so that a wrong key is rejected before any chunk is decrypted.
+    template <class key_t>
+    static cmac_tag_t container_key_check(const key_t* key, const byte_t* header)
+    {
+        auto cmac = create_cmac_context(key);
+        cmac->process_bytes(header, container_key_check_offset);
+        return cmac->finalize();
+    }
+
+    static size_t container_tag_size(container_tag_t tag)
+    {
+        switch (tag)
+        {
+        case container_tag_t::crc32: return sizeof(crc32::crc32_value_t);
+        case container_tag_t::sha256: return sizeof(sha2::sha256_digest_t);
+        }
+        throw std::invalid_argument("invalid container tag.");
+    }
+
+    // Encrypts (or decrypts) a chunk and calculates its tag over the ciphertext in a single pass.
+    static void process_container_chunk(ctr_context_t* context, container_tag_t tag, bool encrypt, byte_t* tag_dst, void* dst, const void* src, size_t position, size_t length)
+    {
+        if (tag == container_tag_t::crc32)
+        {
+            const crc32::crc32_value_t crc = encrypt
+                                                 ? encrypt_bytes_ctr_crc32(context, dst, src, position, length)
+                                                 : decrypt_bytes_ctr_crc32(context, dst, src, position, length);
+            bit::store_u<uint32_t>(tag_dst, crc);
+        }
+        else
+        {
+            auto digest = sha2::create_sha256_context();
+            if (encrypt) encrypt_bytes_ctr_sha256(context, digest.get(), dst, src, position, length);
+            else decrypt_bytes_ctr_sha256(context, digest.get(), dst, src, position, length);
+            const auto value = digest->finalize();
+            memcpy(tag_dst, value.data(), value.size());
+        }
+    }
+
+    // Calculates the tag of a chunk ciphertext.
+    static void calculate_container_tag(container_tag_t tag, byte_t* tag_dst, const void* src, size_t length)
+    {
+        if (tag == container_tag_t::crc32)
+        {
+            bit::store_u<uint32_t>(tag_dst, crc32::calculate_crc32(src, length));
+        }
+        else
+        {
+            auto digest = sha2::create_sha256_context();
+            digest->process_bytes(src, length);
+            const auto value = digest->finalize();
+            memcpy(tag_dst, value.data(), value.size());
+        }
+    }
+
+    template <class key_t>
+    static std::unique_ptr<container_writer_t> make_container_writer(std::ostream* stream, const key_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag, size_t chunk_size, size_t thread_count)
+    {
+        struct container_writer_impl_t final : public virtual container_writer_t
+        {
+            std::ostream* const stream_;
+            const std::unique_ptr<ctr_context_t> context_;
+            const container_tag_t tag_;
+            const size_t tag_size_;
+            const size_t chunk_size_;
+            parallel::worker_pool_t pool_;
+
+            std::vector<byte_t> plain_;  // pending plaintext: up to 2 chunks per thread, at most container_writer_max_pending_chunks
+            std::vector<byte_t> cipher_;
+            size_t plain_length_{};
+            std::vector<byte_t> index_{};
+            uint64_t length_{};
+            uint64_t chunk_count_{};
+            bool finished_{};
+
+            container_writer_impl_t(std::ostream* stream, const key_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag, size_t chunk_size, size_t thread_count)
+                : stream_(stream)
+                , context_(create_ctr_context(key, iv, nonce))
+                , tag_(tag)
+                , tag_size_(container_tag_size(tag))
+                , chunk_size_(chunk_size)
+                , pool_(thread_count)
+                , plain_(chunk_size * std::min(2 * pool_.thread_count(), container_writer_max_pending_chunks))
+                , cipher_(plain_.size())
+            {
+                byte_array<container_header_size> header{};
+                memcpy(header.data(), container_header_magic.data(), container_header_magic.size());
+                bit::store_u<uint32_t>(header.data() + 8, container_version);
+                bit::store_u<uint32_t>(header.data() + 12, static_cast<uint32_t>(tag));
+                bit::store_u<uint32_t>(header.data() + 16, static_cast<uint32_t>(chunk_size));
+                bit::store_u<uint32_t>(header.data() + 20, static_cast<uint32_t>(sizeof(key_t) * CHAR_BIT));
+                memcpy(header.data() + 24, iv->data(), iv->size());
+                memcpy(header.data() + 32, nonce->data(), nonce->size());
+                const cmac_tag_t key_check = container_key_check(key, header.data());
+                memcpy(header.data() + container_key_check_offset, key_check.data(), key_check.size());
+                put(header.data(), header.size());
+            }
+
+            ~container_writer_impl_t() override
+            {
+                bit::secure_memzero(reinterpret_cast<uint8_t*>(plain_.data()), plain_.size());
+            }
+
+            void put(const void* data, size_t length)
+            {
+                stream_->write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+                if (!*stream_) throw std::runtime_error("failed to write the container.");
+            }
+
+            // Encrypts pending chunks in parallel and writes them.
+            void flush()
+            {
+                const size_t count = (plain_length_ + chunk_size_ - 1) / chunk_size_;
+                const size_t index_offset = index_.size();
+                index_.resize(index_offset + count * tag_size_);
+                pool_.parallel_for(count, [&](size_t i)
+                {
+                    const size_t offset = i * chunk_size_;
+                    process_container_chunk(
+                        context_.get(), tag_, true, index_.data() + index_offset + i * tag_size_,
+                        cipher_.data() + offset, plain_.data() + offset,
+                        static_cast<size_t>(length_) + offset, std::min(chunk_size_, plain_length_ - offset));
+                });
+
+                put(cipher_.data(), plain_length_);
+                length_ += plain_length_;
+                chunk_count_ += count;
+                plain_length_ = 0;
+            }
+
+            void write(const void* src, size_t length) override
+            {
+                if (finished_) throw std::logic_error("the container is already finished.");
+                if (length > container_max_length - length_ - plain_length_) throw std::length_error("the container is too long. (2^36 bytes at most)");
+
+                auto* src_ptr = static_cast<const byte_t*>(src);
+                while (length)
+                {
+                    const size_t sz = std::min(length, plain_.size() - plain_length_);
+                    memcpy(plain_.data() + plain_length_, src_ptr, sz);
+                    plain_length_ += sz;
+                    src_ptr += sz;
+                    length -= sz;
+                    if (plain_length_ == plain_.size()) flush();
+                }
+            }
+
+            void finish() override
+            {
+                if (finished_) throw std::logic_error("the container is already finished.");
+                finished_ = true;
+
+                if (plain_length_) flush();
+                put(index_.data(), index_.size());
+
+                byte_array<container_footer_size> footer{};
+                bit::store_u<uint64_t>(footer.data() + 0, length_);
+                bit::store_u<uint64_t>(footer.data() + 8, chunk_count_);
+                bit::store_u<uint64_t>(footer.data() + 16, container_header_size + length_);
+                memcpy(footer.data() + 24, container_footer_magic.data(), container_footer_magic.size());
+                put(footer.data(), footer.size());
+                stream_->flush();
+                if (!*stream_) throw std::runtime_error("failed to write the container.");
+            }
+        };
+
+        if (!stream)
+            throw std::invalid_argument("stream must not be null.");
+
+        if (chunk_size == 0 || chunk_size % 16 != 0 || chunk_size > UINT32_MAX)
+            throw std::invalid_argument("invalid chunk_size. chunk_size must be a non-zero multiple of 16, less than 4 GiB.");
+
+        return std::make_unique<container_writer_impl_t>(stream, key, iv, nonce, tag, chunk_size, thread_count);
+    }
+
+    template <class key_t>
+    static std::unique_ptr<container_reader_t> make_container_reader(const std::filesystem::path& path, const key_t* key, size_t thread_count)
+    {
+        struct container_reader_impl_t final : public virtual container_reader_t
+        {
+            const mapped_file_t file_;
+            container_tag_t tag_{};
+            size_t tag_size_{};
+            size_t chunk_size_{};
+            size_t length_{};
+            size_t chunk_count_{};
+            std::unique_ptr<ctr_context_t> context_{};
+            std::unique_ptr<std::atomic<bool>[]> verified_{};
+            parallel::worker_pool_t pool_;
+
+            container_reader_impl_t(const std::filesystem::path& path, const key_t* key, size_t thread_count)
+                : file_(path)
+                , pool_(thread_count)
+            {
+                const byte_t* data = file_.data();
+                const uint64_t size = file_.size();
+                if (size < container_header_size + container_footer_size
+                    || memcmp(data, container_header_magic.data(), container_header_magic.size()) != 0
+                    || memcmp(data + size - container_footer_magic.size(), container_footer_magic.data(), container_footer_magic.size()) != 0
+                    || bit::load_u<uint32_t>(data + 8) != container_version)
+                    throw std::runtime_error("invalid container.");
+
+                if (bit::load_u<uint32_t>(data + 20) != sizeof(key_t) * CHAR_BIT)
+                    throw std::invalid_argument("key length does not match the container.");
+
+                const uint32_t tag = bit::load_u<uint32_t>(data + 12);
+                const uint64_t chunk_size = bit::load_u<uint32_t>(data + 16);
+                const byte_t* footer = data + size - container_footer_size;
+                const uint64_t length = bit::load_u<uint64_t>(footer + 0);
+                const uint64_t chunk_count = bit::load_u<uint64_t>(footer + 8);
+                const uint64_t index_offset = bit::load_u<uint64_t>(footer + 16);
+                if ((tag != static_cast<uint32_t>(container_tag_t::crc32) && tag != static_cast<uint32_t>(container_tag_t::sha256))
+                    || chunk_size == 0 || chunk_size % 16 != 0
+                    || length > size || length > container_max_length
+                    || chunk_count != (length + chunk_size - 1) / chunk_size
+                    || index_offset != container_header_size + length
+                    || index_offset + chunk_count * container_tag_size(static_cast<container_tag_t>(tag)) + container_footer_size != size)
+                    throw std::runtime_error("invalid container.");
+
+                const cmac_tag_t key_check = container_key_check(key, data);
+                if (memcmp(data + container_key_check_offset, key_check.data(), key_check.size()) != 0)
+                    throw std::invalid_argument("key does not match the container.");
+
+                tag_ = static_cast<container_tag_t>(tag);
+                tag_size_ = container_tag_size(tag_);
+                chunk_size_ = static_cast<size_t>(chunk_size);
+                length_ = static_cast<size_t>(length);
+                chunk_count_ = static_cast<size_t>(chunk_count);
+
+                ctr_iv_t iv{};
+                ctr_nonce_t nonce{};
+                memcpy(iv.data(), data + 24, iv.size());
+                memcpy(nonce.data(), data + 32, nonce.size());
+                context_ = create_ctr_context(key, &iv, &nonce);
+                verified_ = std::make_unique<std::atomic<bool>[]>(chunk_count_);
+            }
+
+            [[nodiscard]] size_t size() const noexcept override { return length_; }
+            [[nodiscard]] size_t chunk_size() const noexcept override { return chunk_size_; }
+            [[nodiscard]] size_t chunk_count() const noexcept override { return chunk_count_; }
+
+            [[nodiscard]] const byte_t* chunk(size_t i) const noexcept { return file_.data() + container_header_size + i * chunk_size_; }
+            [[nodiscard]] const byte_t* chunk_tag(size_t i) const noexcept { return file_.data() + container_header_size + length_ + i * tag_size_; }
+            [[nodiscard]] size_t chunk_length(size_t i) const noexcept { return std::min(chunk_size_, length_ - i * chunk_size_); }
+
+            // Verifies the chunk if not yet.
+            bool verify_chunk(size_t i)
+            {
+                if (verified_[i].load(std::memory_order_acquire)) return true;
+                byte_array<sizeof(sha2::sha256_digest_t)> tag{};
+                calculate_container_tag(tag_, tag.data(), chunk(i), chunk_length(i));
+                if (memcmp(tag.data(), chunk_tag(i), tag_size_) != 0) return false;
+                verified_[i].store(true, std::memory_order_release);
+                return true;
+            }
+
+            // Reads [begin, end) of the plaintext within chunk i.
+            void read_chunk(byte_t* dst, size_t i, size_t begin, size_t end)
+            {
+                const size_t chunk_begin = i * chunk_size_;
+                if (!verified_[i].load(std::memory_order_acquire) && begin == chunk_begin && end == chunk_begin + chunk_length(i))
+                {
+                    // whole chunk: verifies and decrypts in a single pass
+                    byte_array<sizeof(sha2::sha256_digest_t)> tag{};
+                    process_container_chunk(context_.get(), tag_, false, tag.data(), dst, chunk(i), begin, end - begin);
+                    if (memcmp(tag.data(), chunk_tag(i), tag_size_) != 0)
+                    {
+                        bit::secure_memzero(reinterpret_cast<uint8_t*>(dst), end - begin);
+                        throw std::runtime_error("container chunk is corrupted.");
+                    }
+                    verified_[i].store(true, std::memory_order_release);
+                    return;
+                }
+
+                if (!verify_chunk(i))
+                    throw std::runtime_error("container chunk is corrupted.");
+
+                context_->process_bytes(dst, chunk(i) + (begin - chunk_begin), begin, end - begin);
+            }
+
+            size_t read(void* dst, size_t position, size_t length) override
+            {
+                if (position >= length_) return 0;
+                length = std::min(length, length_ - position);
+                if (length == 0) return 0;
+
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+                const size_t first = position / chunk_size_;
+                const size_t last = (position + length - 1) / chunk_size_;
+                try
+                {
+                    pool_.parallel_for(last - first + 1, [&](size_t k)
+                    {
+                        const size_t i = first + k;
+                        const size_t begin = std::max(position, i * chunk_size_);
+                        const size_t end = std::min(position + length, i * chunk_size_ + chunk_size_);
+                        read_chunk(dst_ptr + (begin - position), i, begin, end);
+                    });
+                }
+                catch (const std::runtime_error&)
+                {
+                    bit::secure_memzero(reinterpret_cast<uint8_t*>(dst_ptr), length);
+                    throw;
+                }
+                return length;
+            }
+
+            size_t verify() override
+            {
+                std::vector<uint8_t> corrupted(chunk_count_);
+                pool_.parallel_for(chunk_count_, [&](size_t i) { corrupted[i] = !verify_chunk(i); });
+                return static_cast<size_t>(std::find(corrupted.begin(), corrupted.end(), uint8_t{1}) - corrupted.begin());
+            }
+        };
+
+        return std::make_unique<container_reader_impl_t>(path, key, thread_count);
+    }
+
+    std::unique_ptr<container_writer_t> create_container_writer(std::ostream* stream, const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag, size_t chunk_size, size_t thread_count) { return make_container_writer(stream, key, iv, nonce, tag, chunk_size, thread_count); }
+    std::unique_ptr<container_writer_t> create_container_writer(std::ostream* stream, const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag, size_t chunk_size, size_t thread_count) { return make_container_writer(stream, key, iv, nonce, tag, chunk_size, thread_count); }
+    std::unique_ptr<container_writer_t> create_container_writer(std::ostream* stream, const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, container_tag_t tag, size_t chunk_size, size_t thread_count) { return make_container_writer(stream, key, iv, nonce, tag, chunk_size, thread_count); }
+
+    std::unique_ptr<container_reader_t> create_container_reader(const std::filesystem::path& path, const key_128bit_t* key, size_t thread_count) { return make_container_reader(path, key, thread_count); }
+    std::unique_ptr<container_reader_t> create_container_reader(const std::filesystem::path& path, const key_192bit_t* key, size_t thread_count) { return make_container_reader(path, key, thread_count); }
+    std::unique_ptr<container_reader_t> create_container_reader(const std::filesystem::path& path, const key_256bit_t* key, size_t thread_count) { return make_container_reader(path, key, thread_count); }
+}
@@ -10,6 +10,9 @@
 
 #include "./camellia.h"
 #include "./camellia-ia32.h"
+#include "./ghash-ref.h"
+
+#include <stdexcept>
 
 namespace arkana::camellia
 {
@@ -20,24 +23,87 @@ namespace arkana::camellia
 
     void process_blocks_ecb_ia32(void* dst, const void* src, size_t length, const key_vector_small_t& kv)
     {
+        if (cpu_supports_ia32bmi2()) return process_blocks_ecb_ia32bmi2(dst, src, length, kv);
         return ia32::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv));
     }
 
     void process_blocks_ecb_ia32(void* dst, const void* src, size_t length, const key_vector_large_t& kv)
     {
+        if (cpu_supports_ia32bmi2()) return process_blocks_ecb_ia32bmi2(dst, src, length, kv);
         return ia32::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv));
     }
 
+    void process_blocks_cbc_decrypt_ia32(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv)
+    {
+        if (cpu_supports_ia32bmi2()) return process_blocks_cbc_decrypt_ia32bmi2(dst, src, length, kv, iv);
+        return ia32::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), iv);
+    }
+
+    void process_blocks_cbc_decrypt_ia32(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv)
+    {
+        if (cpu_supports_ia32bmi2()) return process_blocks_cbc_decrypt_ia32bmi2(dst, src, length, kv, iv);
+        return ia32::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), iv);
+    }
+
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count)
+    {
+        return ia32::process_cbc_encrypt_jobs(reinterpret_cast<const ia32::cbc_encrypt_job_t<ia32::key_vector_small_t>*>(jobs), count);
+    }
+
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count)
+    {
+        return ia32::process_cbc_encrypt_jobs(reinterpret_cast<const ia32::cbc_encrypt_job_t<ia32::key_vector_large_t>*>(jobs), count);
+    }
+
     void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv)
     {
+        if (cpu_supports_ia32bmi2()) return process_bytes_ctr_ia32bmi2(dst, src, position, length, kv, cv);
         return ia32::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), bit::type_punning_cast<const ia32::ctr_vector_t&>(cv));
     }
 
     void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv)
     {
+        if (cpu_supports_ia32bmi2()) return process_bytes_ctr_ia32bmi2(dst, src, position, length, kv, cv);
         return ia32::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), bit::type_punning_cast<const ia32::ctr_vector_t&>(cv));
     }
 
+    template <class key_vector_t>
+    static void process_bytes_ctr_layout_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        switch (layout)
+        {
+        case ctr_layout_t::be128: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_be128::make_ctr_provider(initial));
+        case ctr_layout_t::be64: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_be64::make_ctr_provider(initial));
+        case ctr_layout_t::be32: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_be32::make_ctr_provider(initial));
+        case ctr_layout_t::le32: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_le32::make_ctr_provider(initial));
+        }
+        throw std::invalid_argument("invalid layout.");
+    }
+
+    void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        if (cpu_supports_ia32bmi2()) return process_bytes_ctr_ia32bmi2(dst, src, position, length, kv, initial, layout);
+        return process_bytes_ctr_layout_ia32(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), initial, layout);
+    }
+
+    void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        if (cpu_supports_ia32bmi2()) return process_bytes_ctr_ia32bmi2(dst, src, position, length, kv, initial, layout);
+        return process_bytes_ctr_layout_ia32(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), initial, layout);
+    }
+
+    void process_sectors_xts_ia32(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv)
+    {
+        if (cpu_supports_ia32bmi2()) return process_sectors_xts_ia32bmi2(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+        return ia32::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), bit::type_punning_cast<const ia32::key_vector_small_t&>(tweak_kv));
+    }
+
+    void process_sectors_xts_ia32(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv)
+    {
+        if (cpu_supports_ia32bmi2()) return process_sectors_xts_ia32bmi2(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+        return ia32::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), bit::type_punning_cast<const ia32::key_vector_large_t&>(tweak_kv));
+    }
+
     template <class key_vector_t>
     static std::unique_ptr<ecb_context_t> make_ia32_ecb_context(key_vector_t kv)
     {
@@ -52,6 +118,21 @@ namespace arkana::camellia
         return std::make_unique<ecb_context_impl_t>(kv);
     }
 
+    template <class key_vector_t>
+    static std::unique_ptr<cbc_decrypt_context_t> make_ia32_cbc_decrypt_context(key_vector_t kv, const cbc_iv_t* iv)
+    {
+        struct cbc_decrypt_context_impl_t final : public virtual cbc_decrypt_context_t
+        {
+            const key_vector_t key_vector_;
+            cbc_iv_t iv_;
+            explicit cbc_decrypt_context_impl_t(key_vector_t kv, const cbc_iv_t& iv) : key_vector_(kv), iv_(iv) { }
+            ~cbc_decrypt_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(iv_); }
+            void process_blocks(void* dst, const void* src, size_t length) override { return process_blocks_cbc_decrypt_ia32(dst, src, length, key_vector_, iv_); }
+        };
+
+        return std::make_unique<cbc_decrypt_context_impl_t>(kv, *iv);
+    }
+
     template <class key_vector_t, class ctr_vector_t>
     static std::unique_ptr<ctr_context_t> make_ia32_ctr_context(key_vector_t kv, ctr_vector_t cv)
     {
@@ -67,13 +148,99 @@ namespace arkana::camellia
         return std::make_unique<ctr_context_impl_t>(kv, cv);
     }
 
+    template <class key_vector_t>
+    static std::unique_ptr<ctr_context_t> make_ia32_ctr_context(key_vector_t kv, const block_t& initial, ctr_layout_t layout)
+    {
+        struct ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const key_vector_t key_vector_;
+            const block_t initial_;
+            const ctr_layout_t layout_;
+            explicit ctr_context_impl_t(key_vector_t kv, const block_t& initial, ctr_layout_t layout) : key_vector_(kv), initial_(initial), layout_(layout) { }
+            ~ctr_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<block_t&>(initial_)); }
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override { return process_bytes_ctr_ia32(dst, src, position, length, key_vector_, initial_, layout_); }
+        };
+
+        return std::make_unique<ctr_context_impl_t>(kv, initial, layout);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<gcm_context_t> make_ia32_gcm_context(key_vector_t kv)
+    {
+        struct gcm_context_impl_t final : public virtual gcm_context_t
+        {
+            const key_vector_t key_vector_;
+            ghash::ref::ghash_key_t hash_key_;
+
+            explicit gcm_context_impl_t(key_vector_t kv) : key_vector_(kv), hash_key_()
+            {
+                ghash::ghash_block_t h{};
+                process_blocks_ecb_ia32(h.data(), h.data(), h.size(), key_vector_); // H = E(0^128)
+                hash_key_ = ghash::ref::generate_ghash_key(h);
+                bit::secure_be_zero(h);
+            }
+
+            ~gcm_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(hash_key_); }
+
+            void encrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, gcm_tag_t* tag) override
+            {
+                const ctr_vector_t cv = generate_gcm_ctr_vector(iv);
+                return functions::process_bytes_gcm_encrypt(
+                    dst, src, length, aad, aad_length, *tag,
+                    [&](void* d, const void* s, size_t position, size_t len) { return process_bytes_ctr_ia32(d, s, position, len, key_vector_, cv); },
+                    [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::ref::ghash_update(y, hash_key_, data, len); });
+            }
+
+            bool decrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, const gcm_tag_t* tag) override
+            {
+                const ctr_vector_t cv = generate_gcm_ctr_vector(iv);
+                return functions::process_bytes_gcm_decrypt(
+                    dst, src, length, aad, aad_length, *tag,
+                    [&](void* d, const void* s, size_t position, size_t len) { return process_bytes_ctr_ia32(d, s, position, len, key_vector_, cv); },
+                    [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::ref::ghash_update(y, hash_key_, data, len); });
+            }
+        };
+
+        return std::make_unique<gcm_context_impl_t>(kv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<xts_context_t> make_ia32_xts_context(key_vector_t kv, key_vector_t tweak_kv)
+    {
+        struct xts_context_impl_t final : public virtual xts_context_t
+        {
+            const key_vector_t key_vector_;
+            const key_vector_t tweak_key_vector_;
+            explicit xts_context_impl_t(key_vector_t kv, key_vector_t tweak_kv) : key_vector_(kv), tweak_key_vector_(tweak_kv) { }
+            ~xts_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<key_vector_t&>(tweak_key_vector_)); }
+            void process_sectors(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length) override { return process_sectors_xts_ia32(dst, src, sector_index, sector_size, length, key_vector_, tweak_key_vector_); }
+        };
+
+        return std::make_unique<xts_context_impl_t>(kv, tweak_kv);
+    }
+
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_ia32(const key_128bit_t* key) { return make_ia32_ecb_context(generate_key_vector_encrypt(key)); }
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_ia32(const key_192bit_t* key) { return make_ia32_ecb_context(generate_key_vector_encrypt(key)); }
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_ia32(const key_256bit_t* key) { return make_ia32_ecb_context(generate_key_vector_encrypt(key)); }
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_ia32(const key_128bit_t* key) { return make_ia32_ecb_context(generate_key_vector_decrypt(key)); }
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_ia32(const key_192bit_t* key) { return make_ia32_ecb_context(generate_key_vector_decrypt(key)); }
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_ia32(const key_256bit_t* key) { return make_ia32_ecb_context(generate_key_vector_decrypt(key)); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_ia32(const key_128bit_t* key, const cbc_iv_t* iv) { return make_ia32_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_ia32(const key_192bit_t* key, const cbc_iv_t* iv) { return make_ia32_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_ia32(const key_256bit_t* key, const cbc_iv_t* iv) { return make_ia32_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
     std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_ia32_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
     std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_ia32_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
     std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_ia32_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_ia32_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_ia32_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_ia32_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_ia32(const key_128bit_t* key) { return make_ia32_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_ia32(const key_192bit_t* key) { return make_ia32_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_ia32(const key_256bit_t* key) { return make_ia32_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_ia32(const key_128bit_t* key, const key_128bit_t* tweak_key) { return make_ia32_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_ia32(const key_192bit_t* key, const key_192bit_t* tweak_key) { return make_ia32_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_ia32(const key_256bit_t* key, const key_256bit_t* tweak_key) { return make_ia32_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_ia32(const key_128bit_t* key, const key_128bit_t* tweak_key) { return make_ia32_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_ia32(const key_192bit_t* key, const key_192bit_t* tweak_key) { return make_ia32_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_ia32(const key_256bit_t* key, const key_256bit_t* tweak_key) { return make_ia32_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
 }
@@ -16,6 +16,337 @@ namespace arkana::camellia
 {
     namespace ia32
     {
-        using namespace ref;
+        namespace impl
+        {
+            // 4 blocks are interleaved in a batch,
+            // so that table lookups of independent blocks hide load latency of each other.
+            static constexpr size_t lane_count = 4;
+
+            // inputs up to this length are processed by ref-impl.
+            static constexpr size_t small_length_threshold = 32;
+
+            using v32 = uint32_t;
+
+            struct v64
+            {
+                uint64_t x[lane_count];
+            };
+
+            struct v128
+            {
+                v64 l, r;
+            };
+
+            using key64 = uint64_t;
+
+            static ARKANA_FORCEINLINE auto operator ^=(v64& lhs, const v64& rhs) noexcept -> v64&
+            {
+                for (size_t i = 0; i < lane_count; i++) lhs.x[i] ^= rhs.x[i];
+                return lhs;
+            }
+
+            // extracts the byte by rotation instead of shift:
+            // with BMI2 it is a single non-destructive `rorx`, without it a `ror` in place of `shr`.
+            static ARKANA_FORCEINLINE uint64_t lookup_sbox64_rotr(const functions::sbox_t<uint64_t>& sbox, uint64_t index, int shift) noexcept
+            {
+                return sbox[static_cast<uint8_t>(shift ? bit::rotr(index, 8 * shift) : index)];
+            }
+
+            static ARKANA_FORCEINLINE auto camellia_f(v64& r, const v64& l, const key64& k) noexcept -> v64&
+            {
+                using namespace functions;
+                for (size_t i = 0; i < lane_count; i++)
+                    r.x[i] = camellia_f_table_lookup<uint64_t, lookup_sbox32, lookup_sbox64_rotr, key64>(r.x[i], l.x[i], k);
+                return r;
+            }
+
+            static ARKANA_FORCEINLINE auto camellia_fl(v64& l, const key64& k) noexcept -> v64&
+            {
+                using namespace functions;
+                for (size_t i = 0; i < lane_count; i++)
+                    l.x[i] = functions::camellia_fl<uint64_t, rotl_be1, key64>(l.x[i], k);
+                return l;
+            }
+
+            static ARKANA_FORCEINLINE auto camellia_fl_inv(v64& r, const key64& k) noexcept -> v64&
+            {
+                using namespace functions;
+                for (size_t i = 0; i < lane_count; i++)
+                    r.x[i] = functions::camellia_fl_inv<uint64_t, rotl_be1, key64>(r.x[i], k);
+                return r;
+            }
+
+            static ARKANA_FORCEINLINE auto camellia_prewhite(v128& block, const key64& kl, const key64& kr) noexcept -> v128&
+            {
+                for (size_t i = 0; i < lane_count; i++)
+                {
+                    block.l.x[i] ^= kl;
+                    block.r.x[i] ^= kr;
+                }
+                return block;
+            }
+
+            static ARKANA_FORCEINLINE auto camellia_postwhite(v128& block, const key64& kl, const key64& kr) noexcept -> v128&
+            {
+                for (size_t i = 0; i < lane_count; i++)
+                {
+                    const uint64_t l = block.r.x[i] ^ kl;
+                    const uint64_t r = block.l.x[i] ^ kr;
+                    block.l.x[i] = l;
+                    block.r.x[i] = r;
+                }
+                return block;
+            }
+
+            static ARKANA_FORCEINLINE auto camellia_thruwhite(v128& block, const key64&, const key64&) noexcept -> v128&
+            {
+                return block;
+            }
+
+            static ARKANA_FORCEINLINE auto load_v128(const v128* src) noexcept -> v128
+            {
+                auto* p = reinterpret_cast<const byte_t*>(src);
+                v128 v;
+                for (size_t i = 0; i < lane_count; i++)
+                {
+                    v.l.x[i] = bit::load_u<uint64_t>(p + i * 16 + 0);
+                    v.r.x[i] = bit::load_u<uint64_t>(p + i * 16 + 8);
+                }
+                return v;
+            }
+
+            static ARKANA_FORCEINLINE auto store_v128(v128* dst, const v128& v) noexcept -> void
+            {
+                auto* p = reinterpret_cast<byte_t*>(dst);
+                for (size_t i = 0; i < lane_count; i++)
+                {
+                    bit::store_u<uint64_t>(p + i * 16 + 0, v.l.x[i]);
+                    bit::store_u<uint64_t>(p + i * 16 + 8, v.r.x[i]);
+                }
+            }
+
+            // t *= alpha^lane_count for all lanes
+            static ARKANA_FORCEINLINE auto xts_next_tweak(v128& t) noexcept -> v128&
+            {
+                for (size_t i = 0; i < lane_count; i++)
+                {
+                    functions::v128 u{t.l.x[i], t.r.x[i]};
+                    for (size_t j = 0; j < lane_count; j++)
+                        u = functions::xts_multiply_alpha(u);
+                    t.l.x[i] = u.l;
+                    t.r.x[i] = u.r;
+                }
+                return t;
+            }
+        }
+
+        using ref::key_vector_small_t;
+        using ref::key_vector_large_t;
+
+        namespace impl
+        {
+            using ref::impl::key_vector_small_t;
+            using ref::impl::key_vector_large_t;
+            using ref::impl::generate_key_vector;
+
+            // rfc3713 ecb-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_t& kv)
+            {
+                // a few blocks are faster in ref-impl than in a padded batch.
+                if (length <= small_length_threshold)
+                    return ref::impl::process_blocks_ecb(dst, src, length, kv);
+
+                using namespace functions;
+                ecb_mode::process_blocks_ecb<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    store_v128>(dst, src, length, kv);
+            }
+
+            using ref::impl::cbc_iv_t;
+
+            // cbc-mode decryption
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& kv, cbc_iv_t& iv)
+            {
+                using namespace functions;
+                cbc_mode::process_blocks_cbc_decrypt<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    xor_block<v128>,
+                    store_v128>(dst, src, length, kv, iv);
+            }
+
+            using ref::impl::cbc_encrypt_job_t;
+
+            // multi-stream cbc-mode encryption (serial)
+            using ref::impl::process_cbc_encrypt_jobs;
+
+            using ref::impl::ctr_iv_t;
+            using ref::impl::ctr_nonce_t;
+            using ref::impl::ctr_vector_t;
+            using ref::impl::generate_rfc5528_ctr_vector;
+            using ref::impl::gcm_iv_t;
+            using ref::impl::gcm_tag_t;
+            using ref::impl::generate_gcm_ctr_vector;
+            using functions::is_ctr_generator_v;
+
+            // rfc5528 ctr-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv)
+            {
+                if (length <= small_length_threshold)
+                    return ref::impl::process_bytes_ctr(dst, src, position, length, kv, cv);
+
+                // pre-prewhitening
+                ctr_vector_t ctr0 = bit::load_u<ctr_vector_t>(&kv);
+                ctr0.n ^= cv.n;
+                ctr0.ivl ^= cv.ivl;
+                ctr0.ivr ^= cv.ivr;
+
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_thruwhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    xor_block<v128>,
+                    store_v128>
+                (
+                    dst, src, position, length, kv,
+                    [ctr0](size_t index) -> v128
+                    {
+                        const functions::v128 c = bit::load_u<functions::v128>(&ctr0);
+                        v128 v;
+                        for (size_t i = 0; i < lane_count; i++)
+                        {
+                            v.l.x[i] = c.l;
+                            v.r.x[i] = c.r ^ static_cast<uint64_t>(bit::byteswap(static_cast<uint32_t>(index * lane_count + i + 1))) << 32; // prewhitening
+                        }
+                        return v;
+                    });
+            }
+
+            // custom ctr-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr,
+                class ctr_generator_t, std::enable_if_t<is_ctr_generator_v<ctr_generator_t>>* = nullptr>
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, ctr_generator_t&& ctr)
+            {
+                using ctr_t = std::invoke_result_t<ctr_generator_t, size_t>;
+                static_assert(sizeof(ctr_t) == 16);
+                static_assert(std::is_trivially_copyable_v<ctr_t>);
+
+                if (length <= small_length_threshold)
+                    return ref::impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<ctr_generator_t>(ctr));
+
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    xor_block<v128>,
+                    store_v128>
+                (
+                    dst, src, position, length, kv,
+                    [ctr = std::forward<decltype(ctr)>(ctr)](size_t index) -> v128
+                    {
+                        std::array<ctr_t, lane_count> v = {
+                            ctr(index * lane_count + 0),
+                            ctr(index * lane_count + 1),
+                            ctr(index * lane_count + 2),
+                            ctr(index * lane_count + 3),
+                        };
+
+                        return load_v128(reinterpret_cast<const v128*>(v.data()));
+                    });
+            }
+
+            // ieee 1619 xts-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& kv, const key_vector_t& tweak_kv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    xor_block<v128>,
+                    xor_block<v128>,
+                    store_v128,
+                    xts_next_tweak,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+            }
+        }
+
+        using impl::key_vector_small_t;
+        using impl::key_vector_large_t;
+
+        static inline key_vector_small_t generate_key_vector_encrypt(const key_128bit_t& key) { return impl::generate_key_vector(key, true_t{}); }
+        static inline key_vector_large_t generate_key_vector_encrypt(const key_192bit_t& key) { return impl::generate_key_vector(key, true_t{}); }
+        static inline key_vector_large_t generate_key_vector_encrypt(const key_256bit_t& key) { return impl::generate_key_vector(key, true_t{}); }
+        static inline key_vector_small_t generate_key_vector_decrypt(const key_128bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline key_vector_large_t generate_key_vector_decrypt(const key_192bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline key_vector_large_t generate_key_vector_decrypt(const key_256bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_small_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_large_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
+
+        using impl::cbc_iv_t;
+
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+
+        using impl::cbc_encrypt_job_t;
+
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+
+        using impl::ctr_iv_t;
+        using impl::ctr_nonce_t;
+        using impl::ctr_vector_t;
+
+        static inline ctr_vector_t generate_ctr_vector(const ctr_iv_t& ctr_iv, const ctr_nonce_t& ctr_nonce) { return impl::generate_rfc5528_ctr_vector(ctr_iv, ctr_nonce); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
+        template <class custom_ctr_generator_t, std::enable_if_t<impl::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+        template <class custom_ctr_generator_t, std::enable_if_t<impl::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+
+        using impl::gcm_iv_t;
+        using impl::gcm_tag_t;
+
+        static inline ctr_vector_t generate_gcm_ctr_vector(const gcm_iv_t& gcm_iv) { return impl::generate_gcm_ctr_vector(gcm_iv); }
+
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
     }
 }
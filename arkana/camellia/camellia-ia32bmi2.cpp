@@ -0,0 +1,89 @@
+/// @file
+/// @brief	arkana::camellia
+///			- An implementation of Camellia cipher
+/// @author Copyright(c) 2021 ttsuki
+/// 
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// - camellia https://info.isl.ntt.co.jp/crypt/camellia/ 
+
+// The ia32 kernels built with BMI2 (`rorx` in the sbox lookups).
+// process_*_ia32 forward here when cpu_supports_ia32bmi2().
+
+#include "./camellia.h"
+#include "./camellia-ia32.h"
+#include "../ark/cpuid.h"
+
+#include <stdexcept>
+
+namespace arkana::camellia
+{
+    bool cpu_supports_ia32bmi2() noexcept
+    {
+        return cpuid::cpu_supports::BMI2 && cpuid::cpu_supports::AVX2; // MSVC builds this file with /arch:AVX2
+    }
+
+    void process_blocks_ecb_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_small_t& kv)
+    {
+        return ia32::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv));
+    }
+
+    void process_blocks_ecb_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_large_t& kv)
+    {
+        return ia32::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv));
+    }
+
+    void process_blocks_cbc_decrypt_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv)
+    {
+        return ia32::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), iv);
+    }
+
+    void process_blocks_cbc_decrypt_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv)
+    {
+        return ia32::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), iv);
+    }
+
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv)
+    {
+        return ia32::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), bit::type_punning_cast<const ia32::ctr_vector_t&>(cv));
+    }
+
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv)
+    {
+        return ia32::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), bit::type_punning_cast<const ia32::ctr_vector_t&>(cv));
+    }
+
+    template <class key_vector_t>
+    static void process_bytes_ctr_layout_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        switch (layout)
+        {
+        case ctr_layout_t::be128: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_be128::make_ctr_provider(initial));
+        case ctr_layout_t::be64: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_be64::make_ctr_provider(initial));
+        case ctr_layout_t::be32: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_be32::make_ctr_provider(initial));
+        case ctr_layout_t::le32: return ia32::process_bytes_ctr(dst, src, position, length, kv, functions::ctr_layout_le32::make_ctr_provider(initial));
+        }
+        throw std::invalid_argument("invalid layout.");
+    }
+
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        return process_bytes_ctr_layout_ia32bmi2(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), initial, layout);
+    }
+
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        return process_bytes_ctr_layout_ia32bmi2(dst, src, position, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), initial, layout);
+    }
+
+    void process_sectors_xts_ia32bmi2(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv)
+    {
+        return ia32::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const ia32::key_vector_small_t&>(kv), bit::type_punning_cast<const ia32::key_vector_small_t&>(tweak_kv));
+    }
+
+    void process_sectors_xts_ia32bmi2(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv)
+    {
+        return ia32::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const ia32::key_vector_large_t&>(kv), bit::type_punning_cast<const ia32::key_vector_large_t&>(tweak_kv));
+    }
+}
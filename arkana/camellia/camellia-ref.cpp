@@ -22,4 +22,5 @@ namespace arkana::camellia
     key_vector_large_t generate_key_vector_decrypt(const key_192bit_t* key) { return bit::bit_cast<key_vector_large_t>(ref::generate_key_vector_decrypt(*key)); }
     key_vector_large_t generate_key_vector_decrypt(const key_256bit_t* key) { return bit::bit_cast<key_vector_large_t>(ref::generate_key_vector_decrypt(*key)); }
     ctr_vector_t generate_ctr_vector(const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return bit::bit_cast<ctr_vector_t>(ref::generate_ctr_vector(*iv, *nonce)); }
+    ctr_vector_t generate_gcm_ctr_vector(const gcm_iv_t* iv) { return bit::bit_cast<ctr_vector_t>(ref::generate_gcm_ctr_vector(*iv)); }
 }
@@ -277,82 +277,90 @@ namespace arkana::camellia
                 key64 kw_3, kw_4;
             };
 
+            template <class key_vector_t, class lane_key64> struct rebind_key_vector;
+            template <template <class> class key_vector_tt, class key64, class lane_key64> struct rebind_key_vector<key_vector_tt<key64>, lane_key64> { using type = key_vector_tt<lane_key64>; };
+            template <class key_vector_t, class lane_key64> using rebind_key_vector_t = typename rebind_key_vector<key_vector_t, lane_key64>::type;
+
+            template <class key_vector_t>
+            static inline void load_key_vector_lanes(key_vector_t& dst, const key_vector_t* const (&lane)[1]) noexcept
+            {
+                dst = *lane[0];
+            }
+
             template <class key_t, class key64>
             using key_vector_for_t = std::enable_if_t<
                 is_any_of_v<key_t, key_128bit_t, key_192bit_t, key_256bit_t>,
                 std::conditional_t<std::is_same_v<key_t, key_128bit_t>, key_vector_small_t<key64>, key_vector_large_t<key64>>>;
 
-            template <size_t key_length, bool encrypting, auto camellia_f = camellia_f_table_lookup<v64, lookup_sbox32, lookup_sbox64, key64>>
-            static constexpr auto generate_key_vector(const key_t<key_length>& key, bool_constant_t<encrypting>  = {}) noexcept
-                -> key_vector_for_t<key_t<key_length>, key64>
+            // 128bit sub-key {l, r}
+            struct sub_key128_t
             {
-                struct uint128_t
-                {
-                    uint64_t l, r;
+                uint64_t l, r;
 
-                    ARKANA_FORCEINLINE uint128_t operator ^(uint128_t rhs) const noexcept { return uint128_t{l ^ rhs.l, r ^ rhs.r}; }
-                    ARKANA_FORCEINLINE uint128_t& operator ^=(uint128_t rhs) noexcept { return l ^= rhs.l, r ^= rhs.r, *this; }
+                ARKANA_FORCEINLINE sub_key128_t operator ^(sub_key128_t rhs) const noexcept { return sub_key128_t{l ^ rhs.l, r ^ rhs.r}; }
+                ARKANA_FORCEINLINE sub_key128_t& operator ^=(sub_key128_t rhs) noexcept { return l ^= rhs.l, r ^= rhs.r, *this; }
 
-                    ARKANA_FORCEINLINE auto rotl(int i) const noexcept
-                    {
-                        auto xl = (i & 63) ? l << (i & 63) | r >> (-i & 63) : l;
-                        auto xr = (i & 63) ? r << (i & 63) | l >> (-i & 63) : r;
-                        return i & 64 ? uint128_t{xr, xl} : uint128_t{xl, xr};
-                    }
+                ARKANA_FORCEINLINE auto rotl(int i) const noexcept
+                {
+                    auto xl = (i & 63) ? l << (i & 63) | r >> (-i & 63) : l;
+                    auto xr = (i & 63) ? r << (i & 63) | l >> (-i & 63) : r;
+                    return i & 64 ? sub_key128_t{xr, xl} : sub_key128_t{xl, xr};
+                }
 
-                    ARKANA_FORCEINLINE auto byteswap() const noexcept
-                    {
-                        return uint128_t{bit::byteswap(r), bit::byteswap(l)};
-                    }
-                };
+                ARKANA_FORCEINLINE auto byteswap() const noexcept
+                {
+                    return sub_key128_t{bit::byteswap(r), bit::byteswap(l)};
+                }
+            };
 
-                // little endian 128bit sub-key {KL,KR,KA,KB}
-                auto [kl, kr, ka, kb] = [](const byte_t* key)
+            // little endian 128bit sub-key {KL,KR}
+            template <size_t key_length>
+            static ARKANA_FORCEINLINE auto load_key_kl_kr(const key_t<key_length>& key) noexcept -> std::pair<sub_key128_t, sub_key128_t>
+            {
+                const byte_t* k = static_cast<const byte_t*>(key.data());
+                sub_key128_t kl{};
+                sub_key128_t kr{};
+
+                if constexpr (key_length * 8 == 128)
+                {
+                    kl.l = bit::load_u<uint64_t>(k + 0);
+                    kl.r = bit::load_u<uint64_t>(k + 8);
+                    kr = {};
+                }
+                else if constexpr (key_length * 8 == 192)
                 {
-                    uint128_t kl{};
-                    uint128_t kr{};
+                    kl.l = bit::load_u<uint64_t>(k + 0);
+                    kl.r = bit::load_u<uint64_t>(k + 8);
+                    kr.l = bit::load_u<uint64_t>(k + 16);
+                    kr.r = ~kr.l;
+                }
+                else if constexpr (key_length * 8 == 256)
+                {
+                    kl.l = bit::load_u<uint64_t>(k + 0);
+                    kl.r = bit::load_u<uint64_t>(k + 8);
+                    kr.l = bit::load_u<uint64_t>(k + 16);
+                    kr.r = bit::load_u<uint64_t>(k + 24);
+                }
 
-                    if constexpr (key_length * 8 == 128)
-                    {
-                        kl.l = bit::load_u<uint64_t>(key + 0);
-                        kl.r = bit::load_u<uint64_t>(key + 8);
-                        kr = {};
-                    }
-                    else if constexpr (key_length * 8 == 192)
-                    {
-                        kl.l = bit::load_u<uint64_t>(key + 0);
-                        kl.r = bit::load_u<uint64_t>(key + 8);
-                        kr.l = bit::load_u<uint64_t>(key + 16);
-                        kr.r = ~kr.l;
-                    }
-                    else if constexpr (key_length * 8 == 256)
-                    {
-                        kl.l = bit::load_u<uint64_t>(key + 0);
-                        kl.r = bit::load_u<uint64_t>(key + 8);
-                        kr.l = bit::load_u<uint64_t>(key + 16);
-                        kr.r = bit::load_u<uint64_t>(key + 24);
-                    }
+                return std::make_pair(kl, kr);
+            }
+
+            // key schedule constants Σ1..Σ6 (byte-swapped, as key64)
+            static constexpr uint64_t key_schedule_sigma[6] =
+            {
+                0x8B90CC3B7F669EA0u, // Σ1 = 0xA09E667F3BCC908B
+                0xB273AA4C58E87AB6u, // Σ2 = 0xB67AE8584CAA73B2
+                0xBE824FE92F37EFC6u, // Σ3 = 0xC6EF372FE94F82BE
+                0x1C6FD3F1A553FF54u, // Σ4 = 0x54FF53A5F1D36F1C
+                0x1D2D68DEFA27E510u, // Σ5 = 0x10E527FADE682D1D
+                0xFDC1E6B3C28856B0u, // Σ6 = 0xB05688C2B3E6C1FD
+            };
 
-                    uint128_t t = kl;
-                    t.l ^= kr.l;
-                    t.r ^= kr.r;
-                    t.r = camellia_f(t.r, t.l, bit::byteswap(0xA09E667F3BCC908Bu));
-                    t.l = camellia_f(t.l, t.r, bit::byteswap(0xB67AE8584CAA73B2u));
-                    t.l ^= kl.l;
-                    t.r ^= kl.r;
-                    t.r = camellia_f(t.r, t.l, bit::byteswap(0xC6EF372FE94F82BEu));
-                    t.l = camellia_f(t.l, t.r, bit::byteswap(0x54FF53A5F1D36F1Cu));
-                    uint128_t ka = t;
-                    t.l ^= kr.l;
-                    t.r ^= kr.r;
-                    t.r = camellia_f(t.r, t.l, bit::byteswap(0x10E527FADE682D1Du));
-                    t.l = camellia_f(t.l, t.r, bit::byteswap(0xB05688C2B3E6C1FDu));
-                    uint128_t kb = t;
-
-                    return std::make_tuple(kl.byteswap(), kr.byteswap(), ka.byteswap(), kb.byteswap());
-                }(static_cast<const byte_t*>(key.data()));
-
-                // result
+            // assembles a key vector from big endian 128bit sub-key {KL,KR,KA,KB}
+            template <size_t key_length, bool encrypting>
+            static constexpr auto assemble_key_vector(sub_key128_t kl, sub_key128_t kr, sub_key128_t ka, sub_key128_t kb) noexcept
+                -> key_vector_for_t<key_t<key_length>, key64>
+            {
                 key_vector_for_t<key_t<key_length>, key64> r{};
                 if constexpr (std::is_same_v<decltype(r), key_vector_small_t<key64>>)
                 {
@@ -425,6 +433,32 @@ namespace arkana::camellia
                 return r;
             }
 
+            template <size_t key_length, bool encrypting, auto camellia_f = camellia_f_table_lookup<v64, lookup_sbox32, lookup_sbox64, key64>>
+            static constexpr auto generate_key_vector(const key_t<key_length>& key, bool_constant_t<encrypting>  = {}) noexcept
+                -> key_vector_for_t<key_t<key_length>, key64>
+            {
+                // little endian 128bit sub-key {KL,KR,KA,KB}
+                auto [kl, kr] = load_key_kl_kr<key_length>(key);
+
+                sub_key128_t t = kl ^ kr;
+                t.r = camellia_f(t.r, t.l, key_schedule_sigma[0]);
+                t.l = camellia_f(t.l, t.r, key_schedule_sigma[1]);
+                t ^= kl;
+                t.r = camellia_f(t.r, t.l, key_schedule_sigma[2]);
+                t.l = camellia_f(t.l, t.r, key_schedule_sigma[3]);
+                sub_key128_t ka = t;
+                sub_key128_t kb{};
+                if constexpr (key_length * 8 != 128)
+                {
+                    t ^= kr;
+                    t.r = camellia_f(t.r, t.l, key_schedule_sigma[4]);
+                    t.l = camellia_f(t.l, t.r, key_schedule_sigma[5]);
+                    kb = t;
+                }
+
+                return assemble_key_vector<key_length, encrypting>(kl.byteswap(), kr.byteswap(), ka.byteswap(), kb.byteswap());
+            }
+
             template <
                 class block_t = v128&,
                 auto camellia_prewhite = functions::camellia_prewhite<v128&, key64>,
@@ -556,6 +590,218 @@ namespace arkana::camellia
             }
         }
 
+        inline namespace cbc_mode
+        {
+            using cbc_iv_t = byte_array<16>;
+
+            // process_blocks_cbc_decrypt
+            //   Decrypts a whole block_t (a batch of camellia blocks) at once,
+            //   and xors the previous ciphertext (the source shifted by 16 bytes) in the same pass.
+            //   Batches are processed from last to first, so dst may be equal to src.
+            template <
+                class block_t = v128,
+                auto load_block = bit::load_u<v128>,
+                auto camellia_prewhite = camellia_prewhite<v128&, key64>,
+                auto camellia_f = camellia_f_table_lookup<v64&, lookup_sbox32, lookup_sbox64, key64>,
+                auto camellia_fl = camellia_fl<v64&, rotl_be1, key64>,
+                auto camellia_fl_inv = camellia_fl_inv<v64&, rotl_be1, key64>,
+                auto camellia_postwhite = camellia_postwhite<v128&, key64>,
+                auto xor_block = xor_block<v128>,
+                auto store_block = bit::store_u<v128>,
+                class key_vector_t>
+            static void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& kv, cbc_iv_t& iv)
+            {
+                static_assert(std::is_trivial_v<block_t>);
+                constexpr size_t block_size = sizeof(block_t);
+                constexpr size_t iv_size = sizeof(cbc_iv_t);
+
+                // check camellia block size.
+                if (length % 16 != 0)
+                    throw std::invalid_argument("invalid length. length must be multiple of 16.");
+
+                if (length == 0)
+                    return;
+
+                constexpr auto f = [](block_t* dst, const block_t* src, const block_t* prev, const auto& kv)
+                {
+                    block_t b = load_block(src);
+                    b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
+                    block_t p = load_block(prev);
+                    p = xor_block(p, b);
+                    store_block(dst, p);
+                };
+
+                auto* src_ptr = static_cast<const byte_t*>(src);
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+
+                const cbc_iv_t next_iv = bit::load_u<cbc_iv_t>(src_ptr + length - iv_size);
+                const size_t unit_count = length / block_size;
+                const size_t remain_bytes = length % block_size;
+
+                // Processes last partial unit if exists
+                if (remain_bytes)
+                {
+                    const size_t offset = unit_count * block_size;
+                    block_t buf{};
+                    block_t prev{};
+                    memcpy(&buf, src_ptr + offset, remain_bytes);
+                    memcpy(&prev, offset ? src_ptr + offset - iv_size : iv.data(), iv_size);
+                    memcpy(reinterpret_cast<byte_t*>(&prev) + iv_size, src_ptr + offset, remain_bytes - iv_size);
+                    f(&buf, &buf, &prev, kv);
+                    memcpy(dst_ptr + offset, &buf, remain_bytes);
+                }
+
+                // Processes units except first one: previous ciphertext is read directly from src.
+                for (size_t i = unit_count; i > 1; i--)
+                {
+                    const size_t offset = (i - 1) * block_size;
+                    f(reinterpret_cast<block_t*>(dst_ptr + offset),
+                      reinterpret_cast<const block_t*>(src_ptr + offset),
+                      reinterpret_cast<const block_t*>(src_ptr + offset - iv_size), kv);
+                }
+
+                // Processes first unit: previous ciphertext of the first block is the iv.
+                if (unit_count)
+                {
+                    block_t prev{};
+                    memcpy(&prev, iv.data(), iv_size);
+                    memcpy(reinterpret_cast<byte_t*>(&prev) + iv_size, src_ptr, block_size - iv_size);
+                    f(reinterpret_cast<block_t*>(dst_ptr), reinterpret_cast<const block_t*>(src_ptr), &prev, kv);
+                }
+
+                iv = next_iv;
+            }
+
+            // multi-stream cbc-mode encryption job
+            template <class key_vector_t>
+            struct cbc_encrypt_job_t
+            {
+                const key_vector_t* key;
+                cbc_iv_t* iv;
+                void* dst;
+                const void* src;
+                size_t length;
+            };
+
+            // process_cbc_encrypt_jobs
+            //   Processes independent cbc-encryption jobs.
+            //   Each job occupies a lane (a camellia block in block_t) of a batch, so serial cbc chains of the lanes advance together.
+            //   An idle lane is refilled with the next pending job, and lane keys are reloaded by load_lane_keys.
+            //   When active lanes become fewer than min_active_lanes and no job is pending, the rest is processed by process_jobs_serial.
+            template <
+                class block_t,
+                class lane_key_vector_t,
+                auto load_lane_keys,
+                auto load_block,
+                auto camellia_prewhite,
+                auto camellia_f,
+                auto camellia_fl,
+                auto camellia_fl_inv,
+                auto camellia_postwhite,
+                auto store_block,
+                size_t min_active_lanes,
+                auto process_jobs_serial,
+                class key_vector_t>
+            static void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_t>* jobs, size_t count)
+            {
+                static_assert(std::is_trivial_v<block_t>);
+                constexpr size_t lane_count = sizeof(block_t) / 16;
+                using job_t = cbc_encrypt_job_t<key_vector_t>;
+
+                // check camellia block size.
+                for (size_t j = 0; j < count; j++)
+                    if (jobs[j].length % 16 != 0)
+                        throw std::invalid_argument("invalid length. length must be multiple of 16.");
+
+                static constexpr key_vector_t idle_key{};
+                const key_vector_t* lane_key[lane_count];
+                const job_t* lane_job[lane_count]{};
+                size_t lane_pos[lane_count]{};
+                for (auto& k : lane_key) k = &idle_key;
+
+                // buf[i]: the last cipher block (or iv) of i-th lane.
+                cbc_iv_t buf[lane_count]{};
+                lane_key_vector_t kv{};
+
+                size_t next = 0;
+                size_t active = 0;
+                for (;;)
+                {
+                    // Assigns pending jobs to idle lanes
+                    bool key_changed = false;
+                    for (size_t i = 0; i < lane_count; i++)
+                    {
+                        while (!lane_job[i] && next < count)
+                        {
+                            const job_t* job = &jobs[next++];
+                            if (job->length == 0) continue;
+                            lane_job[i] = job;
+                            lane_pos[i] = 0;
+                            lane_key[i] = job->key;
+                            buf[i] = *job->iv;
+                            key_changed = true;
+                            active++;
+                        }
+                    }
+
+                    if (active == 0)
+                        break;
+
+                    if constexpr (min_active_lanes > 1)
+                    {
+                        // Processes the rest serially when a batch is mostly empty
+                        if (next == count && active < min_active_lanes)
+                        {
+                            for (size_t i = 0; i < lane_count; i++)
+                            {
+                                if (!lane_job[i]) continue;
+                                const job_t& job = *lane_job[i];
+                                *job.iv = buf[i];
+                                const job_t rest{
+                                    job.key, job.iv,
+                                    job.dst ? static_cast<byte_t*>(job.dst) + lane_pos[i] : nullptr,
+                                    static_cast<const byte_t*>(job.src) + lane_pos[i],
+                                    job.length - lane_pos[i]
+                                };
+                                process_jobs_serial(&rest, 1);
+                            }
+                            break;
+                        }
+                    }
+
+                    if (key_changed)
+                        load_lane_keys(kv, lane_key);
+
+                    for (size_t i = 0; i < lane_count; i++)
+                    {
+                        if (!lane_job[i]) continue;
+                        auto* s = static_cast<const byte_t*>(lane_job[i]->src) + lane_pos[i];
+                        bit::store_u<uint64_t>(buf[i].data() + 0, bit::load_u<uint64_t>(buf[i].data() + 0) ^ bit::load_u<uint64_t>(s + 0));
+                        bit::store_u<uint64_t>(buf[i].data() + 8, bit::load_u<uint64_t>(buf[i].data() + 8) ^ bit::load_u<uint64_t>(s + 8));
+                    }
+
+                    block_t b = load_block(reinterpret_cast<const block_t*>(buf));
+                    b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
+                    store_block(reinterpret_cast<block_t*>(buf), b);
+
+                    for (size_t i = 0; i < lane_count; i++)
+                    {
+                        if (!lane_job[i]) continue;
+                        const job_t& job = *lane_job[i];
+                        if (job.dst) memcpy(static_cast<byte_t*>(job.dst) + lane_pos[i], buf[i].data(), 16);
+                        if ((lane_pos[i] += 16) == job.length)
+                        {
+                            *job.iv = buf[i];
+                            lane_job[i] = nullptr;
+                            active--;
+                        }
+                    }
+                }
+
+                bit::secure_be_zero(kv);
+            }
+        }
+
         inline namespace ctr_mode
         {
             // type_traits
@@ -571,7 +817,7 @@ namespace arkana::camellia
             template <class ctr_generator_t, class block_t = block_t>
             static constexpr bool is_ctr_generator_v = is_ctr_generator<ctr_generator_t, block_t>::value;
 
-            // process_bytes_ctr
+            // process_bytes_ctr (src == nullptr: stores keystream only)
             template <
                 class block_t = v128,
                 auto camellia_prewhite = camellia_prewhite<v128&, key64>,
@@ -597,13 +843,28 @@ namespace arkana::camellia
 
                 auto f = [&load_ctr](block_t* dst, const block_t* src, size_t start, size_t count, const auto& kv)
                 {
-                    for (size_t i = 0; i < count; i++)
+                    if (src)
                     {
-                        block_t b = load_ctr(start + i);
-                        b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
-                        block_t d = load_block(src + i);
-                        d = xor_block(d, b);
-                        store_block(dst + i, d);
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            block_t b = load_ctr(start + i);
+                            b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
+                            block_t d = load_block(src + i);
+                            d = xor_block(d, b);
+                            store_block(dst + i, d);
+                        }
+                    }
+                    else
+                    {
+                        // keystream only: xor_block with zero is kept only for its lane reordering.
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            block_t b = load_ctr(start + i);
+                            b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
+                            block_t d{};
+                            d = xor_block(d, b);
+                            store_block(dst + i, d);
+                        }
                     }
                 };
 
@@ -619,12 +880,12 @@ namespace arkana::camellia
                     const size_t sz = std::min(s + length, block_size) - s;
                     auto* buf_ptr = reinterpret_cast<byte_t*>(&buf) + s;
 
-                    memcpy(buf_ptr, src_ptr, sz);
+                    if (src_ptr) memcpy(buf_ptr, src_ptr, sz);
                     f(&buf, &buf, i, 1, kv);
                     memcpy(dst_ptr, buf_ptr, sz);
 
                     i += 1;
-                    src_ptr += sz;
+                    if (src_ptr) src_ptr += sz;
                     dst_ptr += sz;
                     length -= sz;
                 }
@@ -635,7 +896,7 @@ namespace arkana::camellia
                     f(reinterpret_cast<block_t*>(dst_ptr), reinterpret_cast<const block_t*>(src_ptr), i, unit_count, kv);
 
                     i += unit_count;
-                    src_ptr += unit_count * block_size;
+                    if (src_ptr) src_ptr += unit_count * block_size;
                     dst_ptr += unit_count * block_size;
                     length -= unit_count * block_size;
                 }
@@ -646,12 +907,12 @@ namespace arkana::camellia
                     block_t buf{};
                     auto* buf_ptr = reinterpret_cast<byte_t*>(&buf);
 
-                    memcpy(buf_ptr, src_ptr, remain_bytes);
+                    if (src_ptr) memcpy(buf_ptr, src_ptr, remain_bytes);
                     f(&buf, &buf, i, 1, kv);
                     memcpy(dst_ptr, buf_ptr, remain_bytes);
 
                     i += 1;
-                    src_ptr += remain_bytes;
+                    if (src_ptr) src_ptr += remain_bytes;
                     dst_ptr += remain_bytes;
                     length -= remain_bytes;
                 }
@@ -686,6 +947,477 @@ namespace arkana::camellia
                     return bit::load_u<v128>(&v);
                 };
             }
+
+            // built-in counter block layouts
+            //   the counter field is the last `counter_bytes` bytes of the block, the rest is a fixed nonce.
+            //   block #i is (initial block + i) in the counter field (mod 2^(8 * counter_bytes)).
+
+            template <size_t counter_bytes, bool big_endian>
+            struct ctr_block_layout
+            {
+                static_assert(counter_bytes == 4 || counter_bytes == 8 || counter_bytes == 16);
+
+                // byte index of the least significant byte of the counter field
+                static constexpr size_t lsb_index = big_endian ? 15 : 16 - counter_bytes;
+
+                // byte index of the k-th significant byte of the counter field
+                static constexpr size_t byte_index(size_t k) noexcept { return big_endian ? 15 - k : 16 - counter_bytes + k; }
+
+                static inline block_t add(block_t block, uint64_t n) noexcept
+                {
+                    for (size_t k = 0; k < counter_bytes && n; k++)
+                    {
+                        n += static_cast<uint8_t>(block[byte_index(k)]);
+                        block[byte_index(k)] = static_cast<byte_t>(n);
+                        n >>= 8;
+                    }
+                    return block;
+                }
+
+                static inline auto make_ctr_provider(const block_t& initial)
+                {
+                    return [initial](size_t index) -> block_t { return add(initial, index); };
+                }
+            };
+
+            using ctr_layout_be128 = ctr_block_layout<16, true>; // 128-bit big-endian counter
+            using ctr_layout_be64 = ctr_block_layout<8, true>;   // 64-bit nonce || 64-bit big-endian counter
+            using ctr_layout_be32 = ctr_block_layout<4, true>;   // 96-bit nonce || 32-bit big-endian counter (gcm inc32)
+            using ctr_layout_le32 = ctr_block_layout<4, false>;  // 96-bit nonce || 32-bit little-endian counter
+        }
+
+        inline namespace multi_key_mode
+        {
+            // multi-key ecb-mode job
+            template <class key_vector_t>
+            struct ecb_job_t
+            {
+                const key_vector_t* key;
+                void* dst;
+                const void* src;
+                size_t length;
+            };
+
+            // multi-key ctr-mode (rfc5528) job
+            template <class key_vector_t>
+            struct ctr_job_t
+            {
+                const key_vector_t* key;
+                const ctr_iv_t* iv;
+                const ctr_nonce_t* nonce;
+                void* dst;
+                const void* src;
+                size_t position;
+                size_t length;
+            };
+
+            // ecb job: block #i is src[i] -> dst[i]
+            struct ecb_job_blocks
+            {
+                template <class job_t> static inline void validate(const job_t& job)
+                {
+                    // check camellia block size.
+                    if (job.length % 16 != 0)
+                        throw std::invalid_argument("invalid length. length must be multiple of 16.");
+                }
+
+                template <class job_t> static inline auto range(const job_t& job) noexcept { return std::make_pair(size_t{0}, job.length / 16); }
+                template <class job_t> static inline void load(const job_t& job, size_t index, byte_t* block) noexcept { memcpy(block, static_cast<const byte_t*>(job.src) + index * 16, 16); }
+                template <class job_t> static inline void store(const job_t& job, size_t index, const byte_t* block) noexcept { memcpy(static_cast<byte_t*>(job.dst) + index * 16, block, 16); }
+            };
+
+            // ctr job: block #i is the counter block of stream position i * 16, whose keystream is xored into the bytes of the job in it.
+            struct ctr_job_blocks
+            {
+                template <class job_t> static inline void validate(const job_t&) noexcept { }
+                template <class job_t> static inline auto range(const job_t& job) noexcept { return std::make_pair(job.position / 16, job.length ? (job.position + job.length + 15) / 16 : job.position / 16); }
+
+                template <class job_t> static inline void load(const job_t& job, size_t index, byte_t* block) noexcept
+                {
+                    auto v = generate_rfc5528_ctr_vector(*job.iv, *job.nonce);
+                    v.ctr = bit::byteswap(static_cast<uint32_t>(index + 1));
+                    memcpy(block, &v, 16);
+                }
+
+                template <class job_t> static inline void store(const job_t& job, size_t index, const byte_t* block) noexcept
+                {
+                    const size_t begin = std::max(job.position, index * 16);
+                    const size_t end = std::min(job.position + job.length, index * 16 + 16);
+                    auto* d = static_cast<byte_t*>(job.dst) + (begin - job.position);
+                    auto* s = job.src ? static_cast<const byte_t*>(job.src) + (begin - job.position) : nullptr;
+
+                    if (end - begin == 16 && s)
+                    {
+                        bit::store_u<uint64_t>(d + 0, bit::load_u<uint64_t>(s + 0) ^ bit::load_u<uint64_t>(block + 0));
+                        bit::store_u<uint64_t>(d + 8, bit::load_u<uint64_t>(s + 8) ^ bit::load_u<uint64_t>(block + 8));
+                        return;
+                    }
+
+                    for (size_t k = begin; k < end; k++)
+                        *d++ = s ? *s++ ^ block[k % 16] : block[k % 16];
+                }
+            };
+
+            // process_block_jobs
+            //   Processes independent ecb/ctr jobs, each under its own key.
+            //   Each job occupies a lane (a camellia block in block_t) of a batch until its blocks run out,
+            //   then the idle lane is refilled with the next pending job, and lane keys are reloaded by load_lane_keys.
+            //   A job of lane_count blocks or more, or the rest of each job when active lanes become fewer than min_active_lanes
+            //   and no job is pending, is processed by process_job_serial (from the given block index).
+            template <
+                class block_t,
+                class lane_key_vector_t,
+                auto load_lane_keys,
+                auto load_block,
+                auto camellia_prewhite,
+                auto camellia_f,
+                auto camellia_fl,
+                auto camellia_fl_inv,
+                auto camellia_postwhite,
+                auto store_block,
+                class job_blocks,
+                size_t min_active_lanes,
+                auto process_job_serial,
+                class job_t>
+            static void process_block_jobs(const job_t* jobs, size_t count)
+            {
+                static_assert(std::is_trivial_v<block_t>);
+                constexpr size_t lane_count = sizeof(block_t) / 16;
+                using key_vector_t = std::remove_cv_t<std::remove_pointer_t<decltype(job_t::key)>>;
+
+                for (size_t j = 0; j < count; j++)
+                    job_blocks::validate(jobs[j]);
+
+                static constexpr key_vector_t idle_key{};
+                const key_vector_t* lane_key[lane_count];
+                const job_t* lane_job[lane_count]{};
+                size_t lane_index[lane_count]{};
+                size_t lane_end[lane_count]{};
+                for (auto& k : lane_key) k = &idle_key;
+
+                // buf[i]: the block of i-th lane.
+                block_t buf{};
+                lane_key_vector_t kv{};
+
+                size_t next = 0;
+                size_t active = 0;
+                for (;;)
+                {
+                    // Assigns pending jobs to idle lanes
+                    bool key_changed = false;
+                    for (size_t i = 0; i < lane_count; i++)
+                    {
+                        while (!lane_job[i] && next < count)
+                        {
+                            const job_t* job = &jobs[next++];
+                            auto [begin, end] = job_blocks::range(*job);
+                            if (begin == end) continue;
+                            if constexpr (min_active_lanes > 1)
+                            {
+                                // A long job fills a batch by itself
+                                if (end - begin >= lane_count)
+                                {
+                                    process_job_serial(*job, begin);
+                                    continue;
+                                }
+                            }
+                            lane_job[i] = job;
+                            lane_index[i] = begin;
+                            lane_end[i] = end;
+                            key_changed |= lane_key[i] != job->key;
+                            lane_key[i] = job->key;
+                            active++;
+                        }
+                    }
+
+                    if (active == 0)
+                        break;
+
+                    if constexpr (min_active_lanes > 1)
+                    {
+                        // Processes the rest serially when a batch is mostly empty
+                        if (next == count && active < min_active_lanes)
+                        {
+                            for (size_t i = 0; i < lane_count; i++)
+                                if (lane_job[i])
+                                    process_job_serial(*lane_job[i], lane_index[i]);
+                            break;
+                        }
+                    }
+
+                    if (key_changed)
+                        load_lane_keys(kv, lane_key);
+
+                    auto* lane_block = reinterpret_cast<byte_t*>(&buf);
+                    for (size_t i = 0; i < lane_count; i++)
+                        if (lane_job[i])
+                            job_blocks::load(*lane_job[i], lane_index[i], lane_block + i * 16);
+
+                    block_t b = load_block(&buf);
+                    b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
+                    store_block(&buf, b);
+
+                    for (size_t i = 0; i < lane_count; i++)
+                    {
+                        if (!lane_job[i]) continue;
+                        job_blocks::store(*lane_job[i], lane_index[i], lane_block + i * 16);
+                        if (++lane_index[i] == lane_end[i])
+                        {
+                            lane_job[i] = nullptr;
+                            active--;
+                        }
+                    }
+                }
+
+                bit::secure_be_zero(kv);
+                bit::secure_be_zero(buf);
+            }
+
+            // the rest of an ecb job from block #first, processed by a single-key process_blocks_ecb.
+            template <auto process_blocks_ecb, class key_vector_t>
+            static void process_ecb_job_rest(const ecb_job_t<key_vector_t>& job, size_t first)
+            {
+                process_blocks_ecb(
+                    static_cast<byte_t*>(job.dst) + first * 16,
+                    static_cast<const byte_t*>(job.src) + first * 16,
+                    job.length - first * 16,
+                    *job.key);
+            }
+
+            // the rest of a ctr job from block #first, processed by a single-key process_bytes_ctr.
+            template <auto process_bytes_ctr, class key_vector_t>
+            static void process_ctr_job_rest(const ctr_job_t<key_vector_t>& job, size_t first)
+            {
+                const size_t offset = std::max(job.position, first * 16) - job.position;
+                process_bytes_ctr(
+                    static_cast<byte_t*>(job.dst) + offset,
+                    job.src ? static_cast<const byte_t*>(job.src) + offset : nullptr,
+                    job.position + offset,
+                    job.length - offset,
+                    *job.key,
+                    generate_rfc5528_ctr_vector(*job.iv, *job.nonce));
+            }
+        }
+
+        inline namespace gcm_mode
+        {
+            // rfc6367 gcm-mode (96-bit iv only)
+            //   J0 = iv || 0x00000001 equals the rfc5528 counter block #0 with (nonce || iv) = gcm iv,
+            //   so the gcm keystream of the payload is the rfc5528 keystream from position 16.
+
+            using gcm_iv_t = byte_array<12>;
+            using gcm_tag_t = byte_array<16>;
+            using gcm_hash_t = byte_array<16>;
+
+            static constexpr uint64_t gcm_max_length = (uint64_t{1} << 36) - 32; // 2^39 - 256 bits
+
+            static inline ctr_vector_t generate_gcm_ctr_vector(const gcm_iv_t& iv)
+            {
+                return {
+                    bit::load_u<uint32_t>(iv.data() + 0),
+                    bit::load_u<uint32_t>(iv.data() + 4),
+                    bit::load_u<uint32_t>(iv.data() + 8),
+                    0,
+                };
+            }
+
+            // process_bytes_gcm
+            //   The payload is processed in chunks small enough to stay in L1 cache.
+            //   Each chunk is ciphered and hashed back-to-back, so every cache line is fetched from memory once.
+            //     process_ctr: void(void* dst, const void* src, size_t position, size_t length): rfc5528 ctr-mode.
+            //     ghash_update: void(gcm_hash_t& y, const void* data, size_t length): absorbs zero-padded data into y.
+            template <
+                bool encrypt,
+                size_t chunk_size = 4096,
+                class process_ctr_t,
+                class ghash_update_t>
+            static void process_bytes_gcm(
+                void* dst,
+                const void* src,
+                size_t length,
+                const void* aad,
+                size_t aad_length,
+                gcm_tag_t& tag,
+                process_ctr_t&& process_ctr,
+                ghash_update_t&& ghash_update)
+            {
+                static_assert(chunk_size % 16 == 0);
+
+                if (static_cast<uint64_t>(length) > gcm_max_length)
+                    throw std::invalid_argument("invalid length. length must be less than or equal to 2^36 - 32.");
+
+                auto* src_ptr = static_cast<const byte_t*>(src);
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+
+                gcm_hash_t y{};
+                ghash_update(y, aad, aad_length);
+
+                for (size_t i = 0; i < length; i += chunk_size)
+                {
+                    const size_t sz = std::min(length - i, chunk_size);
+                    if constexpr (!encrypt) ghash_update(y, src_ptr + i, sz); // hash cipher text before (in-place) decryption
+                    process_ctr(dst_ptr + i, src_ptr + i, 16 + i, sz);
+                    if constexpr (encrypt) ghash_update(y, dst_ptr + i, sz);
+                }
+
+                uint64_t lengths[2] = {
+                    bit::byteswap(static_cast<uint64_t>(aad_length) * 8),
+                    bit::byteswap(static_cast<uint64_t>(length) * 8),
+                };
+                ghash_update(y, lengths, sizeof(lengths));
+
+                // tag = E(J0) ^ GHASH
+                process_ctr(tag.data(), y.data(), 0, tag.size());
+                bit::secure_be_zero(y);
+            }
+
+            template <class process_ctr_t, class ghash_update_t>
+            static inline void process_bytes_gcm_encrypt(void* dst, const void* src, size_t length, const void* aad, size_t aad_length, gcm_tag_t& tag, process_ctr_t&& process_ctr, ghash_update_t&& ghash_update)
+            {
+                return process_bytes_gcm<true>(dst, src, length, aad, aad_length, tag, std::forward<process_ctr_t>(process_ctr), std::forward<ghash_update_t>(ghash_update));
+            }
+
+            template <class process_ctr_t, class ghash_update_t>
+            static inline bool process_bytes_gcm_decrypt(void* dst, const void* src, size_t length, const void* aad, size_t aad_length, const gcm_tag_t& tag, process_ctr_t&& process_ctr, ghash_update_t&& ghash_update)
+            {
+                gcm_tag_t t{};
+                process_bytes_gcm<false>(dst, src, length, aad, aad_length, t, std::forward<process_ctr_t>(process_ctr), std::forward<ghash_update_t>(ghash_update));
+
+                // constant-time comparison
+                byte_t d{};
+                for (size_t i = 0; i < t.size(); i++) d |= t[i] ^ tag[i];
+                bit::secure_be_zero(t);
+
+                // never release unauthenticated plain text
+                if (d != byte_t{})
+                {
+                    if (length) memset(dst, 0, length);
+                    return false;
+                }
+
+                return true;
+            }
+        }
+
+        inline namespace xts_mode
+        {
+            // ieee 1619 xts-mode
+
+            using xts_tweak_t = byte_array<16>;
+
+            // t = t * alpha in GF(2^128)
+            static ARKANA_FORCEINLINE constexpr auto xts_multiply_alpha(v128& t) noexcept -> v128&
+            {
+                const uint64_t carry = t.r >> 63;
+                t.r = t.r << 1 | t.l >> 63;
+                t.l = t.l << 1 ^ carry * 0x87;
+                return t;
+            }
+
+            // process_sectors_xts
+            //   Processes a run of sectors (data units) numbered from sector_index.
+            //   Initial tweaks E(K2, sector number) are encrypted by encrypt_tweaks in batches of sectors,
+            //   then tweaks of all lanes of a block_t are advanced at once by next_tweak (t *= alpha^lanes).
+            template <
+                class block_t,
+                auto load_block,
+                auto camellia_prewhite,
+                auto camellia_f,
+                auto camellia_fl,
+                auto camellia_fl_inv,
+                auto camellia_postwhite,
+                auto xor_block_in,
+                auto xor_block_out,
+                auto store_block,
+                auto next_tweak,
+                auto encrypt_tweaks,
+                class key_vector_t>
+            static void process_sectors_xts(
+                void* dst,
+                const void* src,
+                uint64_t sector_index,
+                size_t sector_size,
+                size_t length,
+                const key_vector_t& kv,
+                const key_vector_t& tweak_kv)
+            {
+                static_assert(std::is_trivial_v<block_t>);
+                constexpr size_t block_size = sizeof(block_t);
+                constexpr size_t lane_count = block_size / 16;
+                constexpr size_t tweak_batch_size = 256;
+
+                if (sector_size == 0 || sector_size % 16 != 0)
+                    throw std::invalid_argument("invalid sector_size. sector_size must be multiple of 16.");
+
+                if (length % sector_size != 0)
+                    throw std::invalid_argument("invalid length. length must be multiple of sector_size.");
+
+                constexpr auto f = [](block_t* dst, const block_t* src, const block_t& tweak, const auto& kv)
+                {
+                    block_t b = load_block(src);
+                    b = xor_block_in(b, tweak);
+                    b = process_block_inlined<block_t&, camellia_prewhite, camellia_f, camellia_fl, camellia_fl_inv, camellia_postwhite>(b, kv);
+                    block_t t = tweak;
+                    t = xor_block_out(t, b);
+                    store_block(dst, t);
+                };
+
+                auto* src_ptr = static_cast<const byte_t*>(src);
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+                const size_t sector_count = length / sector_size;
+
+                std::array<xts_tweak_t, tweak_batch_size> tweaks;
+                block_t lane_tweaks{};
+
+                for (size_t s = 0; s < sector_count; s += tweak_batch_size)
+                {
+                    // encrypts tweaks of the sectors at once
+                    const size_t batch_count = std::min(sector_count - s, tweak_batch_size);
+                    for (size_t i = 0; i < batch_count; i++)
+                    {
+                        bit::store_u<uint64_t>(tweaks[i].data() + 0, sector_index + s + i);
+                        bit::store_u<uint64_t>(tweaks[i].data() + 8, 0);
+                    }
+                    encrypt_tweaks(tweaks.data(), tweaks.data(), batch_count * sizeof(xts_tweak_t), tweak_kv);
+
+                    for (size_t i = 0; i < batch_count; i++)
+                    {
+                        // tweaks of the first batch: T, T * alpha, T * alpha^2, ...
+                        v128 t = bit::load_u<v128>(tweaks[i].data());
+                        for (size_t j = 0; j < lane_count; j++)
+                        {
+                            bit::store_u<v128>(reinterpret_cast<byte_t*>(&lane_tweaks) + j * 16, t);
+                            t = xts_multiply_alpha(t);
+                        }
+                        block_t tweak = load_block(&lane_tweaks);
+
+                        size_t remain = sector_size;
+
+                        // Processes blocks
+                        for (; remain >= block_size; remain -= block_size)
+                        {
+                            f(reinterpret_cast<block_t*>(dst_ptr), reinterpret_cast<const block_t*>(src_ptr), tweak, kv);
+                            tweak = next_tweak(tweak);
+                            src_ptr += block_size;
+                            dst_ptr += block_size;
+                        }
+
+                        // Processes last partial block if exists
+                        if (remain)
+                        {
+                            block_t buf{};
+                            memcpy(&buf, src_ptr, remain);
+                            f(&buf, &buf, tweak, kv);
+                            memcpy(dst_ptr, &buf, remain);
+                            src_ptr += remain;
+                            dst_ptr += remain;
+                        }
+                    }
+                }
+
+                bit::secure_be_zero(tweaks);
+                bit::secure_be_zero(lane_tweaks);
+            }
         }
     }
 
@@ -715,11 +1447,105 @@ namespace arkana::camellia
                     bit::store_u<v128>>(dst, src, length, kv);
             }
 
+            using functions::cbc_iv_t;
+
+            // cbc-mode decryption
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline auto process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& kv, cbc_iv_t& iv)
+            {
+                using namespace functions;
+                cbc_mode::process_blocks_cbc_decrypt<
+                    v128,
+                    bit::load_u<v128>,
+                    camellia_prewhite<v128&, key64>,
+                    camellia_f_table_lookup<v64&, lookup_sbox32, lookup_sbox64, key64>,
+                    camellia_fl<v64&, rotl_be1, key64>,
+                    camellia_fl_inv<v64&, rotl_be1, key64>,
+                    camellia_postwhite<v128&, key64>,
+                    xor_block<v128>,
+                    bit::store_u<v128>>(dst, src, length, kv, iv);
+            }
+
+            using functions::cbc_encrypt_job_t;
+
+            // multi-stream cbc-mode encryption (serial)
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using namespace functions;
+                cbc_mode::process_cbc_encrypt_jobs<
+                    v128,
+                    key_vector_t,
+                    load_key_vector_lanes<key_vector_t>,
+                    bit::load_u<v128>,
+                    camellia_prewhite<v128&, key64>,
+                    camellia_f_table_lookup<v64&, lookup_sbox32, lookup_sbox64, key64>,
+                    camellia_fl<v64&, rotl_be1, key64>,
+                    camellia_fl_inv<v64&, rotl_be1, key64>,
+                    camellia_postwhite<v128&, key64>,
+                    bit::store_u<v128>,
+                    0, nullptr>(jobs, count);
+            }
+
+            using functions::ecb_job_t;
+            using functions::ctr_job_t;
+
+            // multi-key ecb-mode (serial)
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_ecb_jobs(const ecb_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using namespace functions;
+                multi_key_mode::process_block_jobs<
+                    v128,
+                    key_vector_t,
+                    load_key_vector_lanes<key_vector_t>,
+                    bit::load_u<v128>,
+                    camellia_prewhite<v128&, key64>,
+                    camellia_f_table_lookup<v64&, lookup_sbox32, lookup_sbox64, key64>,
+                    camellia_fl<v64&, rotl_be1, key64>,
+                    camellia_fl_inv<v64&, rotl_be1, key64>,
+                    camellia_postwhite<v128&, key64>,
+                    bit::store_u<v128>,
+                    ecb_job_blocks,
+                    0, nullptr>(jobs, count);
+            }
+
+            // multi-key ctr-mode (serial)
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_ctr_jobs(const ctr_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using namespace functions;
+                multi_key_mode::process_block_jobs<
+                    v128,
+                    key_vector_t,
+                    load_key_vector_lanes<key_vector_t>,
+                    bit::load_u<v128>,
+                    camellia_prewhite<v128&, key64>,
+                    camellia_f_table_lookup<v64&, lookup_sbox32, lookup_sbox64, key64>,
+                    camellia_fl<v64&, rotl_be1, key64>,
+                    camellia_fl_inv<v64&, rotl_be1, key64>,
+                    camellia_postwhite<v128&, key64>,
+                    bit::store_u<v128>,
+                    ctr_job_blocks,
+                    0, nullptr>(jobs, count);
+            }
+
             using functions::ctr_iv_t;
             using functions::ctr_nonce_t;
             using functions::ctr_vector_t;
             using functions::generate_rfc5528_ctr_vector;
             using functions::is_ctr_generator_v;
+            using functions::gcm_iv_t;
+            using functions::gcm_tag_t;
+            using functions::generate_gcm_ctr_vector;
 
             // rfc5528 ctr-mode
             template <
@@ -778,6 +1604,28 @@ namespace arkana::camellia
                         return bit::bit_cast<v128>(ctr(index));
                     });
             }
+
+            // ieee 1619 xts-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& kv, const key_vector_t& tweak_kv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    bit::load_u<v128>,
+                    camellia_prewhite<v128&, key64>,
+                    camellia_f_table_lookup<v64&, lookup_sbox32, lookup_sbox64, key64>,
+                    camellia_fl<v64&, rotl_be1, key64>,
+                    camellia_fl_inv<v64&, rotl_be1, key64>,
+                    camellia_postwhite<v128&, key64>,
+                    xor_block<v128>,
+                    xor_block<v128>,
+                    bit::store_u<v128>,
+                    xts_multiply_alpha,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+            }
         }
 
         // public API
@@ -794,6 +1642,24 @@ namespace arkana::camellia
         static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_small_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
         static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_large_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
 
+        using impl::cbc_iv_t;
+
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+
+        using impl::cbc_encrypt_job_t;
+
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+
+        using impl::ecb_job_t;
+        using impl::ctr_job_t;
+
+        static inline void process_ecb_jobs(const ecb_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_ecb_jobs(jobs, count); }
+        static inline void process_ecb_jobs(const ecb_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_ecb_jobs(jobs, count); }
+        static inline void process_ctr_jobs(const ctr_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_ctr_jobs(jobs, count); }
+        static inline void process_ctr_jobs(const ctr_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_ctr_jobs(jobs, count); }
+
         using impl::ctr_iv_t;
         using impl::ctr_nonce_t;
         using impl::ctr_vector_t;
@@ -803,5 +1669,12 @@ namespace arkana::camellia
         static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
         template <class custom_ctr_generator_t, std::enable_if_t<impl::is_ctr_generator_v<custom_ctr_generator_t>> * = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
         template <class custom_ctr_generator_t, std::enable_if_t<impl::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+        using impl::gcm_iv_t;
+        using impl::gcm_tag_t;
+
+        static inline ctr_vector_t generate_gcm_ctr_vector(const gcm_iv_t& gcm_iv) { return impl::generate_gcm_ctr_vector(gcm_iv); }
+
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
     }
 }
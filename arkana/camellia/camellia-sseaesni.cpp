@@ -0,0 +1,265 @@
+/// @file
+/// @brief	arkana::camellia
+///			- An implementation of Camellia cipher
+/// @author Copyright(c) 2021 ttsuki
+/// 
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// - camellia: https://info.isl.ntt.co.jp/crypt/camellia/
+///
+/// This implementation based on
+///   "Block Ciphers: Fast Implementations on x86-64 Architecture"
+///   -- Oulu : J. Kivilinna, 2013,
+///   http://jultika.oulu.fi/Record/nbnfioulu-201305311409
+
+#include "./camellia.h"
+#include "./camellia-sseaesni.h"
+#include "./ghash-clmul.h"
+#include "../ark/cpuid.h"
+
+#include <stdexcept>
+
+namespace arkana::camellia
+{
+    bool cpu_supports_sseaesni() noexcept
+    {
+        return cpuid::cpu_supports::SSE41 && cpuid::cpu_supports::AESNI;
+    }
+
+    bool cpu_supports_sseaesniclmul() noexcept
+    {
+        return cpuid::cpu_supports::SSE41 && cpuid::cpu_supports::AESNI && cpuid::cpu_supports::PCLMULQDQ;
+    }
+
+    void process_blocks_ecb_sseaesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv)
+    {
+        return sseaesni::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const sseaesni::key_vector_small_t&>(kv));
+    }
+
+    void process_blocks_ecb_sseaesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv)
+    {
+        return sseaesni::process_blocks_ecb(dst, src, length, bit::type_punning_cast<const sseaesni::key_vector_large_t&>(kv));
+    }
+
+    void process_blocks_cbc_decrypt_sseaesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv)
+    {
+        return sseaesni::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const sseaesni::key_vector_small_t&>(kv), iv);
+    }
+
+    void process_blocks_cbc_decrypt_sseaesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv)
+    {
+        return sseaesni::process_blocks_cbc_decrypt(dst, src, length, bit::type_punning_cast<const sseaesni::key_vector_large_t&>(kv), iv);
+    }
+
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count)
+    {
+        return sseaesni::process_cbc_encrypt_jobs(reinterpret_cast<const sseaesni::cbc_encrypt_job_t<sseaesni::key_vector_small_t>*>(jobs), count);
+    }
+
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count)
+    {
+        return sseaesni::process_cbc_encrypt_jobs(reinterpret_cast<const sseaesni::cbc_encrypt_job_t<sseaesni::key_vector_large_t>*>(jobs), count);
+    }
+
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv)
+    {
+        return sseaesni::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const sseaesni::key_vector_small_t&>(kv), bit::type_punning_cast<const sseaesni::ctr_vector_t&>(cv));
+    }
+
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv)
+    {
+        return sseaesni::process_bytes_ctr(dst, src, position, length, bit::type_punning_cast<const sseaesni::key_vector_large_t&>(kv), bit::type_punning_cast<const sseaesni::ctr_vector_t&>(cv));
+    }
+
+    template <class key_vector_t>
+    static void process_bytes_ctr_layout_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        switch (layout)
+        {
+        case ctr_layout_t::be128: return sseaesni::process_bytes_ctr_layout<functions::ctr_layout_be128>(dst, src, position, length, kv, initial);
+        case ctr_layout_t::be64: return sseaesni::process_bytes_ctr_layout<functions::ctr_layout_be64>(dst, src, position, length, kv, initial);
+        case ctr_layout_t::be32: return sseaesni::process_bytes_ctr_layout<functions::ctr_layout_be32>(dst, src, position, length, kv, initial);
+        case ctr_layout_t::le32: return sseaesni::process_bytes_ctr_layout<functions::ctr_layout_le32>(dst, src, position, length, kv, initial);
+        }
+        throw std::invalid_argument("invalid layout.");
+    }
+
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        return process_bytes_ctr_layout_sseaesni(dst, src, position, length, bit::type_punning_cast<const sseaesni::key_vector_small_t&>(kv), initial, layout);
+    }
+
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout)
+    {
+        return process_bytes_ctr_layout_sseaesni(dst, src, position, length, bit::type_punning_cast<const sseaesni::key_vector_large_t&>(kv), initial, layout);
+    }
+
+    void process_sectors_xts_sseaesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv)
+    {
+        return sseaesni::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const sseaesni::key_vector_small_t&>(kv), bit::type_punning_cast<const sseaesni::key_vector_small_t&>(tweak_kv));
+    }
+
+    void process_sectors_xts_sseaesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv)
+    {
+        return sseaesni::process_sectors_xts(dst, src, sector_index, sector_size, length, bit::type_punning_cast<const sseaesni::key_vector_large_t&>(kv), bit::type_punning_cast<const sseaesni::key_vector_large_t&>(tweak_kv));
+    }
+
+    // expands a key vector into pre-broadcast layout
+    static sseaesni::expanded_key_vector_small_t expand_key_vector_sseaesni(const key_vector_small_t& kv) { return sseaesni::expand_key_vector(bit::type_punning_cast<const sseaesni::key_vector_small_t&>(kv)); }
+    static sseaesni::expanded_key_vector_large_t expand_key_vector_sseaesni(const key_vector_large_t& kv) { return sseaesni::expand_key_vector(bit::type_punning_cast<const sseaesni::key_vector_large_t&>(kv)); }
+
+    template <class key_vector_t>
+    static std::unique_ptr<ecb_context_t> make_sseaesni_ecb_context(key_vector_t kv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_sseaesni(kv));
+        struct ecb_context_impl_t final : public virtual ecb_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            explicit ecb_context_impl_t(const key_vector_t& kv) : key_vector_(expand_key_vector_sseaesni(kv)) { }
+            ~ecb_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)); }
+            void process_blocks(void* dst, const void* src, size_t length) override { return sseaesni::process_blocks_ecb(dst, src, length, key_vector_); }
+        };
+
+        return std::make_unique<ecb_context_impl_t>(kv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<cbc_decrypt_context_t> make_sseaesni_cbc_decrypt_context(key_vector_t kv, const cbc_iv_t* iv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_sseaesni(kv));
+        struct cbc_decrypt_context_impl_t final : public virtual cbc_decrypt_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            cbc_iv_t iv_;
+            explicit cbc_decrypt_context_impl_t(const key_vector_t& kv, const cbc_iv_t& iv) : key_vector_(expand_key_vector_sseaesni(kv)), iv_(iv) { }
+            ~cbc_decrypt_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(iv_); }
+            void process_blocks(void* dst, const void* src, size_t length) override { return sseaesni::process_blocks_cbc_decrypt(dst, src, length, key_vector_, iv_); }
+        };
+
+        return std::make_unique<cbc_decrypt_context_impl_t>(kv, *iv);
+    }
+
+    template <class key_vector_t, class ctr_vector_t>
+    static std::unique_ptr<ctr_context_t> make_sseaesni_ctr_context(key_vector_t kv, ctr_vector_t cv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_sseaesni(kv));
+        struct ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            const sseaesni::ctr_vector_t ctr_vector_;
+            explicit ctr_context_impl_t(const key_vector_t& kv, const ctr_vector_t& cv) : key_vector_(expand_key_vector_sseaesni(kv)), ctr_vector_(bit::bit_cast<sseaesni::ctr_vector_t>(cv)) { }
+            ~ctr_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<sseaesni::ctr_vector_t&>(ctr_vector_)); }
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override { return sseaesni::process_bytes_ctr(dst, src, position, length, key_vector_, ctr_vector_); }
+        };
+
+        return std::make_unique<ctr_context_impl_t>(kv, cv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<ctr_context_t> make_sseaesni_ctr_context(key_vector_t kv, const block_t& initial, ctr_layout_t layout)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_sseaesni(kv));
+        struct ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            const block_t initial_;
+            const ctr_layout_t layout_;
+            explicit ctr_context_impl_t(const key_vector_t& kv, const block_t& initial, ctr_layout_t layout) : key_vector_(expand_key_vector_sseaesni(kv)), initial_(initial), layout_(layout) { }
+            ~ctr_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<block_t&>(initial_)); }
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override { return process_bytes_ctr_layout_sseaesni(dst, src, position, length, key_vector_, initial_, layout_); }
+        };
+
+        return std::make_unique<ctr_context_impl_t>(kv, initial, layout);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<gcm_context_t> make_sseaesni_gcm_context(key_vector_t kv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_sseaesni(kv));
+        struct gcm_context_impl_t final : public virtual gcm_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            ghash::clmul::ghash_key_t hash_key_;
+
+            explicit gcm_context_impl_t(const key_vector_t& kv) : key_vector_(expand_key_vector_sseaesni(kv)), hash_key_()
+            {
+                ghash::ghash_block_t h{};
+                sseaesni::process_blocks_ecb(h.data(), h.data(), h.size(), key_vector_); // H = E(0^128)
+                hash_key_ = ghash::clmul::generate_ghash_key(h);
+                bit::secure_be_zero(h);
+            }
+
+            ~gcm_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(hash_key_); }
+
+            void encrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, gcm_tag_t* tag) override
+            {
+                const ctr_vector_t gcm_cv = generate_gcm_ctr_vector(iv);
+                const sseaesni::ctr_vector_t cv = bit::type_punning_cast<const sseaesni::ctr_vector_t&>(gcm_cv);
+                return functions::process_bytes_gcm_encrypt(
+                    dst, src, length, aad, aad_length, *tag,
+                    [&](void* d, const void* s, size_t position, size_t len) { return sseaesni::process_bytes_ctr(d, s, position, len, key_vector_, cv); },
+                    [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::clmul::ghash_update(y, hash_key_, data, len); });
+            }
+
+            bool decrypt(void* dst, const void* src, size_t length, const gcm_iv_t* iv, const void* aad, size_t aad_length, const gcm_tag_t* tag) override
+            {
+                const ctr_vector_t gcm_cv = generate_gcm_ctr_vector(iv);
+                const sseaesni::ctr_vector_t cv = bit::type_punning_cast<const sseaesni::ctr_vector_t&>(gcm_cv);
+                return functions::process_bytes_gcm_decrypt(
+                    dst, src, length, aad, aad_length, *tag,
+                    [&](void* d, const void* s, size_t position, size_t len) { return sseaesni::process_bytes_ctr(d, s, position, len, key_vector_, cv); },
+                    [&](ghash::ghash_block_t& y, const void* data, size_t len) { return ghash::clmul::ghash_update(y, hash_key_, data, len); });
+            }
+        };
+
+        return std::make_unique<gcm_context_impl_t>(kv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<xts_context_t> make_sseaesni_xts_context(key_vector_t kv, key_vector_t tweak_kv)
+    {
+        using expanded_key_vector_t = decltype(expand_key_vector_sseaesni(kv));
+        struct xts_context_impl_t final : public virtual xts_context_t
+        {
+            const expanded_key_vector_t key_vector_;
+            const expanded_key_vector_t tweak_key_vector_;
+            explicit xts_context_impl_t(const key_vector_t& kv, const key_vector_t& tweak_kv) : key_vector_(expand_key_vector_sseaesni(kv)), tweak_key_vector_(expand_key_vector_sseaesni(tweak_kv)) { }
+            ~xts_context_impl_t() override { bit::secure_be_zero(const_cast<expanded_key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<expanded_key_vector_t&>(tweak_key_vector_)); }
+            void process_sectors(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length) override { return sseaesni::process_sectors_xts(dst, src, sector_index, sector_size, length, key_vector_, tweak_key_vector_); }
+        };
+
+        return std::make_unique<xts_context_impl_t>(kv, tweak_kv);
+    }
+
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_sseaesni(const key_128bit_t* key) { return make_sseaesni_ecb_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_sseaesni(const key_192bit_t* key) { return make_sseaesni_ecb_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_sseaesni(const key_256bit_t* key) { return make_sseaesni_ecb_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_sseaesni(const key_128bit_t* key) { return make_sseaesni_ecb_context(generate_key_vector_decrypt(key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_sseaesni(const key_192bit_t* key) { return make_sseaesni_ecb_context(generate_key_vector_decrypt(key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_sseaesni(const key_256bit_t* key) { return make_sseaesni_ecb_context(generate_key_vector_decrypt(key)); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_sseaesni(const key_128bit_t* key, const cbc_iv_t* iv) { return make_sseaesni_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_sseaesni(const key_192bit_t* key, const cbc_iv_t* iv) { return make_sseaesni_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_sseaesni(const key_256bit_t* key, const cbc_iv_t* iv) { return make_sseaesni_cbc_decrypt_context(generate_key_vector_decrypt(key), iv); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_sseaesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_sseaesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_sseaesni_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce)); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_sseaesni_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_sseaesni_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout) { return make_sseaesni_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_sseaesni(const key_128bit_t* key) { return make_sseaesni_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_sseaesni(const key_192bit_t* key) { return make_sseaesni_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<gcm_context_t> create_gcm_context_sseaesni(const key_256bit_t* key) { return make_sseaesni_gcm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_sseaesni(const key_128bit_t* key, const key_128bit_t* tweak_key) { return make_sseaesni_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_sseaesni(const key_192bit_t* key, const key_192bit_t* tweak_key) { return make_sseaesni_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_sseaesni(const key_256bit_t* key, const key_256bit_t* tweak_key) { return make_sseaesni_xts_context(generate_key_vector_encrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_sseaesni(const key_128bit_t* key, const key_128bit_t* tweak_key) { return make_sseaesni_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_sseaesni(const key_192bit_t* key, const key_192bit_t* tweak_key) { return make_sseaesni_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_sseaesni(const key_256bit_t* key, const key_256bit_t* tweak_key) { return make_sseaesni_xts_context(generate_key_vector_decrypt(key), generate_key_vector_encrypt(tweak_key)); }
+    std::unique_ptr<ecb_context_t> create_ecb_context_sseaesni(const key_vector_small_t& kv) { return make_sseaesni_ecb_context(kv); }
+    std::unique_ptr<ecb_context_t> create_ecb_context_sseaesni(const key_vector_large_t& kv) { return make_sseaesni_ecb_context(kv); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_small_t& kv, const ctr_vector_t& cv) { return make_sseaesni_ctr_context(kv, cv); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_large_t& kv, const ctr_vector_t& cv) { return make_sseaesni_ctr_context(kv, cv); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_small_t& kv, const block_t* initial_counter, ctr_layout_t layout) { return make_sseaesni_ctr_context(kv, *initial_counter, layout); }
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_large_t& kv, const block_t* initial_counter, ctr_layout_t layout) { return make_sseaesni_ctr_context(kv, *initial_counter, layout); }
+}
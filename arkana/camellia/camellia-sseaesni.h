@@ -0,0 +1,960 @@
+/// @file
+/// @brief	arkana::camellia
+///			- An implementation of Camellia cipher
+/// @author Copyright(c) 2021 ttsuki
+/// 
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// - camellia: https://info.isl.ntt.co.jp/crypt/camellia/
+///
+/// This implementation based on
+///   "Block Ciphers: Fast Implementations on x86-64 Architecture"
+///   -- Oulu : J. Kivilinna, 2013,
+///   http://jultika.oulu.fi/Record/nbnfioulu-201305311409
+
+#pragma once
+
+#include "camellia-ref.h"
+#include "../ark/xmm.h"
+
+namespace arkana::camellia
+{
+    namespace sseaesni
+    {
+        namespace impl
+        {
+            using namespace arkana::xmm;
+
+            // 16 blocks are byte-sliced into 16 XMM registers in a batch.
+            static constexpr size_t lane_count = 16;
+
+            template <class T> ARKXMM_API transpose_8x4x4(XMM<T>& r) { r = byte_shuffle_128(r, i8x16(0x00, 0x04, 0x08, 0x0C, 0x01, 0x05, 0x09, 0x0D, 0x02, 0x06, 0x0A, 0x0E, 0x03, 0x07, 0x0B, 0x0F)); }
+
+            template <class XMM>
+            ARKXMM_API byte_slice_16x16(
+                XMM& x0, XMM& x1, XMM& x2, XMM& x3,
+                XMM& x4, XMM& x5, XMM& x6, XMM& x7,
+                XMM& x8, XMM& x9, XMM& xA, XMM& xB,
+                XMM& xC, XMM& xD, XMM& xE, XMM& xF)
+            {
+                // input:
+                // x0 = | 00 01 02 03  04 05 06 07  08 09 0A 0B  0C 0D 0E 0F |
+                // x1 = | 10 11 12 13  14 15 16 17  18 19 1A 1B  1C 1D 1E 1F |
+                //  :
+                // xF = | F0 F1 F2 F3  F4 F5 F6 F7  F8 F9 FA FB  FC FD FE FF |
+
+                transpose_32x4x4(x0, x4, x8, xC);
+                transpose_32x4x4(x1, x5, x9, xD);
+                transpose_32x4x4(x2, x6, xA, xE);
+                transpose_32x4x4(x3, x7, xB, xF);
+
+                transpose_8x4x4(x0);
+                transpose_8x4x4(x1);
+                transpose_8x4x4(x2);
+                transpose_8x4x4(x3);
+                transpose_8x4x4(x4);
+                transpose_8x4x4(x5);
+                transpose_8x4x4(x6);
+                transpose_8x4x4(x7);
+                transpose_8x4x4(x8);
+                transpose_8x4x4(x9);
+                transpose_8x4x4(xA);
+                transpose_8x4x4(xB);
+                transpose_8x4x4(xC);
+                transpose_8x4x4(xD);
+                transpose_8x4x4(xE);
+                transpose_8x4x4(xF);
+
+                transpose_32x4x4(x0, x1, x2, x3);
+                transpose_32x4x4(x4, x5, x6, x7);
+                transpose_32x4x4(x8, x9, xA, xB);
+                transpose_32x4x4(xC, xD, xE, xF);
+
+                // output:
+                // x0 = | 00 40 80 C0  10 50 90 D0  20 60 A0 E0  30 70 B0 F0 |
+                // x1 = | 01 41 81 C1  11 51 91 D1  21 61 A1 E1  31 71 B1 F1 |
+                //  :
+                // xF = | 0F 4F 8F CF  1F 5F 9F DF  2F 6F AF EF  3F 7F BF FF |
+            }
+
+            ARKXMM_API aes_sub_bytes(vu8x16 x) -> vu8x16
+            {
+                const vi8x16 aes_invshift = i8x16(0x00, 0x0D, 0x0A, 0x07, 0x04, 0x01, 0x0E, 0x0B, 0x08, 0x05, 0x02, 0x0F, 0x0C, 0x09, 0x06, 0x03);
+                const vu8x16 aes_input = byte_shuffle_128(x, aes_invshift); // cancel aes shift
+                const vu8x16 aes_round_key = zero<vu8x16>();
+                return vu8x16{_mm_aesenclast_si128(aes_input.v, aes_round_key.v)}; // AES S-box
+            }
+
+            ARKXMM_API filter_8bit(vu8x16 x, vu8x16 tl, vu8x16 th) noexcept -> vu8x16
+            {
+                const vu32x4 mask = u32x4(0x0F0F0F0F);
+                const vu32x4 t = reinterpret<vu32x4>(x);
+                const vi8x16 il = reinterpret<vi8x16>(t & mask);
+                const vi8x16 ih = reinterpret<vi8x16>(masked_not(mask, t) >> 4);
+                const vu8x16 lo = byte_shuffle_128(tl, il);
+                const vu8x16 hi = byte_shuffle_128(th, ih);
+                return lo ^ hi;
+            }
+
+            struct v32
+            {
+                vu8x16 x0, x1, x2, x3;
+            };
+
+            struct v64
+            {
+                v32 l, r;
+            };
+
+            struct v128
+            {
+                v64 l, r;
+            };
+
+            using key64 = uint64_t;
+
+            ARKXMM_API operator ^=(v32& lhs, v32 rhs) noexcept -> v32&
+            {
+                lhs.x0 ^= rhs.x0;
+                lhs.x1 ^= rhs.x1;
+                lhs.x2 ^= rhs.x2;
+                lhs.x3 ^= rhs.x3;
+                return lhs;
+            }
+
+            ARKXMM_API operator ^=(v32& lhs, vu8x16 rhs) noexcept -> v32&
+            {
+                lhs.x0 ^= rhs;
+                lhs.x1 ^= rhs;
+                lhs.x2 ^= rhs;
+                lhs.x3 ^= rhs;
+                return lhs;
+            }
+
+            ARKXMM_API rotl_be1(v32 v) noexcept -> v32
+            {
+                using namespace xmm;
+                auto ze = zero<vi8x16>();
+                auto msb0 = reinterpret<vu8x16>(abs(reinterpret<vi8x16>(v.x0) < ze)); // x0 >> 7 // msb
+                auto msb1 = reinterpret<vu8x16>(abs(reinterpret<vi8x16>(v.x1) < ze)); // x1 >> 7
+                auto msb2 = reinterpret<vu8x16>(abs(reinterpret<vi8x16>(v.x2) < ze)); // x2 >> 7
+                auto msb3 = reinterpret<vu8x16>(abs(reinterpret<vi8x16>(v.x3) < ze)); // x3 >> 7 // lsb
+                v.x0 = (v.x0 + v.x0) | msb1;                                          // x0 << 1 | x3 >> 7
+                v.x1 = (v.x1 + v.x1) | msb2;                                          // x1 << 1 | x0 >> 7
+                v.x2 = (v.x2 + v.x2) | msb3;                                          // x2 << 1 | x1 >> 7
+                v.x3 = (v.x3 + v.x3) | msb0;                                          // x3 << 1 | x2 >> 7
+                return v;
+            }
+
+            ARKXMM_API camellia_sp(v64& v) -> v64&
+            {
+                // s
+                const vu8x16 tf0l = u8x16(0x45, 0xe8, 0x40, 0xed, 0x2e, 0x83, 0x2b, 0x86, 0x4b, 0xe6, 0x4e, 0xe3, 0x20, 0x8d, 0x25, 0x88);
+                const vu8x16 tf0h = u8x16(0x00, 0x51, 0xf1, 0xa0, 0x8a, 0xdb, 0x7b, 0x2a, 0x09, 0x58, 0xf8, 0xa9, 0x83, 0xd2, 0x72, 0x23);
+                const vu8x16 tf1l = u8x16(0x45, 0x40, 0x2e, 0x2b, 0x4b, 0x4e, 0x20, 0x25, 0x14, 0x11, 0x7f, 0x7a, 0x1a, 0x1f, 0x71, 0x74);
+                const vu8x16 tf1h = u8x16(0x00, 0xf1, 0x8a, 0x7b, 0x09, 0xf8, 0x83, 0x72, 0xad, 0x5c, 0x27, 0xd6, 0xa4, 0x55, 0x2e, 0xdf);
+                const vu8x16 ts0l = u8x16(0x3c, 0xcc, 0xcf, 0x3f, 0x32, 0xc2, 0xc1, 0x31, 0xdc, 0x2c, 0x2f, 0xdf, 0xd2, 0x22, 0x21, 0xd1);
+                const vu8x16 ts0h = u8x16(0x00, 0xf9, 0x86, 0x7f, 0xd7, 0x2e, 0x51, 0xa8, 0xa4, 0x5d, 0x22, 0xdb, 0x73, 0x8a, 0xf5, 0x0c);
+                const vu8x16 ts1l = u8x16(0x78, 0x99, 0x9f, 0x7e, 0x64, 0x85, 0x83, 0x62, 0xb9, 0x58, 0x5e, 0xbf, 0xa5, 0x44, 0x42, 0xa3);
+                const vu8x16 ts1h = u8x16(0x00, 0xf3, 0x0d, 0xfe, 0xaf, 0x5c, 0xa2, 0x51, 0x49, 0xba, 0x44, 0xb7, 0xe6, 0x15, 0xeb, 0x18);
+                const vu8x16 ts7l = u8x16(0x1e, 0x66, 0xe7, 0x9f, 0x19, 0x61, 0xe0, 0x98, 0x6e, 0x16, 0x97, 0xef, 0x69, 0x11, 0x90, 0xe8);
+                const vu8x16 ts7h = u8x16(0x00, 0xfc, 0x43, 0xbf, 0xeb, 0x17, 0xa8, 0x54, 0x52, 0xae, 0x11, 0xed, 0xb9, 0x45, 0xfa, 0x06);
+                v.l.x0 = filter_8bit(aes_sub_bytes(filter_8bit(v.l.x0, tf0l, tf0h)), ts0l, ts0h); // SBox0
+                v.l.x1 = filter_8bit(aes_sub_bytes(filter_8bit(v.l.x1, tf0l, tf0h)), ts1l, ts1h); // SBox1
+                v.l.x2 = filter_8bit(aes_sub_bytes(filter_8bit(v.l.x2, tf0l, tf0h)), ts7l, ts7h); // SBox2
+                v.l.x3 = filter_8bit(aes_sub_bytes(filter_8bit(v.l.x3, tf1l, tf1h)), ts0l, ts0h); // SBox3
+                v.r.x0 = filter_8bit(aes_sub_bytes(filter_8bit(v.r.x0, tf0l, tf0h)), ts1l, ts1h); // SBox1
+                v.r.x1 = filter_8bit(aes_sub_bytes(filter_8bit(v.r.x1, tf0l, tf0h)), ts7l, ts7h); // SBox2
+                v.r.x2 = filter_8bit(aes_sub_bytes(filter_8bit(v.r.x2, tf1l, tf1h)), ts0l, ts0h); // SBox3
+                v.r.x3 = filter_8bit(aes_sub_bytes(filter_8bit(v.r.x3, tf0l, tf0h)), ts0l, ts0h); // SBox0
+
+                // p
+                v.l.x0 ^= v.r.x1;
+                v.l.x1 ^= v.r.x2;
+                v.l.x2 ^= v.r.x3;
+                v.l.x3 ^= v.r.x0;
+                v.r.x0 ^= v.l.x2;
+                v.r.x1 ^= v.l.x3;
+                v.r.x2 ^= v.l.x0;
+                v.r.x3 ^= v.l.x1;
+                v.l.x0 ^= v.r.x3;
+                v.l.x1 ^= v.r.x0;
+                v.l.x2 ^= v.r.x1;
+                v.l.x3 ^= v.r.x2;
+                v.r.x0 ^= v.l.x3;
+                v.r.x1 ^= v.l.x0;
+                v.r.x2 ^= v.l.x1;
+                v.r.x3 ^= v.l.x2;
+
+                return v;
+            }
+
+            ARKXMM_API camellia_f(v64& l, const v64& r, const key64& k) -> v64&
+            {
+                auto v = r;
+
+                // k
+                const vi8x16 ze = zero<vi8x16>();
+                const vu64x2 kx = u64x2(k);
+                v.l.x0 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 0 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 0 * 8));
+                v.l.x1 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 1 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 1 * 8));
+                v.l.x2 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 2 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 2 * 8));
+                v.l.x3 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 3 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 3 * 8));
+                v.r.x0 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 4 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 4 * 8));
+                v.r.x1 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 5 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 5 * 8));
+                v.r.x2 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 6 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 6 * 8));
+                v.r.x3 ^= reinterpret<vu8x16>(byte_shuffle_128(kx >> 7 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 7 * 8));
+
+                // s, p
+                v = camellia_sp(v);
+
+                // store
+                l.l ^= v.r;
+                l.r ^= v.l;
+
+                return l;
+            }
+
+            ARKXMM_API camellia_fl(v64& l, const key64& k) -> v64&
+            {
+                v32 v = l.l;
+
+                const vi8x16 ze = zero<vi8x16>();
+                const vu64x2 kx = u64x2(k);
+
+                v.x0 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 0 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 0 * 8));
+                v.x1 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 1 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 1 * 8));
+                v.x2 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 2 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 2 * 8));
+                v.x3 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 3 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 3 * 8));
+                v = rotl_be1(v);
+                v = l.r ^= v;
+
+                v.x0 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 4 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 4 * 8));
+                v.x1 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 5 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 5 * 8));
+                v.x2 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 6 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 6 * 8));
+                v.x3 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 7 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 7 * 8));
+                v = l.l ^= v;
+
+                return l;
+            }
+
+            ARKXMM_API camellia_fl_inv(v64& r, const key64& k) -> v64&
+            {
+                v32 v = r.r;
+
+                const vi8x16 ze = zero<vi8x16>();
+                const vu64x2 kx = u64x2(k);
+
+                v.x0 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 4 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 4 * 8));
+                v.x1 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 5 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 5 * 8));
+                v.x2 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 6 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 6 * 8));
+                v.x3 |= reinterpret<vu8x16>(byte_shuffle_128(kx >> 7 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 7 * 8));
+                v = r.l ^= v;
+
+                v.x0 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 0 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 0 * 8));
+                v.x1 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 1 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 1 * 8));
+                v.x2 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 2 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 2 * 8));
+                v.x3 &= reinterpret<vu8x16>(byte_shuffle_128(kx >> 3 * 8, ze)); // u8x16(static_cast<uint8_t>(k >> 3 * 8));
+                v = rotl_be1(v);
+                v = r.r ^= v;
+
+                return r;
+            }
+
+            ARKXMM_API camellia_prewhite(v128& block, const key64& kl, const key64& kr) -> v128&
+            {
+                const vu8x16 kx = reinterpret<vu8x16>(u64x2(kl, kr));
+
+                block.l.l ^= kx;
+                block.l.r ^= kx;
+                block.r.l ^= kx;
+                block.r.r ^= kx;
+
+                byte_slice_16x16(
+                    block.l.l.x0, block.l.l.x1, block.l.l.x2, block.l.l.x3,
+                    block.l.r.x0, block.l.r.x1, block.l.r.x2, block.l.r.x3,
+                    block.r.l.x0, block.r.l.x1, block.r.l.x2, block.r.l.x3,
+                    block.r.r.x0, block.r.r.x1, block.r.r.x2, block.r.r.x3);
+
+                return block;
+            }
+
+            ARKXMM_API camellia_postwhite(v128& block, const key64& kl, const key64& kr) -> v128&
+            {
+                const vu8x16 kx = reinterpret<vu8x16>(u64x2(kl, kr));
+
+                byte_slice_16x16(
+                    block.r.l.x0, block.r.r.x0, block.l.l.x0, block.l.r.x0,
+                    block.r.l.x1, block.r.r.x1, block.l.l.x1, block.l.r.x1,
+                    block.r.l.x2, block.r.r.x2, block.l.l.x2, block.l.r.x2,
+                    block.r.l.x3, block.r.r.x3, block.l.l.x3, block.l.r.x3);
+
+                block.l.l ^= kx;
+                block.l.r ^= kx;
+                block.r.l ^= kx;
+                block.r.r ^= kx;
+                return block;
+            }
+
+            ARKXMM_API camellia_thruwhite(v128& block, const key64&, const key64&) -> v128&
+            {
+                return block;
+            }
+
+            ARKXMM_API load_v128(const v128* src) -> v128
+            {
+                return v128{
+                    {
+                        {
+                            xmm::load_u<vu8x16>(&src->l.l.x0),
+                            xmm::load_u<vu8x16>(&src->l.l.x1),
+                            xmm::load_u<vu8x16>(&src->l.l.x2),
+                            xmm::load_u<vu8x16>(&src->l.l.x3)
+                        },
+                        {
+                            xmm::load_u<vu8x16>(&src->l.r.x0),
+                            xmm::load_u<vu8x16>(&src->l.r.x1),
+                            xmm::load_u<vu8x16>(&src->l.r.x2),
+                            xmm::load_u<vu8x16>(&src->l.r.x3)
+                        },
+                    },
+                    {
+                        {
+                            xmm::load_u<vu8x16>(&src->r.l.x0),
+                            xmm::load_u<vu8x16>(&src->r.l.x1),
+                            xmm::load_u<vu8x16>(&src->r.l.x2),
+                            xmm::load_u<vu8x16>(&src->r.l.x3)
+                        },
+                        {
+                            xmm::load_u<vu8x16>(&src->r.r.x0),
+                            xmm::load_u<vu8x16>(&src->r.r.x1),
+                            xmm::load_u<vu8x16>(&src->r.r.x2),
+                            xmm::load_u<vu8x16>(&src->r.r.x3)
+                        },
+                    }
+                };
+            }
+
+            ARKXMM_API store_v128(v128* dst, const v128& reg)
+            {
+                xmm::store_u<vu8x16>(&dst->l.l.x0, reg.l.l.x0);
+                xmm::store_u<vu8x16>(&dst->l.l.x1, reg.l.l.x1);
+                xmm::store_u<vu8x16>(&dst->l.l.x2, reg.l.l.x2);
+                xmm::store_u<vu8x16>(&dst->l.l.x3, reg.l.l.x3);
+                xmm::store_u<vu8x16>(&dst->l.r.x0, reg.l.r.x0);
+                xmm::store_u<vu8x16>(&dst->l.r.x1, reg.l.r.x1);
+                xmm::store_u<vu8x16>(&dst->l.r.x2, reg.l.r.x2);
+                xmm::store_u<vu8x16>(&dst->l.r.x3, reg.l.r.x3);
+                xmm::store_u<vu8x16>(&dst->r.l.x0, reg.r.l.x0);
+                xmm::store_u<vu8x16>(&dst->r.l.x1, reg.r.l.x1);
+                xmm::store_u<vu8x16>(&dst->r.l.x2, reg.r.l.x2);
+                xmm::store_u<vu8x16>(&dst->r.l.x3, reg.r.l.x3);
+                xmm::store_u<vu8x16>(&dst->r.r.x0, reg.r.r.x0);
+                xmm::store_u<vu8x16>(&dst->r.r.x1, reg.r.r.x1);
+                xmm::store_u<vu8x16>(&dst->r.r.x2, reg.r.r.x2);
+                xmm::store_u<vu8x16>(&dst->r.r.x3, reg.r.r.x3);
+            }
+
+            ARKXMM_API swap_xor128(v128& v, const v128& k) -> v128&
+            {
+                v.r.l ^= k.l.l;
+                v.r.r ^= k.l.r;
+                v.l.l ^= k.r.l;
+                v.l.r ^= k.r.r;
+                return v;
+            }
+
+            ARKXMM_API swap_store_v128(v128* dst, const v128& reg)
+            {
+                xmm::store_u<vu8x16>(&dst->l.l.x0, reg.r.l.x0);
+                xmm::store_u<vu8x16>(&dst->l.l.x1, reg.r.l.x1);
+                xmm::store_u<vu8x16>(&dst->l.l.x2, reg.r.l.x2);
+                xmm::store_u<vu8x16>(&dst->l.l.x3, reg.r.l.x3);
+                xmm::store_u<vu8x16>(&dst->l.r.x0, reg.r.r.x0);
+                xmm::store_u<vu8x16>(&dst->l.r.x1, reg.r.r.x1);
+                xmm::store_u<vu8x16>(&dst->l.r.x2, reg.r.r.x2);
+                xmm::store_u<vu8x16>(&dst->l.r.x3, reg.r.r.x3);
+                xmm::store_u<vu8x16>(&dst->r.l.x0, reg.l.l.x0);
+                xmm::store_u<vu8x16>(&dst->r.l.x1, reg.l.l.x1);
+                xmm::store_u<vu8x16>(&dst->r.l.x2, reg.l.l.x2);
+                xmm::store_u<vu8x16>(&dst->r.l.x3, reg.l.l.x3);
+                xmm::store_u<vu8x16>(&dst->r.r.x0, reg.l.r.x0);
+                xmm::store_u<vu8x16>(&dst->r.r.x1, reg.l.r.x1);
+                xmm::store_u<vu8x16>(&dst->r.r.x2, reg.l.r.x2);
+                xmm::store_u<vu8x16>(&dst->r.r.x3, reg.l.r.x3);
+            }
+
+            // xts-mode: multiplies the tweak of a lane (an XMM) by alpha^(8 * bytes).
+            template <int bytes>
+            ARKXMM_API xts_multiply_alpha_bytes(vu8x16 t) -> vu8x16
+            {
+                static_assert(bytes > 0 && bytes <= 4);
+                const vu64x2 v = reinterpret<vu64x2>(t);
+                const vu64x2 o = byte_shift_r_128<16 - bytes>(v); // overflowed bits (< 2^32)
+                return reinterpret<vu8x16>(byte_shift_l_128<bytes>(v) ^ o ^ o << 1 ^ o << 2 ^ o << 7); // x^128 = x^7 + x^2 + x + 1
+            }
+
+            // xts-mode: advances the tweaks of 16 lanes by 16 blocks (t *= alpha^16).
+            ARKXMM_API xts_next_tweak(v128& t) -> v128&
+            {
+                t.l.l.x0 = xts_multiply_alpha_bytes<2>(t.l.l.x0);
+                t.l.l.x1 = xts_multiply_alpha_bytes<2>(t.l.l.x1);
+                t.l.l.x2 = xts_multiply_alpha_bytes<2>(t.l.l.x2);
+                t.l.l.x3 = xts_multiply_alpha_bytes<2>(t.l.l.x3);
+                t.l.r.x0 = xts_multiply_alpha_bytes<2>(t.l.r.x0);
+                t.l.r.x1 = xts_multiply_alpha_bytes<2>(t.l.r.x1);
+                t.l.r.x2 = xts_multiply_alpha_bytes<2>(t.l.r.x2);
+                t.l.r.x3 = xts_multiply_alpha_bytes<2>(t.l.r.x3);
+                t.r.l.x0 = xts_multiply_alpha_bytes<2>(t.r.l.x0);
+                t.r.l.x1 = xts_multiply_alpha_bytes<2>(t.r.l.x1);
+                t.r.l.x2 = xts_multiply_alpha_bytes<2>(t.r.l.x2);
+                t.r.l.x3 = xts_multiply_alpha_bytes<2>(t.r.l.x3);
+                t.r.r.x0 = xts_multiply_alpha_bytes<2>(t.r.r.x0);
+                t.r.r.x1 = xts_multiply_alpha_bytes<2>(t.r.r.x1);
+                t.r.r.x2 = xts_multiply_alpha_bytes<2>(t.r.r.x2);
+                t.r.r.x3 = xts_multiply_alpha_bytes<2>(t.r.r.x3);
+                return t;
+            }
+
+            // per-lane keys
+            //   Each subkey is held as a byte-sliced v64, so that every lane (block) of a batch has its own key.
+
+            ARKXMM_API operator ^=(v64& lhs, const v64& rhs) noexcept -> v64&
+            {
+                lhs.l ^= rhs.l;
+                lhs.r ^= rhs.r;
+                return lhs;
+            }
+
+            ARKXMM_API camellia_f_per_lane(v64& l, const v64& r, const v64& k) -> v64&
+            {
+                auto v = r;
+                v ^= k;
+                v = camellia_sp(v);
+                l.l ^= v.r;
+                l.r ^= v.l;
+                return l;
+            }
+
+            ARKXMM_API camellia_fl_per_lane(v64& l, const v64& k) -> v64&
+            {
+                v32 v = l.l;
+                v.x0 &= k.l.x0;
+                v.x1 &= k.l.x1;
+                v.x2 &= k.l.x2;
+                v.x3 &= k.l.x3;
+                v = rotl_be1(v);
+                v = l.r ^= v;
+
+                v.x0 |= k.r.x0;
+                v.x1 |= k.r.x1;
+                v.x2 |= k.r.x2;
+                v.x3 |= k.r.x3;
+                v = l.l ^= v;
+                return l;
+            }
+
+            ARKXMM_API camellia_fl_inv_per_lane(v64& r, const v64& k) -> v64&
+            {
+                v32 v = r.r;
+                v.x0 |= k.r.x0;
+                v.x1 |= k.r.x1;
+                v.x2 |= k.r.x2;
+                v.x3 |= k.r.x3;
+                v = r.l ^= v;
+
+                v.x0 &= k.l.x0;
+                v.x1 &= k.l.x1;
+                v.x2 &= k.l.x2;
+                v.x3 &= k.l.x3;
+                v = rotl_be1(v);
+                v = r.r ^= v;
+                return r;
+            }
+
+            ARKXMM_API camellia_prewhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                byte_slice_16x16(
+                    block.l.l.x0, block.l.l.x1, block.l.l.x2, block.l.l.x3,
+                    block.l.r.x0, block.l.r.x1, block.l.r.x2, block.l.r.x3,
+                    block.r.l.x0, block.r.l.x1, block.r.l.x2, block.r.l.x3,
+                    block.r.r.x0, block.r.r.x1, block.r.r.x2, block.r.r.x3);
+
+                block.l ^= kl;
+                block.r ^= kr;
+                return block;
+            }
+
+            ARKXMM_API camellia_postwhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                block.r ^= kl;
+                block.l ^= kr;
+
+                byte_slice_16x16(
+                    block.r.l.x0, block.r.r.x0, block.l.l.x0, block.l.r.x0,
+                    block.r.l.x1, block.r.r.x1, block.l.l.x1, block.l.r.x1,
+                    block.r.l.x2, block.r.r.x2, block.l.l.x2, block.l.r.x2,
+                    block.r.l.x3, block.r.r.x3, block.l.l.x3, block.l.r.x3);
+                return block;
+            }
+
+            // Slices 16 key vectors into a per-lane key vector. lane[i] is the key vector of i-th block of a batch.
+            template <class lane_key_vector_t, class key_vector_t>
+            static inline void slice_key_vectors(lane_key_vector_t& dst, const key_vector_t* const (&lane)[lane_count]) noexcept
+            {
+                // a key vector is a sequence of 128-bit subkey pairs {kw_1, kw_2}, {k_1, k_2}, ..., which are sliced as blocks are.
+                constexpr size_t pair_count = sizeof(key_vector_t) / sizeof(key64[2]);
+                static_assert(sizeof(lane_key_vector_t) == sizeof(v128) * pair_count);
+
+                for (size_t p = 0; p < pair_count; p++)
+                {
+                    std::array<byte_array<16>, lane_count> buf;
+                    for (size_t i = 0; i < lane_count; i++)
+                        memcpy(&buf[i], reinterpret_cast<const byte_t*>(lane[i]) + p * 16, 16);
+
+                    v128 v = load_v128(reinterpret_cast<const v128*>(buf.data()));
+                    byte_slice_16x16(
+                        v.l.l.x0, v.l.l.x1, v.l.l.x2, v.l.l.x3,
+                        v.l.r.x0, v.l.r.x1, v.l.r.x2, v.l.r.x3,
+                        v.r.l.x0, v.r.l.x1, v.r.l.x2, v.r.l.x3,
+                        v.r.r.x0, v.r.r.x1, v.r.r.x2, v.r.r.x3);
+                    reinterpret_cast<v128*>(&dst)[p] = v;
+                }
+            }
+
+            // pre-broadcast keys (see avx2aesni)
+
+            template <class key_vector_t>
+            using expanded_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+            template <class key_vector_t>
+            static inline auto expand_key_vector(const key_vector_t& kv) noexcept -> expanded_key_vector_t<key_vector_t>
+            {
+                // slicing identical lanes (see slice_key_vectors) leaves byte j of a subkey pair broadcast in register j,
+                // so the layout is built by broadcasts directly instead of transposing 16 copies.
+                constexpr size_t pair_count = sizeof(key_vector_t) / sizeof(key64[2]);
+                static_assert(sizeof(expanded_key_vector_t<key_vector_t>) == sizeof(v128) * pair_count);
+                static_assert(sizeof(v128) == sizeof(vu8x16) * 16);
+
+                expanded_key_vector_t<key_vector_t> ekv;
+                for (size_t p = 0; p < pair_count; p++)
+                {
+                    const auto* pair = reinterpret_cast<const uint8_t*>(&kv) + p * 16;
+                    auto* dst = reinterpret_cast<vu8x16*>(reinterpret_cast<v128*>(&ekv) + p);
+                    for (size_t j = 0; j < 16; j++) dst[j] = u8x16(pair[j]);
+                }
+                return ekv;
+            }
+
+            // prewhitening for byte-sliced input (ctr-mode)
+            ARKXMM_API camellia_sliced_prewhite_per_lane(v128& block, const v64& kl, const v64& kr) -> v128&
+            {
+                block.l ^= kl;
+                block.r ^= kr;
+                return block;
+            }
+        }
+
+        using ref::key_vector_small_t;
+        using ref::key_vector_large_t;
+
+        namespace impl
+        {
+            using ref::impl::key_vector_small_t;
+            using ref::impl::key_vector_large_t;
+            using ref::impl::generate_key_vector;
+
+            using expanded_key_vector_small_t = expanded_key_vector_t<key_vector_small_t>;
+            using expanded_key_vector_large_t = expanded_key_vector_t<key_vector_large_t>;
+
+            // rfc3713 ecb-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_t& kv)
+            {
+                using namespace functions;
+                ecb_mode::process_blocks_ecb<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    swap_store_v128>(dst, src, length, kv);
+            }
+
+            // rfc3713 ecb-mode with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_t& ekv)
+            {
+                using namespace functions;
+                ecb_mode::process_blocks_ecb<
+                    v128,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128>(dst, src, length, ekv);
+            }
+
+            using ref::impl::cbc_iv_t;
+
+            // cbc-mode decryption
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& kv, cbc_iv_t& iv)
+            {
+                using namespace functions;
+                cbc_mode::process_blocks_cbc_decrypt<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    swap_xor128,
+                    store_v128>(dst, src, length, kv, iv);
+            }
+
+            // cbc-mode decryption with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_t& ekv, cbc_iv_t& iv)
+            {
+                using namespace functions;
+                cbc_mode::process_blocks_cbc_decrypt<
+                    v128,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_xor128,
+                    store_v128>(dst, src, length, ekv, iv);
+            }
+
+            using ref::impl::cbc_encrypt_job_t;
+
+            // multi-stream cbc-mode encryption: 16 jobs (lanes) at once
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_t>* jobs, size_t count)
+            {
+                using lane_key_vector_t = functions::rebind_key_vector_t<key_vector_t, v64>;
+
+                using namespace functions;
+                cbc_mode::process_cbc_encrypt_jobs<
+                    v128,
+                    lane_key_vector_t,
+                    slice_key_vectors<lane_key_vector_t, key_vector_t>,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    swap_store_v128,
+                    4, // a 16-block batch costs about 4 serial blocks.
+                    ref::impl::process_cbc_encrypt_jobs<key_vector_t>>(jobs, count);
+            }
+
+            using ref::impl::ctr_iv_t;
+            using ref::impl::ctr_nonce_t;
+            using ref::impl::ctr_vector_t;
+            using ref::impl::generate_rfc5528_ctr_vector;
+            using functions::is_ctr_generator_v;
+
+            // rfc5528 counter blocks generator: returns byte-sliced 16 counter blocks of index-th batch.
+            static inline auto rfc5528_ctr_generator(const ctr_vector_t& ctr0) noexcept
+            {
+                return [ctr0](size_t index) -> v128
+                {
+                    const auto ze = zero<vi8x16>();
+
+                    v32 ctr{
+                        u8x16(static_cast<uint8_t>((index * 16) >> 24)),
+                        u8x16(static_cast<uint8_t>((index * 16) >> 16)),
+                        u8x16(static_cast<uint8_t>((index * 16) >> 8)),
+                        u8x16(static_cast<uint8_t>((index * 16) >> 0)),
+                    };
+
+                    ctr.x3 += u8x16(1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 4, 8, 12, 16);
+                    vu8x16 cf = reinterpret<vu8x16>(abs(reinterpret<vi8x16>(ctr.x3) == ze));
+                    ctr.x2 += cf;
+                    cf &= reinterpret<vu8x16>(abs(reinterpret<vi8x16>(ctr.x2) == ze));
+                    ctr.x1 += cf;
+                    cf &= reinterpret<vu8x16>(abs(reinterpret<vi8x16>(ctr.x1) == ze));
+                    ctr.x0 += cf;
+
+                    v128 v{};
+                    v.l.l.x0 = u8x16(static_cast<uint8_t>(ctr0.n >> 0 * 8));
+                    v.l.l.x1 = u8x16(static_cast<uint8_t>(ctr0.n >> 1 * 8));
+                    v.l.l.x2 = u8x16(static_cast<uint8_t>(ctr0.n >> 2 * 8));
+                    v.l.l.x3 = u8x16(static_cast<uint8_t>(ctr0.n >> 3 * 8));
+                    v.l.r.x0 = u8x16(static_cast<uint8_t>(ctr0.ivl >> 0 * 8));
+                    v.l.r.x1 = u8x16(static_cast<uint8_t>(ctr0.ivl >> 1 * 8));
+                    v.l.r.x2 = u8x16(static_cast<uint8_t>(ctr0.ivl >> 2 * 8));
+                    v.l.r.x3 = u8x16(static_cast<uint8_t>(ctr0.ivl >> 3 * 8));
+                    v.r.l.x0 = u8x16(static_cast<uint8_t>(ctr0.ivr >> 0 * 8));
+                    v.r.l.x1 = u8x16(static_cast<uint8_t>(ctr0.ivr >> 1 * 8));
+                    v.r.l.x2 = u8x16(static_cast<uint8_t>(ctr0.ivr >> 2 * 8));
+                    v.r.l.x3 = u8x16(static_cast<uint8_t>(ctr0.ivr >> 3 * 8));
+                    v.r.r.x0 = u8x16(static_cast<uint8_t>(ctr0.ctr >> 0 * 8)) ^ ctr.x0; // prewhitening
+                    v.r.r.x1 = u8x16(static_cast<uint8_t>(ctr0.ctr >> 1 * 8)) ^ ctr.x1; // prewhitening
+                    v.r.r.x2 = u8x16(static_cast<uint8_t>(ctr0.ctr >> 2 * 8)) ^ ctr.x2; // prewhitening
+                    v.r.r.x3 = u8x16(static_cast<uint8_t>(ctr0.ctr >> 3 * 8)) ^ ctr.x3; // prewhitening
+                    return v;
+                };
+            }
+
+            // built-in layout counter blocks generator: returns byte-sliced 16 counter blocks of index-th batch, xored with `white`.
+            //   the batch head counter and its carry into the second byte are computed once in scalar,
+            //   then each lane adds its block offset to the lowest byte and picks the upper bytes by its carry.
+            template <class ctr_layout_t>
+            static inline auto layout_ctr_generator(const block_t& initial, const block_t& white) noexcept
+            {
+                return [initial, white](size_t index) -> v128
+                {
+                    const block_t lo = ctr_layout_t::add(initial, index * 16);
+                    const block_t hi = ctr_layout_t::add(lo, 256);
+                    const uint8_t lsb = static_cast<uint8_t>(lo[ctr_layout_t::lsb_index]);
+
+                    // block offset of each lane (in the byte-sliced order)
+                    const vi8x16 offset = i8x16(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+                    const vu8x16 carry = reinterpret<vu8x16>(offset > i8x16(static_cast<int8_t>(std::min(255 - lsb, 127))));
+
+                    std::array<vu8x16, 16> x;
+                    for (size_t k = 0; k < 16; k++)
+                        x[k] = blend(u8x16(static_cast<uint8_t>(lo[k])), u8x16(static_cast<uint8_t>(hi[k])), carry);
+                    x[ctr_layout_t::lsb_index] = u8x16(lsb) + reinterpret<vu8x16>(offset);
+
+                    for (size_t k = 0; k < 16; k++)
+                        x[k] ^= u8x16(static_cast<uint8_t>(white[k])); // prewhitening
+                    return bit::bit_cast<v128>(x);
+                };
+            }
+
+            // rfc5528 ctr-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv)
+            {
+                ctr_vector_t ctr0 = bit::load_u<ctr_vector_t>(&kv);
+                ctr0.n ^= cv.n;
+                ctr0.ivl ^= cv.ivl;
+                ctr0.ivr ^= cv.ivr;
+
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_thruwhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, kv, rfc5528_ctr_generator(ctr0));
+            }
+
+            // rfc5528 ctr-mode with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& ekv, const ctr_vector_t& cv)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_sliced_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, ekv, rfc5528_ctr_generator(cv));
+            }
+
+            // built-in layout ctr-mode
+            template <
+                class ctr_layout_t,
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_thruwhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, kv, layout_ctr_generator<ctr_layout_t>(initial, bit::load_u<block_t>(&kv)));
+            }
+
+            // built-in layout ctr-mode with pre-broadcast keys
+            template <
+                class ctr_layout_t,
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_t& ekv, const block_t& initial)
+            {
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_sliced_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, ekv, layout_ctr_generator<ctr_layout_t>(initial, block_t{}));
+            }
+
+            // custom ctr-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr,
+                class ctr_generator_t, std::enable_if_t<is_ctr_generator_v<ctr_generator_t>>* = nullptr>
+            static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, ctr_generator_t&& ctr)
+            {
+                using ctr_t = std::invoke_result_t<ctr_generator_t, size_t>;
+                static_assert(sizeof(ctr_t) == 16);
+                static_assert(std::is_trivially_copyable_v<ctr_t>);
+
+                using namespace functions;
+                ctr_mode::process_bytes_ctr<
+                    v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    load_v128,
+                    swap_xor128,
+                    store_v128>(dst, src, position, length, kv, [ctr = std::forward<decltype(ctr)>(ctr)](size_t index) -> v128
+                {
+                    std::array<ctr_t, lane_count> v;
+                    for (size_t i = 0; i < lane_count; i++)
+                        v[i] = ctr(index * lane_count + i);
+
+                    return load_v128(reinterpret_cast<v128*>(v.data()));
+                });
+            }
+
+            // ieee 1619 xts-mode
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, key_vector_small_t, key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& kv, const key_vector_t& tweak_kv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    load_v128,
+                    camellia_prewhite,
+                    camellia_f,
+                    camellia_fl,
+                    camellia_fl_inv,
+                    camellia_postwhite,
+                    xor_block<v128>,
+                    swap_xor128,
+                    store_v128,
+                    xts_next_tweak,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, kv, tweak_kv);
+            }
+
+            // ieee 1619 xts-mode with pre-broadcast keys
+            template <
+                class key_vector_t, std::enable_if_t<is_any_of_v<key_vector_t, expanded_key_vector_small_t, expanded_key_vector_large_t>>* = nullptr
+            >
+            static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_t& ekv, const key_vector_t& tweak_ekv)
+            {
+                using namespace functions;
+                xts_mode::process_sectors_xts<
+                    v128,
+                    load_v128,
+                    camellia_prewhite_per_lane,
+                    camellia_f_per_lane,
+                    camellia_fl_per_lane,
+                    camellia_fl_inv_per_lane,
+                    camellia_postwhite_per_lane,
+                    xor_block<v128>,
+                    swap_xor128,
+                    store_v128,
+                    xts_next_tweak,
+                    process_blocks_ecb<key_vector_t>>(dst, src, sector_index, sector_size, length, ekv, tweak_ekv);
+            }
+        }
+
+        using impl::key_vector_small_t;
+        using impl::key_vector_large_t;
+
+        static inline key_vector_small_t generate_key_vector_encrypt(const key_128bit_t& key) { return impl::generate_key_vector(key, true_t{}); }
+        static inline key_vector_large_t generate_key_vector_encrypt(const key_192bit_t& key) { return impl::generate_key_vector(key, true_t{}); }
+        static inline key_vector_large_t generate_key_vector_encrypt(const key_256bit_t& key) { return impl::generate_key_vector(key, true_t{}); }
+        static inline key_vector_small_t generate_key_vector_decrypt(const key_128bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline key_vector_large_t generate_key_vector_decrypt(const key_192bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline key_vector_large_t generate_key_vector_decrypt(const key_256bit_t& key) { return impl::generate_key_vector(key, false_t{}); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_small_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const key_vector_large_t& kv) { return impl::process_blocks_ecb(dst, src, length, kv); }
+
+        using impl::expanded_key_vector_small_t;
+        using impl::expanded_key_vector_large_t;
+
+        static inline expanded_key_vector_small_t expand_key_vector(const key_vector_small_t& kv) { return impl::expand_key_vector(kv); }
+        static inline expanded_key_vector_large_t expand_key_vector(const key_vector_large_t& kv) { return impl::expand_key_vector(kv); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const expanded_key_vector_small_t& ekv) { return impl::process_blocks_ecb(dst, src, length, ekv); }
+        static inline void process_blocks_ecb(void* dst, const void* src, size_t length, const expanded_key_vector_large_t& ekv) { return impl::process_blocks_ecb(dst, src, length, ekv); }
+
+        using impl::cbc_iv_t;
+
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, kv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const expanded_key_vector_small_t& ekv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, ekv, iv); }
+        static inline void process_blocks_cbc_decrypt(void* dst, const void* src, size_t length, const expanded_key_vector_large_t& ekv, cbc_iv_t& iv) { return impl::process_blocks_cbc_decrypt(dst, src, length, ekv, iv); }
+
+        using impl::cbc_encrypt_job_t;
+
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+        static inline void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count) { return impl::process_cbc_encrypt_jobs(jobs, count); }
+
+        using impl::ctr_iv_t;
+        using impl::ctr_nonce_t;
+        using impl::ctr_vector_t;
+
+        static inline ctr_vector_t generate_ctr_vector(const ctr_iv_t& ctr_iv, const ctr_nonce_t& ctr_nonce) { return impl::generate_rfc5528_ctr_vector(ctr_iv, ctr_nonce); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_small_t& ekv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, ekv, ctr); }
+        static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_large_t& ekv, const ctr_vector_t& ctr) { return impl::process_bytes_ctr(dst, src, position, length, ekv, ctr); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, kv, initial); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, kv, initial); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_small_t& ekv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, ekv, initial); }
+        template <class ctr_layout_t> static inline void process_bytes_ctr_layout(void* dst, const void* src, size_t position, size_t length, const expanded_key_vector_large_t& ekv, const block_t& initial) { return impl::process_bytes_ctr_layout<ctr_layout_t>(dst, src, position, length, ekv, initial); }
+        template <class custom_ctr_generator_t, std::enable_if_t<functions::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+        template <class custom_ctr_generator_t, std::enable_if_t<functions::is_ctr_generator_v<custom_ctr_generator_t>>* = nullptr> static inline void process_bytes_ctr(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, custom_ctr_generator_t&& ctr) { return impl::process_bytes_ctr(dst, src, position, length, kv, std::forward<custom_ctr_generator_t>(ctr)); }
+
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, kv, tweak_kv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const expanded_key_vector_small_t& ekv, const expanded_key_vector_small_t& tweak_ekv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, ekv, tweak_ekv); }
+        static inline void process_sectors_xts(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const expanded_key_vector_large_t& ekv, const expanded_key_vector_large_t& tweak_ekv) { return impl::process_sectors_xts(dst, src, sector_index, sector_size, length, ekv, tweak_ekv); }
+    }
+}
@@ -9,69 +9,1496 @@
 /// - camellia https://info.isl.ntt.co.jp/crypt/camellia/ 
 
 #include "./camellia.h"
+#include "../ark/intrinsics.h"
+#include "../ark/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace arkana::camellia
 {
+    // crossover points (see backend_thresholds_t), from measure_backend_thresholds() on two Xeons:
+    // sseaesni from 144 bytes and avx2aesni from 144-272 bytes on both (the larger one is taken).
+    // avx2 beats the BMI2 ia32 kernel from 80 bytes on one of them and never on the other (AVX-512/VAES),
+    // where routing 80-143 bytes to avx2 costs little, since sseaesni takes over from 144 bytes on aes-ni cpus.
+    static std::atomic<size_t> backend_threshold_avx2{80};
+    static std::atomic<size_t> backend_threshold_avx2aesni{272};
+    static std::atomic<size_t> backend_threshold_sseaesni{144};
+    // non-temporal stores are opt-in: over 256MB (CamelliaStreamingTest), ecb gains about 10% and ctr nothing.
+    static std::atomic<size_t> backend_threshold_streaming{SIZE_MAX};
+
+    // measured crossover point of the batched key scheduling (number of keys)
+    static constexpr size_t key_schedule_batch_threshold = 12;
+
+    void set_backend_thresholds(const backend_thresholds_t& thresholds)
+    {
+        backend_threshold_avx2.store(thresholds.avx2, std::memory_order_relaxed);
+        backend_threshold_avx2aesni.store(thresholds.avx2aesni, std::memory_order_relaxed);
+        backend_threshold_sseaesni.store(thresholds.sseaesni, std::memory_order_relaxed);
+        backend_threshold_streaming.store(thresholds.streaming, std::memory_order_relaxed);
+    }
+
+    backend_thresholds_t get_backend_thresholds()
+    {
+        return {
+            backend_threshold_avx2.load(std::memory_order_relaxed),
+            backend_threshold_avx2aesni.load(std::memory_order_relaxed),
+            backend_threshold_sseaesni.load(std::memory_order_relaxed),
+            backend_threshold_streaming.load(std::memory_order_relaxed),
+        };
+    }
+
+    // seconds per call to process `length` bytes (one round of ~32KB)
+    static double measure_ecb_seconds(ecb_context_t* context, std::byte* buffer, size_t length)
+    {
+        const size_t repeat = std::max<size_t>(32768 / length, 1);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repeat; i++) context->process_blocks(buffer, buffer, length);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(repeat);
+    }
+
+    backend_thresholds_t measure_backend_thresholds()
+    {
+        constexpr size_t max_length = 1024;
+        constexpr size_t steps = max_length / 16;
+        const key_128bit_t key{};
+        std::vector<std::byte> buffer(max_length);
+
+        // in the order of the routing priority (ia32 < avx2 < sseaesni < avx2aesni)
+        const std::unique_ptr<ecb_context_t> contexts[] = {
+            create_ecb_encrypt_context_ia32(&key),
+            cpu_supports_avx2() ? create_ecb_encrypt_context_avx2(&key) : nullptr,
+            cpu_supports_sseaesni() ? create_ecb_encrypt_context_sseaesni(&key) : nullptr,
+            cpu_supports_avx2aesni() ? create_ecb_encrypt_context_avx2aesni(&key) : nullptr,
+        };
+
+        // seconds[b][i]: backend b processing 16 * (i + 1) bytes (HUGE_VAL: not available)
+        //   the best of 7 rounds, each sweeping all lengths, so that a noisy period does not bias a single length.
+        std::vector<double> seconds[std::size(contexts)];
+        for (auto& s : seconds) s.assign(steps, HUGE_VAL);
+        for (int round = 0; round < 7; round++)
+            for (size_t i = 0; i < steps; i++)
+                for (size_t b = 0; b < std::size(contexts); b++)
+                    if (contexts[b]) seconds[b][i] = std::min(seconds[b][i], measure_ecb_seconds(contexts[b].get(), buffer.data(), 16 * (i + 1)));
+
+        // a backend takes over from the length which minimizes the total time over all the measured lengths,
+        // which is robust against noise and against the stepwise timings of the batch remainders.
+        size_t thresholds[std::size(contexts)]{};
+        for (size_t b = 1; b < std::size(contexts); b++)
+        {
+            thresholds[b] = SIZE_MAX;
+            if (!contexts[b]) continue;
+
+            double cost = 0; // taking over from 16 * (t + 1) bytes
+            for (size_t i = 0; i < steps; i++) cost += seconds[b][i];
+            double best_cost = cost;
+            size_t best_t = 0;
+            for (size_t t = 1; t <= steps; t++)
+            {
+                double preceding = HUGE_VAL;
+                for (size_t a = 0; a < b; a++) preceding = std::min(preceding, seconds[a][t - 1]);
+                cost += preceding - seconds[b][t - 1];
+                if (cost < best_cost) best_cost = cost, best_t = t;
+            }
+            if (best_t < steps) thresholds[b] = 16 * (best_t + 1);
+        }
+
+        return {thresholds[1], thresholds[3], thresholds[2], get_backend_thresholds().streaming};
+    }
+
+    // A backend context built on its first use. (thread-safe)
+    template <class context_t>
+    class lazy_backend_t final
+    {
+        std::once_flag once_;
+        std::unique_ptr<context_t> context_;
+
+    public:
+        template <class factory_t>
+        context_t* get(factory_t&& factory)
+        {
+            std::call_once(once_, [&] { context_ = factory(); });
+            return context_.get();
+        }
+    };
+
+    // Dispatches each call by its length (see backend_thresholds_t).
+    //   All backends share one key schedule: ia32 and avx2 run on it directly,
+    //   sseaesni and avx2aesni expand it into their own layouts (8.7KB for avx2aesni) on their first selection,
+    //   so that short-lived contexts only pay for the key schedule.
+    template <class key_vector_t>
+    static std::unique_ptr<ecb_context_t> make_routing_ecb_context(key_vector_t kv)
+    {
+        struct routing_ecb_context_impl_t final : public virtual ecb_context_t
+        {
+            const key_vector_t key_vector_;
+            const backend_thresholds_t thresholds_ = get_backend_thresholds();
+            const bool avx2aesni_ = cpu_supports_avx2aesni();
+            const bool sseaesni_ = cpu_supports_sseaesni();
+            const bool avx2_ = cpu_supports_avx2();
+            lazy_backend_t<ecb_context_t> avx2aesni_context_;
+            lazy_backend_t<ecb_context_t> sseaesni_context_;
+
+            explicit routing_ecb_context_impl_t(const key_vector_t& kv) : key_vector_(kv) { }
+            ~routing_ecb_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)); }
+
+            void process_blocks(void* dst, const void* src, size_t length) override
+            {
+                if (avx2aesni_ && length >= thresholds_.avx2aesni) return avx2aesni_context_.get([this] { return create_ecb_context_avx2aesni(key_vector_, thresholds_.streaming); })->process_blocks(dst, src, length);
+                if (sseaesni_ && length >= thresholds_.sseaesni) return sseaesni_context_.get([this] { return create_ecb_context_sseaesni(key_vector_); })->process_blocks(dst, src, length);
+                if (avx2_ && length >= thresholds_.avx2) return process_blocks_ecb_avx2(dst, src, length, key_vector_);
+                return process_blocks_ecb_ia32(dst, src, length, key_vector_);
+            }
+        };
+
+        return std::make_unique<routing_ecb_context_impl_t>(kv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<ctr_context_t> make_routing_ctr_context(key_vector_t kv, ctr_vector_t cv)
+    {
+        struct routing_ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const key_vector_t key_vector_;
+            const ctr_vector_t ctr_vector_;
+            const backend_thresholds_t thresholds_ = get_backend_thresholds();
+            const bool avx2aesni_ = cpu_supports_avx2aesni();
+            const bool sseaesni_ = cpu_supports_sseaesni();
+            const bool avx2_ = cpu_supports_avx2();
+            lazy_backend_t<ctr_context_t> avx2aesni_context_;
+            lazy_backend_t<ctr_context_t> sseaesni_context_;
+
+            explicit routing_ctr_context_impl_t(const key_vector_t& kv, const ctr_vector_t& cv) : key_vector_(kv), ctr_vector_(cv) { }
+            ~routing_ctr_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<ctr_vector_t&>(ctr_vector_)); }
+
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+            {
+                if (avx2aesni_ && length >= thresholds_.avx2aesni) return avx2aesni_context_.get([this] { return create_ctr_context_avx2aesni(key_vector_, ctr_vector_, thresholds_.streaming); })->process_bytes(dst, src, position, length);
+                if (sseaesni_ && length >= thresholds_.sseaesni) return sseaesni_context_.get([this] { return create_ctr_context_sseaesni(key_vector_, ctr_vector_); })->process_bytes(dst, src, position, length);
+                if (avx2_ && length >= thresholds_.avx2) return process_bytes_ctr_avx2(dst, src, position, length, key_vector_, ctr_vector_);
+                return process_bytes_ctr_ia32(dst, src, position, length, key_vector_, ctr_vector_);
+            }
+        };
+
+        return std::make_unique<routing_ctr_context_impl_t>(kv, cv);
+    }
+
+    template <class key_vector_t>
+    static std::unique_ptr<ctr_context_t> make_routing_ctr_context(key_vector_t kv, const block_t& initial, ctr_layout_t layout)
+    {
+        struct routing_ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const key_vector_t key_vector_;
+            const block_t initial_;
+            const ctr_layout_t layout_;
+            const backend_thresholds_t thresholds_ = get_backend_thresholds();
+            const bool avx2aesni_ = cpu_supports_avx2aesni();
+            const bool sseaesni_ = cpu_supports_sseaesni();
+            const bool avx2_ = cpu_supports_avx2();
+            lazy_backend_t<ctr_context_t> avx2aesni_context_;
+            lazy_backend_t<ctr_context_t> sseaesni_context_;
+
+            explicit routing_ctr_context_impl_t(const key_vector_t& kv, const block_t& initial, ctr_layout_t layout) : key_vector_(kv), initial_(initial), layout_(layout) { }
+            ~routing_ctr_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(const_cast<block_t&>(initial_)); }
+
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+            {
+                if (avx2aesni_ && length >= thresholds_.avx2aesni) return avx2aesni_context_.get([this] { return create_ctr_context_avx2aesni(key_vector_, &initial_, layout_); })->process_bytes(dst, src, position, length);
+                if (sseaesni_ && length >= thresholds_.sseaesni) return sseaesni_context_.get([this] { return create_ctr_context_sseaesni(key_vector_, &initial_, layout_); })->process_bytes(dst, src, position, length);
+                if (avx2_ && length >= thresholds_.avx2) return process_bytes_ctr_avx2(dst, src, position, length, key_vector_, initial_, layout_);
+                return process_bytes_ctr_ia32(dst, src, position, length, key_vector_, initial_, layout_);
+            }
+        };
+
+        return std::make_unique<routing_ctr_context_impl_t>(kv, initial, layout);
+    }
+
+    // a dispatching context is worth it only if there is a backend to dispatch to.
+    static bool backend_routing_enabled() noexcept { return cpu_supports_avx2() || cpu_supports_sseaesni(); }
+
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context(const key_128bit_t* key)
     {
-        if (cpu_supports_avx2aesni()) return create_ecb_encrypt_context_avx2aesni(key);
-        if (cpu_supports_avx2()) return create_ecb_encrypt_context_avx2(key);
+        if (backend_routing_enabled()) return make_routing_ecb_context(generate_key_vector_encrypt(key));
         return create_ecb_encrypt_context_ia32(key);
     }
 
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context(const key_192bit_t* key)
     {
-        if (cpu_supports_avx2aesni()) return create_ecb_encrypt_context_avx2aesni(key);
-        if (cpu_supports_avx2()) return create_ecb_encrypt_context_avx2(key);
+        if (backend_routing_enabled()) return make_routing_ecb_context(generate_key_vector_encrypt(key));
         return create_ecb_encrypt_context_ia32(key);
     }
 
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context(const key_256bit_t* key)
     {
-        if (cpu_supports_avx2aesni()) return create_ecb_encrypt_context_avx2aesni(key);
-        if (cpu_supports_avx2()) return create_ecb_encrypt_context_avx2(key);
+        if (backend_routing_enabled()) return make_routing_ecb_context(generate_key_vector_encrypt(key));
         return create_ecb_encrypt_context_ia32(key);
     }
 
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context(const key_128bit_t* key)
     {
-        if (cpu_supports_avx2aesni()) return create_ecb_decrypt_context_avx2aesni(key);
-        if (cpu_supports_avx2()) return create_ecb_decrypt_context_avx2(key);
+        if (backend_routing_enabled()) return make_routing_ecb_context(generate_key_vector_decrypt(key));
         return create_ecb_decrypt_context_ia32(key);
     }
 
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context(const key_192bit_t* key)
     {
-        if (cpu_supports_avx2aesni()) return create_ecb_decrypt_context_avx2aesni(key);
-        if (cpu_supports_avx2()) return create_ecb_decrypt_context_avx2(key);
+        if (backend_routing_enabled()) return make_routing_ecb_context(generate_key_vector_decrypt(key));
         return create_ecb_decrypt_context_ia32(key);
     }
 
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context(const key_256bit_t* key)
     {
-        if (cpu_supports_avx2aesni()) return create_ecb_decrypt_context_avx2aesni(key);
-        if (cpu_supports_avx2()) return create_ecb_decrypt_context_avx2(key);
+        if (backend_routing_enabled()) return make_routing_ecb_context(generate_key_vector_decrypt(key));
         return create_ecb_decrypt_context_ia32(key);
     }
 
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context(const key_128bit_t* key, const cbc_iv_t* iv)
+    {
+        if (cpu_supports_avx2aesni()) return create_cbc_decrypt_context_avx2aesni(key, iv);
+        if (cpu_supports_sseaesni()) return create_cbc_decrypt_context_sseaesni(key, iv);
+        if (cpu_supports_avx2()) return create_cbc_decrypt_context_avx2(key, iv);
+        return create_cbc_decrypt_context_ia32(key, iv);
+    }
+
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context(const key_192bit_t* key, const cbc_iv_t* iv)
+    {
+        if (cpu_supports_avx2aesni()) return create_cbc_decrypt_context_avx2aesni(key, iv);
+        if (cpu_supports_sseaesni()) return create_cbc_decrypt_context_sseaesni(key, iv);
+        if (cpu_supports_avx2()) return create_cbc_decrypt_context_avx2(key, iv);
+        return create_cbc_decrypt_context_ia32(key, iv);
+    }
+
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context(const key_256bit_t* key, const cbc_iv_t* iv)
+    {
+        if (cpu_supports_avx2aesni()) return create_cbc_decrypt_context_avx2aesni(key, iv);
+        if (cpu_supports_sseaesni()) return create_cbc_decrypt_context_sseaesni(key, iv);
+        if (cpu_supports_avx2()) return create_cbc_decrypt_context_avx2(key, iv);
+        return create_cbc_decrypt_context_ia32(key, iv);
+    }
+
+    template <class key_vector_t, class key_t>
+    static void generate_key_vectors_with(void (*batch)(key_vector_t*, const key_t* const*, size_t), key_vector_t (*single)(const key_t*), key_vector_t* dst, const key_t* const* keys, size_t count)
+    {
+        // a batch costs the same for any number of keys up to 32, so a short tail is scheduled one by one.
+        size_t batched = 0;
+        if (cpu_supports_avx2aesni())
+        {
+            batched = count / 32 * 32;
+            if (count - batched >= key_schedule_batch_threshold) batched = count;
+            batch(dst, keys, batched);
+        }
+
+        for (size_t i = batched; i < count; i++)
+            dst[i] = single(keys[i]);
+    }
+
+    void generate_key_vectors_encrypt(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count) { return generate_key_vectors_with<key_vector_small_t, key_128bit_t>(generate_key_vectors_encrypt_avx2aesni, generate_key_vector_encrypt, dst, keys, count); }
+    void generate_key_vectors_encrypt(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count) { return generate_key_vectors_with<key_vector_large_t, key_192bit_t>(generate_key_vectors_encrypt_avx2aesni, generate_key_vector_encrypt, dst, keys, count); }
+    void generate_key_vectors_encrypt(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count) { return generate_key_vectors_with<key_vector_large_t, key_256bit_t>(generate_key_vectors_encrypt_avx2aesni, generate_key_vector_encrypt, dst, keys, count); }
+    void generate_key_vectors_decrypt(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count) { return generate_key_vectors_with<key_vector_small_t, key_128bit_t>(generate_key_vectors_decrypt_avx2aesni, generate_key_vector_decrypt, dst, keys, count); }
+    void generate_key_vectors_decrypt(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count) { return generate_key_vectors_with<key_vector_large_t, key_192bit_t>(generate_key_vectors_decrypt_avx2aesni, generate_key_vector_decrypt, dst, keys, count); }
+    void generate_key_vectors_decrypt(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count) { return generate_key_vectors_with<key_vector_large_t, key_256bit_t>(generate_key_vectors_decrypt_avx2aesni, generate_key_vector_decrypt, dst, keys, count); }
+
+    template <class key_vector_t, class key_t>
+    static void process_cbc_encrypt_jobs_with_key_vectors(void (*process)(const cbc_encrypt_job_t<key_vector_t>*, size_t), const cbc_encrypt_job_t<key_t>* jobs, size_t count)
+    {
+        // check camellia block size.
+        for (size_t i = 0; i < count; i++)
+            if (jobs[i].length % 16 != 0)
+                throw std::invalid_argument("invalid length. length must be multiple of 16.");
+
+        std::vector<const key_t*> keys(count);
+        for (size_t i = 0; i < count; i++)
+            keys[i] = jobs[i].key;
+
+        std::vector<key_vector_t> key_vectors(count);
+        generate_key_vectors_encrypt(key_vectors.data(), keys.data(), count);
+
+        std::vector<cbc_encrypt_job_t<key_vector_t>> key_vector_jobs(count);
+        for (size_t i = 0; i < count; i++)
+            key_vector_jobs[i] = {&key_vectors[i], jobs[i].iv, jobs[i].dst, jobs[i].src, jobs[i].length};
+
+        process(key_vector_jobs.data(), count);
+
+        for (auto& kv : key_vectors)
+            bit::secure_be_zero(kv);
+    }
+
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_small_t>(process_cbc_encrypt_jobs_ia32, jobs, count); }
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_ia32, jobs, count); }
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_ia32, jobs, count); }
+
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_small_t>(process_cbc_encrypt_jobs_avx2, jobs, count); }
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_avx2, jobs, count); }
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_avx2, jobs, count); }
+
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_small_t>(process_cbc_encrypt_jobs_avx2aesni, jobs, count); }
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_avx2aesni, jobs, count); }
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_avx2aesni, jobs, count); }
+
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_small_t>(process_cbc_encrypt_jobs_sseaesni, jobs, count); }
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_sseaesni, jobs, count); }
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count) { return process_cbc_encrypt_jobs_with_key_vectors<key_vector_large_t>(process_cbc_encrypt_jobs_sseaesni, jobs, count); }
+
+    void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count)
+    {
+        if (cpu_supports_avx2aesni()) return process_cbc_encrypt_jobs_avx2aesni(jobs, count);
+        if (cpu_supports_sseaesni()) return process_cbc_encrypt_jobs_sseaesni(jobs, count);
+        if (cpu_supports_avx2()) return process_cbc_encrypt_jobs_avx2(jobs, count);
+        return process_cbc_encrypt_jobs_ia32(jobs, count);
+    }
+
+    void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count)
+    {
+        if (cpu_supports_avx2aesni()) return process_cbc_encrypt_jobs_avx2aesni(jobs, count);
+        if (cpu_supports_sseaesni()) return process_cbc_encrypt_jobs_sseaesni(jobs, count);
+        if (cpu_supports_avx2()) return process_cbc_encrypt_jobs_avx2(jobs, count);
+        return process_cbc_encrypt_jobs_ia32(jobs, count);
+    }
+
+    void process_cbc_encrypt_jobs(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count)
+    {
+        if (cpu_supports_avx2aesni()) return process_cbc_encrypt_jobs_avx2aesni(jobs, count);
+        if (cpu_supports_sseaesni()) return process_cbc_encrypt_jobs_sseaesni(jobs, count);
+        if (cpu_supports_avx2()) return process_cbc_encrypt_jobs_avx2(jobs, count);
+        return process_cbc_encrypt_jobs_ia32(jobs, count);
+    }
+
+    // multi-key jobs without avx2aesni: each job is processed by a single-key backend selected by its length.
+    template <class key_vector_t>
+    static void process_ecb_jobs_serial(const ecb_job_t<key_vector_t>* jobs, size_t count)
+    {
+        const auto thresholds = get_backend_thresholds();
+        for (size_t i = 0; i < count; i++)
+        {
+            const auto& job = jobs[i];
+            if (cpu_supports_sseaesni() && job.length >= thresholds.sseaesni) process_blocks_ecb_sseaesni(job.dst, job.src, job.length, *job.key);
+            else if (cpu_supports_avx2() && job.length >= thresholds.avx2) process_blocks_ecb_avx2(job.dst, job.src, job.length, *job.key);
+            else process_blocks_ecb_ia32(job.dst, job.src, job.length, *job.key);
+        }
+    }
+
+    template <class key_vector_t>
+    static void process_ctr_jobs_serial(const ctr_job_t<key_vector_t>* jobs, size_t count)
+    {
+        const auto thresholds = get_backend_thresholds();
+        for (size_t i = 0; i < count; i++)
+        {
+            const auto& job = jobs[i];
+            const ctr_vector_t cv = generate_ctr_vector(job.iv, job.nonce);
+            if (cpu_supports_sseaesni() && job.length >= thresholds.sseaesni) process_bytes_ctr_sseaesni(job.dst, job.src, job.position, job.length, *job.key, cv);
+            else if (cpu_supports_avx2() && job.length >= thresholds.avx2) process_bytes_ctr_avx2(job.dst, job.src, job.position, job.length, *job.key, cv);
+            else process_bytes_ctr_ia32(job.dst, job.src, job.position, job.length, *job.key, cv);
+        }
+    }
+
+    template <class key_vector_t, class key_t>
+    static ecb_job_t<key_vector_t> rebind_job(const ecb_job_t<key_t>& job, const key_vector_t* key) { return {key, job.dst, job.src, job.length}; }
+
+    template <class key_vector_t, class key_t>
+    static ctr_job_t<key_vector_t> rebind_job(const ctr_job_t<key_t>& job, const key_vector_t* key) { return {key, job.iv, job.nonce, job.dst, job.src, job.position, job.length}; }
+
+    template <class key_vector_t, bool encrypting, template <class> class job_tt, class key_t>
+    static void process_jobs_with_key_vectors(const job_tt<key_t>* jobs, size_t count)
+    {
+        // check camellia block size.
+        if constexpr (std::is_same_v<job_tt<key_t>, ecb_job_t<key_t>>)
+            for (size_t i = 0; i < count; i++)
+                if (jobs[i].length % 16 != 0)
+                    throw std::invalid_argument("invalid length. length must be multiple of 16.");
+
+        std::vector<const key_t*> keys(count);
+        for (size_t i = 0; i < count; i++)
+            keys[i] = jobs[i].key;
+
+        std::vector<key_vector_t> key_vectors(count);
+        if constexpr (encrypting) generate_key_vectors_encrypt(key_vectors.data(), keys.data(), count);
+        else generate_key_vectors_decrypt(key_vectors.data(), keys.data(), count);
+
+        std::vector<job_tt<key_vector_t>> key_vector_jobs(count);
+        for (size_t i = 0; i < count; i++)
+            key_vector_jobs[i] = rebind_job(jobs[i], &key_vectors[i]);
+
+        if constexpr (std::is_same_v<job_tt<key_t>, ecb_job_t<key_t>>)
+        {
+            if (cpu_supports_avx2aesni()) process_ecb_jobs_avx2aesni(key_vector_jobs.data(), count);
+            else process_ecb_jobs_serial(key_vector_jobs.data(), count);
+        }
+        else
+        {
+            if (cpu_supports_avx2aesni()) process_ctr_jobs_avx2aesni(key_vector_jobs.data(), count);
+            else process_ctr_jobs_serial(key_vector_jobs.data(), count);
+        }
+
+        for (auto& kv : key_vectors)
+            bit::secure_be_zero(kv);
+    }
+
+    void process_ecb_encrypt_jobs(const ecb_job_t<key_128bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_small_t, true>(jobs, count); }
+    void process_ecb_encrypt_jobs(const ecb_job_t<key_192bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_large_t, true>(jobs, count); }
+    void process_ecb_encrypt_jobs(const ecb_job_t<key_256bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_large_t, true>(jobs, count); }
+    void process_ecb_decrypt_jobs(const ecb_job_t<key_128bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_small_t, false>(jobs, count); }
+    void process_ecb_decrypt_jobs(const ecb_job_t<key_192bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_large_t, false>(jobs, count); }
+    void process_ecb_decrypt_jobs(const ecb_job_t<key_256bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_large_t, false>(jobs, count); }
+    void process_ctr_jobs(const ctr_job_t<key_128bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_small_t, true>(jobs, count); }
+    void process_ctr_jobs(const ctr_job_t<key_192bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_large_t, true>(jobs, count); }
+    void process_ctr_jobs(const ctr_job_t<key_256bit_t>* jobs, size_t count) { return process_jobs_with_key_vectors<key_vector_large_t, true>(jobs, count); }
+
     std::unique_ptr<ctr_context_t> create_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce)
     {
-        if (cpu_supports_avx2aesni()) return create_ctr_context_avx2aesni(key, iv, nonce);
-        if (cpu_supports_avx2()) return create_ctr_context_avx2(key, iv, nonce);
+        if (backend_routing_enabled()) return make_routing_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce));
         return create_ctr_context_ia32(key, iv, nonce);
     }
 
     std::unique_ptr<ctr_context_t> create_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce)
     {
-        if (cpu_supports_avx2aesni()) return create_ctr_context_avx2aesni(key, iv, nonce);
-        if (cpu_supports_avx2()) return create_ctr_context_avx2(key, iv, nonce);
+        if (backend_routing_enabled()) return make_routing_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce));
         return create_ctr_context_ia32(key, iv, nonce);
     }
 
     std::unique_ptr<ctr_context_t> create_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce)
     {
-        if (cpu_supports_avx2aesni()) return create_ctr_context_avx2aesni(key, iv, nonce);
-        if (cpu_supports_avx2()) return create_ctr_context_avx2(key, iv, nonce);
+        if (backend_routing_enabled()) return make_routing_ctr_context(generate_key_vector_encrypt(key), generate_ctr_vector(iv, nonce));
         return create_ctr_context_ia32(key, iv, nonce);
     }
+
+    std::unique_ptr<ctr_context_t> create_ctr_context(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout)
+    {
+        if (backend_routing_enabled()) return make_routing_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout);
+        return create_ctr_context_ia32(key, initial_counter, layout);
+    }
+
+    std::unique_ptr<ctr_context_t> create_ctr_context(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout)
+    {
+        if (backend_routing_enabled()) return make_routing_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout);
+        return create_ctr_context_ia32(key, initial_counter, layout);
+    }
+
+    std::unique_ptr<ctr_context_t> create_ctr_context(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout)
+    {
+        if (backend_routing_enabled()) return make_routing_ctr_context(generate_key_vector_encrypt(key), *initial_counter, layout);
+        return create_ctr_context_ia32(key, initial_counter, layout);
+    }
+
+    static constexpr size_t parallel_ctr_slice_size = 256 * 1024; // fits in L2, and a multiple of any backend batch size.
+    static constexpr size_t parallel_ctr_threshold = 4 * parallel_ctr_slice_size;
+
+    static std::unique_ptr<ctr_context_t> make_parallel_ctr_context(std::unique_ptr<ctr_context_t> ctx, size_t thread_count)
+    {
+        struct parallel_ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const std::unique_ptr<ctr_context_t> context_;
+            parallel::worker_pool_t pool_;
+
+            explicit parallel_ctr_context_impl_t(std::unique_ptr<ctr_context_t> ctx, size_t thread_count) : context_(std::move(ctx)), pool_(thread_count) { }
+
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+            {
+                if (length < parallel_ctr_threshold || pool_.thread_count() == 1)
+                    return context_->process_bytes(dst, src, position, length);
+
+                // slice boundaries are aligned to absolute stream position
+                constexpr size_t slice_size = parallel_ctr_slice_size;
+                const size_t first = position / slice_size;
+                const size_t last = (position + length - 1) / slice_size;
+                pool_.parallel_for(last - first + 1, [&](size_t i)
+                {
+                    const size_t begin = std::max(position, (first + i) * slice_size);
+                    const size_t end = std::min(position + length, (first + i + 1) * slice_size);
+                    const size_t offset = begin - position;
+                    context_->process_bytes(
+                        static_cast<byte_t*>(dst) + offset,
+                        src ? static_cast<const byte_t*>(src) + offset : nullptr,
+                        begin, end - begin);
+                });
+            }
+        };
+
+        return std::make_unique<parallel_ctr_context_impl_t>(std::move(ctx), thread_count);
+    }
+
+    std::unique_ptr<ctr_context_t> create_parallel_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t thread_count) { return make_parallel_ctr_context(create_ctr_context(key, iv, nonce), thread_count); }
+    std::unique_ptr<ctr_context_t> create_parallel_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t thread_count) { return make_parallel_ctr_context(create_ctr_context(key, iv, nonce), thread_count); }
+    std::unique_ptr<ctr_context_t> create_parallel_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t thread_count) { return make_parallel_ctr_context(create_ctr_context(key, iv, nonce), thread_count); }
+
+    static constexpr size_t cached_ctr_batch_size = 512; // keystream batch of the widest backend (32 blocks)
+
+    // dst = src ^ keystream (src == nullptr: dst = keystream)
+    static void xor_keystream(byte_t* dst, const byte_t* src, const byte_t* keystream, size_t length)
+    {
+        if (!src)
+        {
+            memcpy(dst, keystream, length); // keystream only
+            return;
+        }
+
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) bit::store_u<uint64_t>(dst + i, bit::load_u<uint64_t>(src + i) ^ bit::load_u<uint64_t>(keystream + i));
+        for (; i < length; i++) dst[i] = src[i] ^ keystream[i];
+    }
+
+    static std::unique_ptr<ctr_context_t> make_cached_ctr_context(std::unique_ptr<ctr_context_t> ctx)
+    {
+        struct cached_ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const std::unique_ptr<ctr_context_t> context_;
+            alignas(64) byte_array<cached_ctr_batch_size> keystream_{};
+            size_t keystream_index_ = ~size_t{};
+
+            explicit cached_ctr_context_impl_t(std::unique_ptr<ctr_context_t> ctx) : context_(std::move(ctx)) { }
+            ~cached_ctr_context_impl_t() override { bit::secure_be_zero(keystream_); }
+
+            // Processes bytes within a batch with the cached keystream.
+            void process_bytes_cached(byte_t* dst, const byte_t* src, size_t position, size_t length)
+            {
+                constexpr size_t batch_size = cached_ctr_batch_size;
+                if (const size_t index = position / batch_size; index != keystream_index_)
+                {
+                    context_->generate(keystream_.data(), index * batch_size, batch_size);
+                    keystream_index_ = index;
+                }
+
+                xor_keystream(dst, src, keystream_.data() + position % batch_size, length);
+            }
+
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+            {
+                constexpr size_t batch_size = cached_ctr_batch_size;
+                if (length == 0) return;
+
+                auto* src_ptr = static_cast<const byte_t*>(src);
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+
+                // Processes first partial batch with the cache
+                if (const size_t s = position % batch_size; s || length < batch_size)
+                {
+                    const size_t sz = std::min(batch_size - s, length);
+                    process_bytes_cached(dst_ptr, src_ptr, position, sz);
+                    if (src_ptr) src_ptr += sz;
+                    dst_ptr += sz;
+                    position += sz;
+                    length -= sz;
+                }
+
+                // Processes whole batches directly
+                if (const size_t sz = length / batch_size * batch_size)
+                {
+                    context_->process_bytes(dst_ptr, src_ptr, position, sz);
+                    if (src_ptr) src_ptr += sz;
+                    dst_ptr += sz;
+                    position += sz;
+                    length -= sz;
+                }
+
+                // Processes last partial batch with the cache
+                if (length)
+                    process_bytes_cached(dst_ptr, src_ptr, position, length);
+            }
+        };
+
+        return std::make_unique<cached_ctr_context_impl_t>(std::move(ctx));
+    }
+
+    std::unique_ptr<ctr_context_t> create_cached_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_cached_ctr_context(create_ctr_context(key, iv, nonce)); }
+    std::unique_ptr<ctr_context_t> create_cached_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_cached_ctr_context(create_ctr_context(key, iv, nonce)); }
+    std::unique_ptr<ctr_context_t> create_cached_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce) { return make_cached_ctr_context(create_ctr_context(key, iv, nonce)); }
+
+    static constexpr size_t precomputed_ctr_slot_size = 4096; // keystream generated at once by the background thread (8 batches)
+
+    static std::unique_ptr<ctr_context_t> make_precomputed_ctr_context(std::unique_ptr<ctr_context_t> ctx, size_t ahead)
+    {
+        struct precomputed_ctr_context_impl_t final : public virtual ctr_context_t
+        {
+            const std::unique_ptr<ctr_context_t> context_;
+            const size_t slot_count_;
+            std::vector<byte_t> ring_; // keystream of stream slot s is at ring slot s % slot_count_
+
+            // Slots [consumed_, ready_) of the stream are in the ring.
+            //   ready_ is advanced by the producer, consumed_ by the consumer (the caller of process_bytes).
+            std::atomic<size_t> ready_{};
+            std::atomic<size_t> consumed_{};
+            std::atomic<bool> producer_waiting_{};
+
+            std::mutex mutex_{};
+            std::condition_variable condition_{};
+            size_t next_{};     // guarded by mutex_, next slot to fill
+            size_t epoch_{};    // guarded by mutex_, incremented on restart
+            bool stop_ = false; // guarded by mutex_
+
+            std::thread producer_{};
+
+            precomputed_ctr_context_impl_t(std::unique_ptr<ctr_context_t> ctx, size_t ahead)
+                : context_(std::move(ctx))
+                , slot_count_(std::max<size_t>((ahead + precomputed_ctr_slot_size - 1) / precomputed_ctr_slot_size, 2))
+                , ring_(slot_count_ * precomputed_ctr_slot_size)
+            {
+                producer_ = std::thread([this] { produce(); });
+            }
+
+            ~precomputed_ctr_context_impl_t() override
+            {
+                {
+                    std::lock_guard lock(mutex_);
+                    stop_ = true;
+                }
+                condition_.notify_one();
+                producer_.join();
+                bit::secure_memzero(reinterpret_cast<uint8_t*>(ring_.data()), ring_.size());
+            }
+
+            // Background thread: fills free ring slots ahead of the consumer.
+            void produce()
+            {
+                std::unique_lock lock(mutex_);
+                for (;;)
+                {
+                    producer_waiting_.store(true);
+                    condition_.wait(lock, [this] { return stop_ || next_ < consumed_.load() + slot_count_; });
+                    producer_waiting_.store(false);
+                    if (stop_) return;
+
+                    // Generates the slot without the lock: the consumer never reads a slot at or beyond ready_.
+                    const size_t slot = next_;
+                    const size_t epoch = epoch_;
+                    lock.unlock();
+                    constexpr size_t slot_size = precomputed_ctr_slot_size;
+                    context_->generate(ring_.data() + slot % slot_count_ * slot_size, slot * slot_size, slot_size);
+                    lock.lock();
+
+                    if (epoch == epoch_) // otherwise restarted meanwhile: discards the slot
+                    {
+                        next_ = slot + 1;
+                        ready_.store(slot + 1, std::memory_order_release);
+                    }
+                }
+            }
+
+            // Restarts precomputation from the slot (kept going if the slot is ready or being generated).
+            void restart(size_t slot)
+            {
+                {
+                    std::lock_guard lock(mutex_);
+                    if (slot < consumed_.load() || slot > next_)
+                    {
+                        epoch_++;
+                        next_ = slot;
+                        ready_.store(slot, std::memory_order_relaxed);
+                    }
+                    consumed_.store(slot);
+                }
+                condition_.notify_one();
+            }
+
+            // Releases ring slots before the slot to the producer.
+            void consume(size_t slot)
+            {
+                if (slot == consumed_.load(std::memory_order_relaxed)) return;
+                consumed_.store(slot);
+                if (producer_waiting_.load())
+                {
+                    std::lock_guard lock(mutex_); // the producer is in wait (or about to check consumed_ again)
+                    condition_.notify_one();
+                }
+            }
+
+            void process_bytes(void* dst, const void* src, size_t position, size_t length) override
+            {
+                constexpr size_t slot_size = precomputed_ctr_slot_size;
+                if (length == 0) return;
+
+                const size_t first = position / slot_size;
+                const size_t last = (position + length - 1) / slot_size;
+                if (first < consumed_.load(std::memory_order_relaxed) || last >= ready_.load(std::memory_order_acquire))
+                {
+                    // Not precomputed (random access, or the producer is behind): processes directly.
+                    context_->process_bytes(dst, src, position, length);
+                    restart((position + length) / slot_size);
+                    return;
+                }
+
+                auto* src_ptr = static_cast<const byte_t*>(src);
+                auto* dst_ptr = static_cast<byte_t*>(dst);
+                for (size_t done = 0; done < length;)
+                {
+                    const size_t p = position + done;
+                    const size_t sz = std::min(slot_size - p % slot_size, length - done);
+                    const byte_t* k = ring_.data() + p / slot_size % slot_count_ * slot_size + p % slot_size;
+                    xor_keystream(dst_ptr + done, src_ptr ? src_ptr + done : nullptr, k, sz);
+                    done += sz;
+                }
+
+                consume((position + length) / slot_size);
+            }
+        };
+
+        return std::make_unique<precomputed_ctr_context_impl_t>(std::move(ctx), ahead);
+    }
+
+    std::unique_ptr<ctr_context_t> create_precomputed_ctr_context(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t ahead) { return make_precomputed_ctr_context(create_ctr_context(key, iv, nonce), ahead); }
+    std::unique_ptr<ctr_context_t> create_precomputed_ctr_context(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t ahead) { return make_precomputed_ctr_context(create_ctr_context(key, iv, nonce), ahead); }
+    std::unique_ptr<ctr_context_t> create_precomputed_ctr_context(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, size_t ahead) { return make_precomputed_ctr_context(create_ctr_context(key, iv, nonce), ahead); }
+
+    void ctr_context_t::process_segments(const buffer_segment_t* dst_iov, size_t dst_count, const const_buffer_segment_t* src_iov, size_t src_count, size_t position)
+    {
+        size_t length = 0;
+        for (size_t i = 0; i < dst_count; i++) length += dst_iov[i].length;
+        if (src_iov)
+        {
+            size_t src_length = 0;
+            for (size_t i = 0; i < src_count; i++) src_length += src_iov[i].length;
+            if (src_length != length) throw std::invalid_argument("total length of src_iov must be equal to that of dst_iov.");
+        }
+
+        // A batch straddling segment boundaries is generated once into the buffer,
+        // and every whole batch within a segment is processed directly.
+        constexpr size_t batch_size = cached_ctr_batch_size;
+        alignas(64) byte_array<batch_size> keystream{};
+        size_t keystream_index = ~size_t{};
+
+        const size_t end = position + length;
+        size_t d = 0, d_offset = 0, s = 0, s_offset = 0;
+        while (position < end)
+        {
+            while (d_offset == dst_iov[d].length) d++, d_offset = 0;
+            while (src_iov && s_offset == src_iov[s].length) s++, s_offset = 0;
+
+            auto* dst_ptr = static_cast<byte_t*>(dst_iov[d].data) + d_offset;
+            auto* src_ptr = src_iov ? static_cast<const byte_t*>(src_iov[s].data) + s_offset : nullptr;
+            size_t sz = dst_iov[d].length - d_offset;
+            if (src_iov) sz = std::min(sz, src_iov[s].length - s_offset);
+
+            if (position % batch_size == 0 && (sz >= batch_size || position + sz == end))
+            {
+                // whole batches (and the last partial batch of the stream)
+                if (position + sz != end) sz = sz / batch_size * batch_size;
+                process_bytes(dst_ptr, src_ptr, position, sz);
+            }
+            else
+            {
+                // batch straddling segment boundaries
+                if (const size_t index = position / batch_size; index != keystream_index)
+                {
+                    generate(keystream.data(), index * batch_size, std::min(batch_size, end - index * batch_size));
+                    keystream_index = index;
+                }
+
+                sz = std::min(sz, batch_size - position % batch_size);
+                xor_keystream(dst_ptr, src_ptr, keystream.data() + position % batch_size, sz);
+            }
+
+            d_offset += sz;
+            s_offset += sz;
+            position += sz;
+        }
+
+        bit::secure_be_zero(keystream);
+    }
+
+    static backend_t resolve_backend(backend_t backend)
+    {
+        switch (backend)
+        {
+        case backend_t::automatic: return backend;
+        case backend_t::ia32: if (cpu_supports_ia32()) return backend; break;
+        case backend_t::avx2: if (cpu_supports_avx2()) return backend; break;
+        case backend_t::sseaesni: if (cpu_supports_sseaesni()) return backend; break;
+        case backend_t::avx2aesni: if (cpu_supports_avx2aesni()) return backend; break;
+        }
+        throw std::invalid_argument("unsupported backend.");
+    }
+
+    template <class key_vector_t>
+    using ctr_function_t = void (*)(void* dst, const void* src, size_t position, size_t length, const key_vector_t& key_vector, const ctr_vector_t& ctr_vector, const backend_thresholds_t& thresholds);
+
+    // Routes a call by its length as the dispatching contexts do (see backend_thresholds_t).
+    template <class key_vector_t>
+    static void process_bytes_ctr_routing(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv, const backend_thresholds_t& thresholds)
+    {
+        if (cpu_supports_avx2aesni() && length >= thresholds.avx2aesni) return process_bytes_ctr_avx2aesni(dst, src, position, length, kv, cv);
+        if (cpu_supports_sseaesni() && length >= thresholds.sseaesni) return process_bytes_ctr_sseaesni(dst, src, position, length, kv, cv);
+        if (cpu_supports_avx2() && length >= thresholds.avx2) return process_bytes_ctr_avx2(dst, src, position, length, kv, cv);
+        return process_bytes_ctr_ia32(dst, src, position, length, kv, cv);
+    }
+
+    template <class key_vector_t>
+    static ctr_function_t<key_vector_t> resolve_ctr_function(backend_t backend)
+    {
+        switch (backend)
+        {
+        case backend_t::automatic: return &process_bytes_ctr_routing<key_vector_t>;
+        case backend_t::ia32: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv, const backend_thresholds_t&) { return process_bytes_ctr_ia32(dst, src, position, length, kv, cv); };
+        case backend_t::avx2: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv, const backend_thresholds_t&) { return process_bytes_ctr_avx2(dst, src, position, length, kv, cv); };
+        case backend_t::sseaesni: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv, const backend_thresholds_t&) { return process_bytes_ctr_sseaesni(dst, src, position, length, kv, cv); };
+        case backend_t::avx2aesni: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const ctr_vector_t& cv, const backend_thresholds_t&) { return process_bytes_ctr_avx2aesni(dst, src, position, length, kv, cv); };
+        default: throw std::invalid_argument("unsupported backend.");
+        }
+    }
+
+    template <class key_vector_t>
+    using ctr_layout_function_t = void (*)(void* dst, const void* src, size_t position, size_t length, const key_vector_t& key_vector, const block_t& initial, ctr_layout_t layout, const backend_thresholds_t& thresholds);
+
+    template <class key_vector_t>
+    static void process_bytes_ctr_routing(void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout, const backend_thresholds_t& thresholds)
+    {
+        if (cpu_supports_avx2aesni() && length >= thresholds.avx2aesni) return process_bytes_ctr_avx2aesni(dst, src, position, length, kv, initial, layout);
+        if (cpu_supports_sseaesni() && length >= thresholds.sseaesni) return process_bytes_ctr_sseaesni(dst, src, position, length, kv, initial, layout);
+        if (cpu_supports_avx2() && length >= thresholds.avx2) return process_bytes_ctr_avx2(dst, src, position, length, kv, initial, layout);
+        return process_bytes_ctr_ia32(dst, src, position, length, kv, initial, layout);
+    }
+
+    template <class key_vector_t>
+    static ctr_layout_function_t<key_vector_t> resolve_ctr_layout_function(backend_t backend)
+    {
+        switch (backend)
+        {
+        case backend_t::automatic: return &process_bytes_ctr_routing<key_vector_t>;
+        case backend_t::ia32: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout, const backend_thresholds_t&) { return process_bytes_ctr_ia32(dst, src, position, length, kv, initial, layout); };
+        case backend_t::avx2: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout, const backend_thresholds_t&) { return process_bytes_ctr_avx2(dst, src, position, length, kv, initial, layout); };
+        case backend_t::sseaesni: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout, const backend_thresholds_t&) { return process_bytes_ctr_sseaesni(dst, src, position, length, kv, initial, layout); };
+        case backend_t::avx2aesni: return [](void* dst, const void* src, size_t position, size_t length, const key_vector_t& kv, const block_t& initial, ctr_layout_t layout, const backend_thresholds_t&) { return process_bytes_ctr_avx2aesni(dst, src, position, length, kv, initial, layout); };
+        default: throw std::invalid_argument("unsupported backend.");
+        }
+    }
+
+    template <size_t key_bits>
+    ctr_t<key_bits>::ctr_t(const key_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce, backend_t backend)
+        : backend_(backend)
+    {
+        rekey(key, iv, nonce);
+    }
+
+    template <size_t key_bits>
+    ctr_t<key_bits>::ctr_t(ctr_t&& other) noexcept
+        : ctr_t(other)
+    {
+        other.wipe();
+    }
+
+    template <size_t key_bits>
+    ctr_t<key_bits>& ctr_t<key_bits>::operator=(ctr_t&& other) noexcept
+    {
+        if (this != &other)
+        {
+            *this = other;
+            other.wipe();
+        }
+        return *this;
+    }
+
+    template <size_t key_bits>
+    ctr_t<key_bits>::~ctr_t()
+    {
+        wipe();
+    }
+
+    template <size_t key_bits>
+    void ctr_t<key_bits>::wipe() noexcept
+    {
+        function_ = &process_bytes_unkeyed;
+        bit::secure_be_zero(key_vector_);
+        bit::secure_be_zero(ctr_vector_);
+    }
+
+    template <size_t key_bits>
+    void ctr_t<key_bits>::process_bytes_unkeyed(void*, const void*, size_t, size_t, const key_vector_t&, const ctr_vector_t&, const backend_thresholds_t&)
+    {
+        throw std::logic_error("ctr_t is not keyed.");
+    }
+
+    template <size_t key_bits>
+    void ctr_t<key_bits>::rekey(const key_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce)
+    {
+        if (function_ == &process_bytes_unkeyed)
+        {
+            backend_ = resolve_backend(backend_);
+            function_ = resolve_ctr_function<key_vector_t>(backend_);
+        }
+        thresholds_ = get_backend_thresholds();
+
+        auto kv = generate_key_vector_encrypt(key);
+        auto cv = generate_ctr_vector(iv, nonce);
+        static_assert(std::is_same_v<decltype(kv), key_vector_t>);
+        key_vector_ = kv;
+        ctr_vector_ = cv;
+        bit::secure_be_zero(kv);
+        bit::secure_be_zero(cv);
+    }
+
+    template <size_t key_bits>
+    void ctr_t<key_bits>::rekey(ctr_t* contexts, const key_t* const* keys, const ctr_iv_t* const* ivs, const ctr_nonce_t* const* nonces, size_t count)
+    {
+        const backend_thresholds_t thresholds = get_backend_thresholds();
+        std::array<key_vector_t, 32> kvs;
+        for (size_t i = 0; i < count; i += kvs.size())
+        {
+            const size_t n = std::min(count - i, kvs.size());
+            generate_key_vectors_encrypt(kvs.data(), keys + i, n);
+            for (size_t j = 0; j < n; j++)
+            {
+                ctr_t& c = contexts[i + j];
+                if (c.function_ == &process_bytes_unkeyed)
+                {
+                    c.backend_ = resolve_backend(c.backend_);
+                    c.function_ = resolve_ctr_function<key_vector_t>(c.backend_);
+                }
+                c.thresholds_ = thresholds;
+
+                auto cv = generate_ctr_vector(ivs[i + j], nonces[i + j]);
+                c.key_vector_ = kvs[j];
+                c.ctr_vector_ = cv;
+                bit::secure_be_zero(cv);
+            }
+        }
+        bit::secure_be_zero(kvs);
+    }
+
+    template class ctr_t<128>;
+    template class ctr_t<192>;
+    template class ctr_t<256>;
+
+    // Processes a ctr stream in cache-sized chunks and calls `on_chunk(ciphertext, length)` while each chunk is still hot.
+    template <size_t chunk_size, bool encrypt, class on_chunk_t>
+    static void process_bytes_ctr_chunked(ctr_context_t* context, void* dst, const void* src, size_t position, size_t length, on_chunk_t&& on_chunk)
+    {
+        auto* d = static_cast<byte_t*>(dst);
+        auto* s = static_cast<const byte_t*>(src);
+        for (size_t i = 0; i < length; i += chunk_size)
+        {
+            const size_t l = std::min(length - i, chunk_size);
+            if constexpr (!encrypt) on_chunk(s + i, l);
+            context->process_bytes(d + i, s + i, position + i, l);
+            if constexpr (encrypt) on_chunk(d + i, l);
+        }
+    }
+
+    // src and dst chunks together fit in L1
+    static constexpr size_t ctr_crc32_chunk_size = 8192;
+
+    crc32::crc32_value_t encrypt_bytes_ctr_crc32(ctr_context_t* context, void* dst, const void* src, size_t position, size_t length, crc32::crc32_value_t current)
+    {
+        process_bytes_ctr_chunked<ctr_crc32_chunk_size, true>(context, dst, src, position, length, [&](const void* p, size_t l) { current = crc32::calculate_crc32(p, l, current); });
+        return current;
+    }
+
+    crc32::crc32_value_t decrypt_bytes_ctr_crc32(ctr_context_t* context, void* dst, const void* src, size_t position, size_t length, crc32::crc32_value_t current)
+    {
+        process_bytes_ctr_chunked<ctr_crc32_chunk_size, false>(context, dst, src, position, length, [&](const void* p, size_t l) { current = crc32::calculate_crc32(p, l, current); });
+        return current;
+    }
+
+    // sha256 is slower than ctr: a chunk stays in L1/L2 until hashed
+    static constexpr size_t ctr_sha256_chunk_size = 16384;
+
+    void encrypt_bytes_ctr_sha256(ctr_context_t* context, sha2::sha256_context_t* digest, void* dst, const void* src, size_t position, size_t length)
+    {
+        process_bytes_ctr_chunked<ctr_sha256_chunk_size, true>(context, dst, src, position, length, [digest](const void* p, size_t l) { digest->process_bytes(p, l); });
+    }
+
+    void decrypt_bytes_ctr_sha256(ctr_context_t* context, sha2::sha256_context_t* digest, void* dst, const void* src, size_t position, size_t length)
+    {
+        process_bytes_ctr_chunked<ctr_sha256_chunk_size, false>(context, dst, src, position, length, [digest](const void* p, size_t l) { digest->process_bytes(p, l); });
+    }
+
+    // SP 800-90A table 3: max_number_of_bits_per_request 2^19, reseed_interval 2^48
+    static constexpr size_t ctr_drbg_max_request_size = size_t{1} << 16;
+    static constexpr uint64_t ctr_drbg_reseed_interval = uint64_t{1} << 48;
+
+    template <class key_t>
+    static std::unique_ptr<ctr_drbg_context_t> make_ctr_drbg_context(const void* entropy, size_t entropy_length, const void* personalization, size_t personalization_length)
+    {
+        struct ctr_drbg_context_impl_t final : public virtual ctr_drbg_context_t
+        {
+            using seed_t = byte_array<sizeof(key_t) + sizeof(block_t)>;
+
+            using key_vector_t = decltype(generate_key_vector_encrypt(std::declval<const key_t*>()));
+
+            // keystream of V+1, V+2, ... under key_: routed by length, rekeyed in place on every update.
+            const ctr_layout_function_t<key_vector_t> ctr_ = resolve_ctr_layout_function<key_vector_t>(backend_t::automatic);
+            const backend_thresholds_t thresholds_ = get_backend_thresholds();
+            key_t key_{};
+            block_t v_{};
+            key_vector_t key_vector_{};
+            block_t counter_{};
+            uint64_t reseed_counter_{};
+
+            ctr_drbg_context_impl_t(const void* entropy, size_t entropy_length, const void* personalization, size_t personalization_length)
+            {
+                // instantiate: K = 0, V = 0
+                reset_ctr();
+                reseed(entropy, entropy_length, personalization, personalization_length);
+            }
+
+            ~ctr_drbg_context_impl_t() override
+            {
+                bit::secure_be_zero(key_);
+                bit::secure_be_zero(v_);
+                bit::secure_be_zero(key_vector_);
+                bit::secure_be_zero(counter_);
+            }
+
+            static void xor_input(seed_t& seed, const void* input, size_t length)
+            {
+                if (!input) return;
+                if (length > seed.size()) throw std::invalid_argument("invalid input length.");
+                for (size_t i = 0; i < length; i++) seed[i] ^= static_cast<const byte_t*>(input)[i];
+            }
+
+            void reset_ctr()
+            {
+                auto kv = generate_key_vector_encrypt(&key_);
+                key_vector_ = kv;
+                bit::secure_be_zero(kv);
+
+                counter_ = v_;
+                for (size_t i = counter_.size(); i--;) // V + 1
+                    if ((counter_[i] = static_cast<byte_t>(static_cast<uint8_t>(counter_[i]) + 1)) != byte_t{}) break;
+            }
+
+            void generate_keystream(void* dst, size_t position, size_t length) const
+            {
+                return ctr_(dst, nullptr, position, length, key_vector_, counter_, ctr_layout_t::be128, thresholds_);
+            }
+
+            // CTR_DRBG_Update: the seed_length bytes of keystream from `position`.
+            void update(const seed_t& provided, size_t position)
+            {
+                seed_t temp{};
+                generate_keystream(temp.data(), position, temp.size());
+                for (size_t i = 0; i < temp.size(); i++) temp[i] ^= provided[i];
+                memcpy(key_.data(), temp.data(), key_.size());
+                memcpy(v_.data(), temp.data() + key_.size(), v_.size());
+                reset_ctr();
+                bit::secure_be_zero(temp);
+            }
+
+            void reseed(const void* entropy, size_t entropy_length, const void* additional, size_t additional_length) override
+            {
+                seed_t seed{};
+                if (entropy_length != seed.size()) throw std::invalid_argument("invalid entropy length.");
+                xor_input(seed, entropy, entropy_length);
+                xor_input(seed, additional, additional_length);
+                update(seed, 0);
+                reseed_counter_ = 1;
+                bit::secure_be_zero(seed);
+            }
+
+            void generate_request(byte_t* dst, size_t length, const void* additional, size_t additional_length)
+            {
+                if (reseed_counter_ > ctr_drbg_reseed_interval) throw std::runtime_error("reseed required.");
+
+                seed_t input{};
+                xor_input(input, additional, additional_length);
+                if (additional) update(input, 0);
+
+                // output blocks are the keystream itself; the following update continues from the next counter.
+                generate_keystream(dst, 0, length);
+                update(input, (length + sizeof(block_t) - 1) / sizeof(block_t) * sizeof(block_t));
+                reseed_counter_++;
+                bit::secure_be_zero(input);
+            }
+
+            void generate(void* dst, size_t length, const void* additional, size_t additional_length) override
+            {
+                auto* d = static_cast<byte_t*>(dst);
+                size_t i = 0;
+                do
+                {
+                    const size_t l = std::min(length - i, ctr_drbg_max_request_size);
+                    generate_request(d + i, l, i == 0 ? additional : nullptr, i == 0 ? additional_length : 0);
+                    i += l;
+                } while (i < length);
+            }
+        };
+
+        return std::make_unique<ctr_drbg_context_impl_t>(entropy, entropy_length, personalization, personalization_length);
+    }
+
+    std::unique_ptr<ctr_drbg_context_t> create_ctr_drbg_context(size_t key_bits, const void* entropy, size_t entropy_length, const void* personalization, size_t personalization_length)
+    {
+        switch (key_bits)
+        {
+        case 128: return make_ctr_drbg_context<key_128bit_t>(entropy, entropy_length, personalization, personalization_length);
+        case 192: return make_ctr_drbg_context<key_192bit_t>(entropy, entropy_length, personalization, personalization_length);
+        case 256: return make_ctr_drbg_context<key_256bit_t>(entropy, entropy_length, personalization, personalization_length);
+        default: throw std::invalid_argument("invalid key size.");
+        }
+    }
+
+    std::unique_ptr<gcm_context_t> create_gcm_context(const key_128bit_t* key)
+    {
+        if (cpu_supports_avx2aesniclmul()) return create_gcm_context_avx2aesni(key);
+        if (cpu_supports_sseaesniclmul()) return create_gcm_context_sseaesni(key);
+        if (cpu_supports_avx2clmul()) return create_gcm_context_avx2(key);
+        return create_gcm_context_ia32(key);
+    }
+
+    std::unique_ptr<gcm_context_t> create_gcm_context(const key_192bit_t* key)
+    {
+        if (cpu_supports_avx2aesniclmul()) return create_gcm_context_avx2aesni(key);
+        if (cpu_supports_sseaesniclmul()) return create_gcm_context_sseaesni(key);
+        if (cpu_supports_avx2clmul()) return create_gcm_context_avx2(key);
+        return create_gcm_context_ia32(key);
+    }
+
+    std::unique_ptr<gcm_context_t> create_gcm_context(const key_256bit_t* key)
+    {
+        if (cpu_supports_avx2aesniclmul()) return create_gcm_context_avx2aesni(key);
+        if (cpu_supports_sseaesniclmul()) return create_gcm_context_sseaesni(key);
+        if (cpu_supports_avx2clmul()) return create_gcm_context_avx2(key);
+        return create_gcm_context_ia32(key);
+    }
+
+    // CBC-MAC chains of independent messages (one chain per job), interleaved across SIMD lanes.
+    //   A single chain is serial on any backend: it runs on ia32, which has the shortest per-block latency.
+    template <class key_vector_t>
+    static void process_cbc_mac_jobs(const cbc_encrypt_job_t<key_vector_t>* jobs, size_t count)
+    {
+        // A few chains do not fill a wide batch; the serial ia32 path is faster for them.
+        constexpr size_t min_batch_jobs = 8;
+        if (count >= min_batch_jobs && cpu_supports_avx2aesni()) return process_cbc_encrypt_jobs_avx2aesni(jobs, count);
+        if (count >= min_batch_jobs && cpu_supports_sseaesni()) return process_cbc_encrypt_jobs_sseaesni(jobs, count);
+        if (count >= min_batch_jobs && cpu_supports_avx2()) return process_cbc_encrypt_jobs_avx2(jobs, count);
+        return process_cbc_encrypt_jobs_ia32(jobs, count);
+    }
+
+    // mac = CBC-MAC(mac, src) over whole blocks.
+    template <class key_vector_t>
+    static void process_cbc_mac(const key_vector_t& kv, cbc_iv_t& mac, const void* src, size_t length)
+    {
+        const cbc_encrypt_job_t<key_vector_t> job{&kv, &mac, nullptr, src, length};
+        if (length) process_cbc_mac_jobs(&job, 1);
+    }
+
+    // mac = CBC-MAC(mac, src || zero padding)
+    template <class key_vector_t>
+    static void process_cbc_mac_padded(const key_vector_t& kv, cbc_iv_t& mac, const void* src, size_t length)
+    {
+        const size_t whole = length / sizeof(block_t) * sizeof(block_t);
+        process_cbc_mac(kv, mac, src, whole);
+        if (const size_t rest = length - whole)
+        {
+            block_t last{};
+            memcpy(last.data(), static_cast<const byte_t*>(src) + whole, rest);
+            process_cbc_mac(kv, mac, last.data(), last.size());
+            bit::secure_be_zero(last);
+        }
+    }
+
+    // NIST SP 800-38B subkey derivation: k << 1 (as a big-endian integer), reduced by 0x87.
+    static block_t cmac_double(const block_t& k)
+    {
+        block_t r{};
+        for (size_t i = 0; i < r.size(); i++)
+            r[i] = k[i] << 1 | (i + 1 < k.size() ? k[i + 1] >> 7 : byte_t{});
+        if ((k[0] & byte_t{0x80}) != byte_t{}) r[15] ^= byte_t{0x87};
+        return r;
+    }
+
+    // The last block of a CMAC message, masked by a subkey of L = E(0^128).
+    //   complete block: M_n ^ K1, incomplete (or empty) block: (M_n || 10...0) ^ K2
+    static block_t cmac_last_block(const void* tail, size_t tail_length, const block_t& l)
+    {
+        block_t k = cmac_double(l);
+        block_t m{};
+        if (tail_length) memcpy(m.data(), tail, tail_length);
+        if (tail_length != m.size()) m[tail_length] = byte_t{0x80}, k = cmac_double(k);
+        for (size_t i = 0; i < m.size(); i++) m[i] ^= k[i];
+        bit::secure_be_zero(k);
+        return m;
+    }
+
+    // Length of the whole blocks of a CMAC message before its last block.
+    static size_t cmac_body_length(size_t length) { return length ? (length - 1) / sizeof(block_t) * sizeof(block_t) : 0; }
+
+    template <class key_vector_t>
+    static std::unique_ptr<cmac_context_t> make_cmac_context(key_vector_t kv)
+    {
+        struct cmac_context_impl_t final : public virtual cmac_context_t
+        {
+            const key_vector_t key_vector_;
+            block_t l_{};              // L = E(0^128)
+            cbc_iv_t mac_{};           // chaining value
+            block_t pending_{};        // the last block is held until finalize(): it is masked by a subkey.
+            size_t pending_length_{};
+
+            explicit cmac_context_impl_t(const key_vector_t& kv) : key_vector_(kv)
+            {
+                const block_t zero{};
+                process_cbc_mac(key_vector_, l_, zero.data(), zero.size());
+            }
+
+            ~cmac_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)), bit::secure_be_zero(l_), bit::secure_be_zero(mac_), bit::secure_be_zero(pending_); }
+
+            void process_bytes(const void* src, size_t length) override
+            {
+                auto* s = static_cast<const byte_t*>(src);
+                if (pending_length_ < pending_.size())
+                {
+                    const size_t sz = std::min(pending_.size() - pending_length_, length);
+                    if (sz) memcpy(pending_.data() + pending_length_, s, sz);
+                    pending_length_ += sz;
+                    s += sz;
+                    length -= sz;
+                }
+
+                if (!length) return;
+
+                // the pending block is not the last one: chains it and the following whole blocks.
+                process_cbc_mac(key_vector_, mac_, pending_.data(), pending_.size());
+                const size_t body = cmac_body_length(length);
+                process_cbc_mac(key_vector_, mac_, s, body);
+                pending_length_ = length - body;
+                memcpy(pending_.data(), s + body, pending_length_);
+            }
+
+            cmac_tag_t finalize() override
+            {
+                block_t last = cmac_last_block(pending_.data(), pending_length_, l_);
+                process_cbc_mac(key_vector_, mac_, last.data(), last.size());
+                const cmac_tag_t tag = mac_;
+
+                bit::secure_be_zero(last);
+                bit::secure_be_zero(mac_);
+                bit::secure_be_zero(pending_);
+                pending_length_ = 0;
+                return tag;
+            }
+        };
+
+        return std::make_unique<cmac_context_impl_t>(kv);
+    }
+
+    std::unique_ptr<cmac_context_t> create_cmac_context(const key_128bit_t* key) { return make_cmac_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<cmac_context_t> create_cmac_context(const key_192bit_t* key) { return make_cmac_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<cmac_context_t> create_cmac_context(const key_256bit_t* key) { return make_cmac_context(generate_key_vector_encrypt(key)); }
+
+    template <class key_vector_t, class key_t>
+    static void process_cmac_jobs_with_key_vectors(const cmac_job_t<key_t>* jobs, size_t count)
+    {
+        std::vector<const key_t*> keys(count);
+        for (size_t i = 0; i < count; i++)
+            keys[i] = jobs[i].key;
+
+        std::vector<key_vector_t> key_vectors(count);
+        generate_key_vectors_encrypt(key_vectors.data(), keys.data(), count);
+
+        // Three lane-interleaved passes: L = E(0^128), the whole blocks, and the masked last blocks.
+        const block_t zero{};
+        std::vector<cbc_iv_t> macs(count);
+        std::vector<block_t> last(count);
+        std::vector<cbc_encrypt_job_t<key_vector_t>> mac_jobs(count);
+        for (size_t i = 0; i < count; i++)
+            mac_jobs[i] = {&key_vectors[i], &macs[i], nullptr, zero.data(), zero.size()};
+        process_cbc_mac_jobs(mac_jobs.data(), count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            auto* src = static_cast<const byte_t*>(jobs[i].src);
+            const size_t body = cmac_body_length(jobs[i].length);
+            last[i] = cmac_last_block(src + body, jobs[i].length - body, macs[i]);
+            macs[i] = cbc_iv_t{};
+            mac_jobs[i] = {&key_vectors[i], &macs[i], nullptr, src, body};
+        }
+        process_cbc_mac_jobs(mac_jobs.data(), count);
+
+        for (size_t i = 0; i < count; i++)
+            mac_jobs[i] = {&key_vectors[i], &macs[i], nullptr, last[i].data(), last[i].size()};
+        process_cbc_mac_jobs(mac_jobs.data(), count);
+
+        for (size_t i = 0; i < count; i++)
+            *jobs[i].tag = macs[i];
+
+        for (auto& kv : key_vectors) bit::secure_be_zero(kv);
+        for (auto& m : macs) bit::secure_be_zero(m);
+        for (auto& b : last) bit::secure_be_zero(b);
+    }
+
+    void process_cmac_jobs(const cmac_job_t<key_128bit_t>* jobs, size_t count) { return process_cmac_jobs_with_key_vectors<key_vector_small_t>(jobs, count); }
+    void process_cmac_jobs(const cmac_job_t<key_192bit_t>* jobs, size_t count) { return process_cmac_jobs_with_key_vectors<key_vector_large_t>(jobs, count); }
+    void process_cmac_jobs(const cmac_job_t<key_256bit_t>* jobs, size_t count) { return process_cmac_jobs_with_key_vectors<key_vector_large_t>(jobs, count); }
+
+    // ccm: the payload is processed in chunks small enough to stay in L1 cache between the CBC-MAC and CTR passes.
+    static constexpr size_t ccm_chunk_size = 4096;
+
+    template <class key_vector_t>
+    static std::unique_ptr<ccm_context_t> make_ccm_context(key_vector_t kv)
+    {
+        struct ccm_context_impl_t final : public virtual ccm_context_t
+        {
+            const key_vector_t key_vector_;
+            const backend_thresholds_t thresholds_ = get_backend_thresholds();
+            const bool avx2aesni_ = cpu_supports_avx2aesni();
+            const bool sseaesni_ = cpu_supports_sseaesni();
+            const bool avx2_ = cpu_supports_avx2();
+
+            explicit ccm_context_impl_t(const key_vector_t& kv) : key_vector_(kv) { }
+            ~ccm_context_impl_t() override { bit::secure_be_zero(const_cast<key_vector_t&>(key_vector_)); }
+
+            // A_i = flags || nonce || i: the counter field never carries over for valid lengths,
+            // so the keystream is the be128-layout ctr stream from A_0 (payload from position 16), routed by length.
+            void process_ctr(void* dst, const void* src, size_t position, size_t length, const block_t& a0) const
+            {
+                if (avx2aesni_ && length >= thresholds_.avx2aesni) return process_bytes_ctr_avx2aesni(dst, src, position, length, key_vector_, a0, ctr_layout_t::be128);
+                if (sseaesni_ && length >= thresholds_.sseaesni) return process_bytes_ctr_sseaesni(dst, src, position, length, key_vector_, a0, ctr_layout_t::be128);
+                if (avx2_ && length >= thresholds_.avx2) return process_bytes_ctr_avx2(dst, src, position, length, key_vector_, a0, ctr_layout_t::be128);
+                return process_bytes_ctr_ia32(dst, src, position, length, key_vector_, a0, ctr_layout_t::be128);
+            }
+
+            // Validates parameters, chains B_0 and the encoded aad into mac, and returns A_0.
+            block_t begin(cbc_iv_t& mac, size_t length, const void* nonce, size_t nonce_length, const void* aad, size_t aad_length, size_t tag_length) const
+            {
+                if (nonce_length < 7 || nonce_length > 13) throw std::invalid_argument("invalid nonce length. nonce length must be 7 to 13.");
+                if (tag_length < 4 || tag_length > 16 || tag_length % 2) throw std::invalid_argument("invalid tag length. tag length must be 4, 6, 8, 10, 12, 14 or 16.");
+                const size_t q = 15 - nonce_length; // size of the length (counter) field
+                if (q < sizeof(uint64_t) && static_cast<uint64_t>(length) >> q * 8) throw std::invalid_argument("invalid length. length must be less than 2^(8 * (15 - nonce_length)).");
+
+                block_t a0{};
+                a0[0] = static_cast<byte_t>(q - 1);
+                memcpy(a0.data() + 1, nonce, nonce_length);
+
+                // B_0 || encoded aad length || aad (the first bytes)
+                byte_array<32> head{};
+                head[0] = static_cast<byte_t>((aad_length ? 0x40 : 0) | (tag_length - 2) / 2 << 3 | (q - 1));
+                memcpy(head.data() + 1, nonce, nonce_length);
+                for (size_t i = 0; i < q && i < sizeof(uint64_t); i++)
+                    head[15 - i] = static_cast<byte_t>(static_cast<uint64_t>(length) >> i * 8);
+
+                size_t h = 16; // aad length is encoded in 2, 6 or 10 bytes (none if empty).
+                if (const auto a = static_cast<uint64_t>(aad_length); a > 0xFFFFFFFF)
+                    head[16] = byte_t{0xFF}, head[17] = byte_t{0xFF}, bit::store_u<uint64_t>(head.data() + 18, bit::byteswap(a)), h = 26;
+                else if (a >= 0xFF00)
+                    head[16] = byte_t{0xFF}, head[17] = byte_t{0xFE}, bit::store_u<uint32_t>(head.data() + 18, bit::byteswap(static_cast<uint32_t>(a))), h = 22;
+                else if (a)
+                    bit::store_u<uint16_t>(head.data() + 16, bit::byteswap(static_cast<uint16_t>(a))), h = 18;
+
+                const size_t aad_head = std::min(aad_length, head.size() - h);
+                if (aad_head) memcpy(head.data() + h, aad, aad_head);
+                process_cbc_mac_padded(key_vector_, mac, head.data(), h + aad_head);
+                if (aad_head < aad_length) process_cbc_mac_padded(key_vector_, mac, static_cast<const byte_t*>(aad) + aad_head, aad_length - aad_head);
+                bit::secure_be_zero(head);
+                return a0;
+            }
+
+            // T = MAC ^ S_0 (S_0 = E(A_0))
+            block_t finish(const cbc_iv_t& mac, const block_t& a0) const
+            {
+                block_t t{};
+                process_ctr(t.data(), mac.data(), 0, t.size(), a0);
+                return t;
+            }
+
+            void encrypt(void* dst, const void* src, size_t length, const void* nonce, size_t nonce_length, const void* aad, size_t aad_length, void* tag, size_t tag_length) override
+            {
+                auto* d = static_cast<byte_t*>(dst);
+                auto* s = static_cast<const byte_t*>(src);
+
+                cbc_iv_t mac{};
+                const block_t a0 = begin(mac, length, nonce, nonce_length, aad, aad_length, tag_length);
+                for (size_t i = 0; i < length; i += ccm_chunk_size)
+                {
+                    const size_t sz = std::min(length - i, ccm_chunk_size);
+                    process_cbc_mac_padded(key_vector_, mac, s + i, sz); // authenticate plain text before (in-place) encryption
+                    process_ctr(d + i, s + i, 16 + i, sz, a0);
+                }
+
+                block_t t = finish(mac, a0);
+                memcpy(tag, t.data(), tag_length);
+                bit::secure_be_zero(t);
+                bit::secure_be_zero(mac);
+            }
+
+            bool decrypt(void* dst, const void* src, size_t length, const void* nonce, size_t nonce_length, const void* aad, size_t aad_length, const void* tag, size_t tag_length) override
+            {
+                auto* d = static_cast<byte_t*>(dst);
+                auto* s = static_cast<const byte_t*>(src);
+
+                cbc_iv_t mac{};
+                const block_t a0 = begin(mac, length, nonce, nonce_length, aad, aad_length, tag_length);
+                for (size_t i = 0; i < length; i += ccm_chunk_size)
+                {
+                    const size_t sz = std::min(length - i, ccm_chunk_size);
+                    process_ctr(d + i, s + i, 16 + i, sz, a0);
+                    process_cbc_mac_padded(key_vector_, mac, d + i, sz);
+                }
+
+                // constant-time comparison
+                block_t t = finish(mac, a0);
+                byte_t diff{};
+                for (size_t i = 0; i < tag_length; i++) diff |= t[i] ^ static_cast<const byte_t*>(tag)[i];
+                bit::secure_be_zero(t);
+                bit::secure_be_zero(mac);
+
+                // never release unauthenticated plain text
+                if (diff != byte_t{})
+                {
+                    if (length) memset(dst, 0, length);
+                    return false;
+                }
+
+                return true;
+            }
+        };
+
+        return std::make_unique<ccm_context_impl_t>(kv);
+    }
+
+    std::unique_ptr<ccm_context_t> create_ccm_context(const key_128bit_t* key) { return make_ccm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<ccm_context_t> create_ccm_context(const key_192bit_t* key) { return make_ccm_context(generate_key_vector_encrypt(key)); }
+    std::unique_ptr<ccm_context_t> create_ccm_context(const key_256bit_t* key) { return make_ccm_context(generate_key_vector_encrypt(key)); }
+
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context(const key_128bit_t* key, const key_128bit_t* tweak_key)
+    {
+        if (cpu_supports_avx2aesni()) return create_xts_encrypt_context_avx2aesni(key, tweak_key);
+        if (cpu_supports_sseaesni()) return create_xts_encrypt_context_sseaesni(key, tweak_key);
+        if (cpu_supports_avx2()) return create_xts_encrypt_context_avx2(key, tweak_key);
+        return create_xts_encrypt_context_ia32(key, tweak_key);
+    }
+
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context(const key_192bit_t* key, const key_192bit_t* tweak_key)
+    {
+        if (cpu_supports_avx2aesni()) return create_xts_encrypt_context_avx2aesni(key, tweak_key);
+        if (cpu_supports_sseaesni()) return create_xts_encrypt_context_sseaesni(key, tweak_key);
+        if (cpu_supports_avx2()) return create_xts_encrypt_context_avx2(key, tweak_key);
+        return create_xts_encrypt_context_ia32(key, tweak_key);
+    }
+
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context(const key_256bit_t* key, const key_256bit_t* tweak_key)
+    {
+        if (cpu_supports_avx2aesni()) return create_xts_encrypt_context_avx2aesni(key, tweak_key);
+        if (cpu_supports_sseaesni()) return create_xts_encrypt_context_sseaesni(key, tweak_key);
+        if (cpu_supports_avx2()) return create_xts_encrypt_context_avx2(key, tweak_key);
+        return create_xts_encrypt_context_ia32(key, tweak_key);
+    }
+
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context(const key_128bit_t* key, const key_128bit_t* tweak_key)
+    {
+        if (cpu_supports_avx2aesni()) return create_xts_decrypt_context_avx2aesni(key, tweak_key);
+        if (cpu_supports_sseaesni()) return create_xts_decrypt_context_sseaesni(key, tweak_key);
+        if (cpu_supports_avx2()) return create_xts_decrypt_context_avx2(key, tweak_key);
+        return create_xts_decrypt_context_ia32(key, tweak_key);
+    }
+
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context(const key_192bit_t* key, const key_192bit_t* tweak_key)
+    {
+        if (cpu_supports_avx2aesni()) return create_xts_decrypt_context_avx2aesni(key, tweak_key);
+        if (cpu_supports_sseaesni()) return create_xts_decrypt_context_sseaesni(key, tweak_key);
+        if (cpu_supports_avx2()) return create_xts_decrypt_context_avx2(key, tweak_key);
+        return create_xts_decrypt_context_ia32(key, tweak_key);
+    }
+
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context(const key_256bit_t* key, const key_256bit_t* tweak_key)
+    {
+        if (cpu_supports_avx2aesni()) return create_xts_decrypt_context_avx2aesni(key, tweak_key);
+        if (cpu_supports_sseaesni()) return create_xts_decrypt_context_sseaesni(key, tweak_key);
+        if (cpu_supports_avx2()) return create_xts_decrypt_context_avx2(key, tweak_key);
+        return create_xts_decrypt_context_ia32(key, tweak_key);
+    }
 }
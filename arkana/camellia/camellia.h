@@ -16,13 +16,6 @@
 
 namespace arkana::camellia
 {
-    struct key_vector_small_tag;
-    struct key_vector_large_tag;
-    struct ctr_vector_tag;
-    using key_vector_small_t = tagged_memory_buffer<key_vector_small_tag, sizeof(uint64_t) * 26>;
-    using key_vector_large_t = tagged_memory_buffer<key_vector_small_tag, sizeof(uint64_t) * 34>;
-    using ctr_vector_t = tagged_memory_buffer<key_vector_small_tag, sizeof(uint32_t) * 4>;
-
     key_vector_small_t generate_key_vector_encrypt(const key_128bit_t* key);
     key_vector_large_t generate_key_vector_encrypt(const key_192bit_t* key);
     key_vector_large_t generate_key_vector_encrypt(const key_256bit_t* key);
@@ -30,26 +23,98 @@ namespace arkana::camellia
     key_vector_large_t generate_key_vector_decrypt(const key_192bit_t* key);
     key_vector_large_t generate_key_vector_decrypt(const key_256bit_t* key);
 
+    // batched key scheduling: dst[i] = generate_key_vector_*(keys[i]) for i < count.
+    void generate_key_vectors_encrypt(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count);
+    void generate_key_vectors_encrypt(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count);
+    void generate_key_vectors_encrypt(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count);
+    void generate_key_vectors_decrypt(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count);
+    void generate_key_vectors_decrypt(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count);
+    void generate_key_vectors_decrypt(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count);
+
     ctr_vector_t generate_ctr_vector(const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    ctr_vector_t generate_gcm_ctr_vector(const gcm_iv_t* iv);
 
     bool cpu_supports_ia32() noexcept;
+    bool cpu_supports_ia32bmi2() noexcept;
     bool cpu_supports_avx2() noexcept;
     bool cpu_supports_avx2aesni() noexcept;
+    bool cpu_supports_avx2clmul() noexcept;
+    bool cpu_supports_avx2aesniclmul() noexcept;
+    bool cpu_supports_sseaesni() noexcept;
+    bool cpu_supports_sseaesniclmul() noexcept;
 
     void process_blocks_ecb_ia32(void* dst, const void* src, size_t length, const key_vector_small_t& kv);
     void process_blocks_ecb_ia32(void* dst, const void* src, size_t length, const key_vector_large_t& kv);
+    void process_blocks_cbc_decrypt_ia32(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv);
+    void process_blocks_cbc_decrypt_ia32(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv);
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count);
     void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv);
     void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_bytes_ctr_ia32(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_sectors_xts_ia32(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv);
+    void process_sectors_xts_ia32(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv);
+
+    void process_blocks_ecb_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_small_t& kv);
+    void process_blocks_ecb_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_large_t& kv);
+    void process_blocks_cbc_decrypt_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv);
+    void process_blocks_cbc_decrypt_ia32bmi2(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv);
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_bytes_ctr_ia32bmi2(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_sectors_xts_ia32bmi2(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv);
+    void process_sectors_xts_ia32bmi2(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv);
 
     void process_blocks_ecb_avx2(void* dst, const void* src, size_t length, const key_vector_small_t& kv);
     void process_blocks_ecb_avx2(void* dst, const void* src, size_t length, const key_vector_large_t& kv);
+    void process_blocks_cbc_decrypt_avx2(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv);
+    void process_blocks_cbc_decrypt_avx2(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv);
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count);
     void process_bytes_ctr_avx2(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv);
     void process_bytes_ctr_avx2(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_avx2(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_bytes_ctr_avx2(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_sectors_xts_avx2(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv);
+    void process_sectors_xts_avx2(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv);
 
+    void generate_key_vectors_encrypt_avx2aesni(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count);
+    void generate_key_vectors_encrypt_avx2aesni(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count);
+    void generate_key_vectors_encrypt_avx2aesni(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count);
+    void generate_key_vectors_decrypt_avx2aesni(key_vector_small_t* dst, const key_128bit_t* const* keys, size_t count);
+    void generate_key_vectors_decrypt_avx2aesni(key_vector_large_t* dst, const key_192bit_t* const* keys, size_t count);
+    void generate_key_vectors_decrypt_avx2aesni(key_vector_large_t* dst, const key_256bit_t* const* keys, size_t count);
     void process_blocks_ecb_avx2aesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv);
     void process_blocks_ecb_avx2aesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv);
+    void process_blocks_cbc_decrypt_avx2aesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv);
+    void process_blocks_cbc_decrypt_avx2aesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv);
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count);
+    void process_ecb_jobs_avx2aesni(const ecb_job_t<key_vector_small_t>* jobs, size_t count);
+    void process_ecb_jobs_avx2aesni(const ecb_job_t<key_vector_large_t>* jobs, size_t count);
+    void process_ctr_jobs_avx2aesni(const ctr_job_t<key_vector_small_t>* jobs, size_t count);
+    void process_ctr_jobs_avx2aesni(const ctr_job_t<key_vector_large_t>* jobs, size_t count);
     void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv);
     void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_bytes_ctr_avx2aesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_sectors_xts_avx2aesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv);
+    void process_sectors_xts_avx2aesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv);
+
+    void process_blocks_ecb_sseaesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv);
+    void process_blocks_ecb_sseaesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv);
+    void process_blocks_cbc_decrypt_sseaesni(void* dst, const void* src, size_t length, const key_vector_small_t& kv, cbc_iv_t& iv);
+    void process_blocks_cbc_decrypt_sseaesni(void* dst, const void* src, size_t length, const key_vector_large_t& kv, cbc_iv_t& iv);
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_vector_small_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_vector_large_t>* jobs, size_t count);
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const ctr_vector_t& cv);
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_small_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_bytes_ctr_sseaesni(void* dst, const void* src, size_t position, size_t length, const key_vector_large_t& kv, const block_t& initial, ctr_layout_t layout);
+    void process_sectors_xts_sseaesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_small_t& kv, const key_vector_small_t& tweak_kv);
+    void process_sectors_xts_sseaesni(void* dst, const void* src, uint64_t sector_index, size_t sector_size, size_t length, const key_vector_large_t& kv, const key_vector_large_t& tweak_kv);
 
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_ia32(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_ia32(const key_192bit_t* key);
@@ -57,9 +122,27 @@ namespace arkana::camellia
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_ia32(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_ia32(const key_192bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_ia32(const key_256bit_t* key);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_ia32(const key_128bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_ia32(const key_192bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_ia32(const key_256bit_t* key, const cbc_iv_t* iv);
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_ia32(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count);
     std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_ia32(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<gcm_context_t> create_gcm_context_ia32(const key_128bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_ia32(const key_192bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_ia32(const key_256bit_t* key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_ia32(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_ia32(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_ia32(const key_256bit_t* key, const key_256bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_ia32(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_ia32(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_ia32(const key_256bit_t* key, const key_256bit_t* tweak_key);
 
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2(const key_192bit_t* key);
@@ -67,9 +150,27 @@ namespace arkana::camellia
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2(const key_192bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2(const key_256bit_t* key);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2(const key_128bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2(const key_192bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2(const key_256bit_t* key, const cbc_iv_t* iv);
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_avx2(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count);
     std::unique_ptr<ctr_context_t> create_ctr_context_avx2(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context_avx2(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context_avx2(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2(const key_128bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2(const key_192bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2(const key_256bit_t* key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2(const key_256bit_t* key, const key_256bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2(const key_256bit_t* key, const key_256bit_t* tweak_key);
 
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_avx2aesni(const key_192bit_t* key);
@@ -77,7 +178,67 @@ namespace arkana::camellia
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_128bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_192bit_t* key);
     std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_avx2aesni(const key_256bit_t* key);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2aesni(const key_128bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2aesni(const key_192bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_avx2aesni(const key_256bit_t* key, const cbc_iv_t* iv);
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_avx2aesni(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count);
     std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
     std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2aesni(const key_128bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2aesni(const key_192bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_avx2aesni(const key_256bit_t* key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2aesni(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2aesni(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_avx2aesni(const key_256bit_t* key, const key_256bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2aesni(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2aesni(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_avx2aesni(const key_256bit_t* key, const key_256bit_t* tweak_key);
+    // from a key vector already scheduled (the dispatching contexts expand it on first use)
+    std::unique_ptr<ecb_context_t> create_ecb_context_avx2aesni(const key_vector_small_t& kv, size_t streaming_threshold);
+    std::unique_ptr<ecb_context_t> create_ecb_context_avx2aesni(const key_vector_large_t& kv, size_t streaming_threshold);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_small_t& kv, const ctr_vector_t& cv, size_t streaming_threshold);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_large_t& kv, const ctr_vector_t& cv, size_t streaming_threshold);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_small_t& kv, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_avx2aesni(const key_vector_large_t& kv, const block_t* initial_counter, ctr_layout_t layout);
+
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_sseaesni(const key_128bit_t* key);
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_sseaesni(const key_192bit_t* key);
+    std::unique_ptr<ecb_context_t> create_ecb_encrypt_context_sseaesni(const key_256bit_t* key);
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_sseaesni(const key_128bit_t* key);
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_sseaesni(const key_192bit_t* key);
+    std::unique_ptr<ecb_context_t> create_ecb_decrypt_context_sseaesni(const key_256bit_t* key);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_sseaesni(const key_128bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_sseaesni(const key_192bit_t* key, const cbc_iv_t* iv);
+    std::unique_ptr<cbc_decrypt_context_t> create_cbc_decrypt_context_sseaesni(const key_256bit_t* key, const cbc_iv_t* iv);
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_128bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_192bit_t>* jobs, size_t count);
+    void process_cbc_encrypt_jobs_sseaesni(const cbc_encrypt_job_t<key_256bit_t>* jobs, size_t count);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_128bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_192bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_256bit_t* key, const ctr_iv_t* iv, const ctr_nonce_t* nonce);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_128bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_192bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_256bit_t* key, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<gcm_context_t> create_gcm_context_sseaesni(const key_128bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_sseaesni(const key_192bit_t* key);
+    std::unique_ptr<gcm_context_t> create_gcm_context_sseaesni(const key_256bit_t* key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_sseaesni(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_sseaesni(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_encrypt_context_sseaesni(const key_256bit_t* key, const key_256bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_sseaesni(const key_128bit_t* key, const key_128bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_sseaesni(const key_192bit_t* key, const key_192bit_t* tweak_key);
+    std::unique_ptr<xts_context_t> create_xts_decrypt_context_sseaesni(const key_256bit_t* key, const key_256bit_t* tweak_key);
+    // from a key vector already scheduled (the dispatching contexts expand it on first use)
+    std::unique_ptr<ecb_context_t> create_ecb_context_sseaesni(const key_vector_small_t& kv);
+    std::unique_ptr<ecb_context_t> create_ecb_context_sseaesni(const key_vector_large_t& kv);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_small_t& kv, const ctr_vector_t& cv);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_large_t& kv, const ctr_vector_t& cv);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_small_t& kv, const block_t* initial_counter, ctr_layout_t layout);
+    std::unique_ptr<ctr_context_t> create_ctr_context_sseaesni(const key_vector_large_t& kv, const block_t* initial_counter, ctr_layout_t layout);
 }
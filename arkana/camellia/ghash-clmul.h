@@ -0,0 +1,140 @@
+/// @file
+/// @brief	arkana::camellia::ghash
+///			- An implementation of GHASH (the universal hash function of GCM)
+/// @author Copyright(c) 2021 ttsuki
+///
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// - GCM: NIST SP 800-38D https://doi.org/10.6028/NIST.SP.800-38D
+///
+/// This implementation based on
+///   "Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode"
+///   -- S. Gueron, M. E. Kounavis, 2010,
+///   https://www.intel.com/content/dam/develop/external/us/en/documents/clmul-wp-rev-2-02-2014-04-20.pdf
+
+#pragma once
+
+#include "ghash-ref.h"
+#include "../ark/xmm.h"
+
+namespace arkana::camellia::ghash
+{
+    namespace clmul
+    {
+        using namespace xmm;
+
+        /// Precomputed powers of H: h[i] = H^(i+1) (byte-reflected)
+        struct ghash_key_t
+        {
+            static constexpr size_t aggregation = 8;
+            vu64x2 h[aggregation];
+        };
+
+        namespace impl
+        {
+            /// Unreduced 256-bit product
+            struct product_t
+            {
+                vx128x1 lo, mi, hi;
+            };
+
+            ARKXMM_API byte_reflect(vu64x2 v) -> vu64x2
+            {
+                return byte_shuffle_128(v, from_values<XMM<int8_t>>(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+            }
+
+            ARKXMM_API load_block(const void* src) -> vu64x2
+            {
+                return byte_reflect(load_u<vu64x2>(src));
+            }
+
+            ARKXMM_API zero_product() -> product_t
+            {
+                return {zero<vx128x1>(), zero<vx128x1>(), zero<vx128x1>()};
+            }
+
+            // p += a * b (schoolbook, unreduced)
+            ARKXMM_API multiply_accumulate(product_t& p, vu64x2 a, vu64x2 b) -> void
+            {
+                p.lo ^= xmm::clmul<0, 0>(a, b);
+                p.hi ^= xmm::clmul<1, 1>(a, b);
+                p.mi ^= xmm::clmul<0, 1>(a, b) ^ xmm::clmul<1, 0>(a, b);
+            }
+
+            // returns p mod (x^128 + x^7 + x^2 + x + 1) in bit-reflected representation.
+            ARKXMM_API reduce(const product_t& p) -> vu64x2
+            {
+                vu32x4 lo = reinterpret<vu32x4>(p.lo ^ byte_shift_l_128<8>(p.mi));
+                vu32x4 hi = reinterpret<vu32x4>(p.hi ^ byte_shift_r_128<8>(p.mi));
+
+                // <hi:lo> <<= 1
+                const vu32x4 lo_carry = lo >> 31;
+                const vu32x4 hi_carry = hi >> 31;
+                lo = lo << 1 | byte_shift_l_128<4>(lo_carry);
+                hi = hi << 1 | byte_shift_l_128<4>(hi_carry) | byte_shift_r_128<12>(lo_carry);
+
+                // first phase
+                const vu32x4 a = lo << 31 ^ lo << 30 ^ lo << 25;
+                lo ^= byte_shift_l_128<12>(a);
+
+                // second phase
+                const vu32x4 b = lo >> 1 ^ lo >> 2 ^ lo >> 7 ^ byte_shift_r_128<4>(a);
+                return reinterpret<vu64x2>(hi ^ lo ^ b);
+            }
+
+            ARKXMM_API multiply(vu64x2 a, vu64x2 b) -> vu64x2
+            {
+                product_t p = zero_product();
+                multiply_accumulate(p, a, b);
+                return reduce(p);
+            }
+        }
+
+        static inline ghash_key_t generate_ghash_key(const ghash_block_t& h)
+        {
+            ghash_key_t k{};
+            k.h[0] = impl::load_block(h.data());
+            for (size_t i = 1; i < ghash_key_t::aggregation; i++)
+                k.h[i] = impl::multiply(k.h[i - 1], k.h[0]);
+            return k;
+        }
+
+        /// Absorbs data into GHASH state y.
+        ///   y: GHASH state.
+        ///   k: hash key.
+        ///   data: data to absorb.
+        ///   length: length in bytes. (the last partial block is zero-padded.)
+        static inline void ghash_update(ghash_block_t& y, const ghash_key_t& k, const void* data, size_t length)
+        {
+            using namespace impl;
+            constexpr size_t n = ghash_key_t::aggregation;
+
+            auto* p = static_cast<const byte_t*>(data);
+            vu64x2 x = load_block(y.data());
+
+            // aggregated reduction: x = (x + c0) * H^n + c1 * H^(n-1) + ... + c(n-1) * H
+            for (; length >= 16 * n; p += 16 * n, length -= 16 * n)
+            {
+                product_t acc = zero_product();
+                multiply_accumulate(acc, x ^ load_block(p), k.h[n - 1]);
+                for (size_t i = 1; i < n; i++)
+                    multiply_accumulate(acc, load_block(p + 16 * i), k.h[n - 1 - i]);
+                x = reduce(acc);
+            }
+
+            for (; length >= 16; p += 16, length -= 16)
+                x = multiply(x ^ load_block(p), k.h[0]);
+
+            if (length)
+            {
+                ghash_block_t buf{};
+                memcpy(buf.data(), p, length);
+                x = multiply(x ^ load_block(buf.data()), k.h[0]);
+                bit::secure_be_zero(buf);
+            }
+
+            store_u<vu64x2>(y.data(), byte_reflect(x));
+        }
+    }
+}
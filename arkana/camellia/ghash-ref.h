@@ -0,0 +1,120 @@
+/// @file
+/// @brief	arkana::camellia::ghash
+///			- An implementation of GHASH (the universal hash function of GCM)
+/// @author Copyright(c) 2021 ttsuki
+///
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// - GCM: NIST SP 800-38D https://doi.org/10.6028/NIST.SP.800-38D
+///
+/// This implementation based on the 4-bit table method described in
+///   "The Galois/Counter Mode of Operation (GCM)"
+///   -- D. McGrew, J. Viega, 2005
+
+#pragma once
+
+#include "../ark/types.h"
+#include "../ark/intrinsics.h"
+
+namespace arkana::camellia::ghash
+{
+    using ghash_block_t = byte_array<16>;
+
+    namespace ref
+    {
+        /// Precomputed multiples of H: table[i] = i * H (i in 4-bit, bit-reflected)
+        struct ghash_key_t
+        {
+            uint64_t hh[16];
+            uint64_t hl[16];
+        };
+
+        static inline ghash_key_t generate_ghash_key(const ghash_block_t& h)
+        {
+            ghash_key_t k{};
+
+            uint64_t vh = bit::byteswap(bit::load_u<uint64_t>(h.data() + 0));
+            uint64_t vl = bit::byteswap(bit::load_u<uint64_t>(h.data() + 8));
+            k.hh[8] = vh;
+            k.hl[8] = vl;
+
+            for (size_t i = 4; i > 0; i >>= 1)
+            {
+                const uint64_t t = (vl & 1) * 0xE100000000000000;
+                vl = vh << 63 | vl >> 1;
+                vh = vh >> 1 ^ t;
+                k.hh[i] = vh;
+                k.hl[i] = vl;
+            }
+
+            for (size_t i = 2; i <= 8; i *= 2)
+            {
+                for (size_t j = 1; j < i; j++)
+                {
+                    k.hh[i + j] = k.hh[i] ^ k.hh[j];
+                    k.hl[i + j] = k.hl[i] ^ k.hl[j];
+                }
+            }
+
+            return k;
+        }
+
+        /// y = y * H
+        static inline void ghash_multiply_h(ghash_block_t& y, const ghash_key_t& k)
+        {
+            static constexpr uint16_t last4[16] = {
+                0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+                0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+            };
+
+            const auto* x = reinterpret_cast<const uint8_t*>(y.data());
+            uint64_t zh = k.hh[x[15] & 0xF];
+            uint64_t zl = k.hl[x[15] & 0xF];
+
+            for (int i = 15; i >= 0; i--)
+            {
+                const size_t lo = x[i] & 0xF;
+                const size_t hi = x[i] >> 4;
+
+                if (i != 15)
+                {
+                    const size_t rem = zl & 0xF;
+                    zl = zh << 60 | zl >> 4;
+                    zh = zh >> 4 ^ static_cast<uint64_t>(last4[rem]) << 48 ^ k.hh[lo];
+                    zl ^= k.hl[lo];
+                }
+
+                const size_t rem = zl & 0xF;
+                zl = zh << 60 | zl >> 4;
+                zh = zh >> 4 ^ static_cast<uint64_t>(last4[rem]) << 48 ^ k.hh[hi];
+                zl ^= k.hl[hi];
+            }
+
+            bit::store_u<uint64_t>(y.data() + 0, bit::byteswap(zh));
+            bit::store_u<uint64_t>(y.data() + 8, bit::byteswap(zl));
+        }
+
+        /// Absorbs data into GHASH state y.
+        ///   y: GHASH state.
+        ///   k: hash key.
+        ///   data: data to absorb.
+        ///   length: length in bytes. (the last partial block is zero-padded.)
+        static inline void ghash_update(ghash_block_t& y, const ghash_key_t& k, const void* data, size_t length)
+        {
+            auto* p = static_cast<const byte_t*>(data);
+
+            for (; length >= 16; p += 16, length -= 16)
+            {
+                for (size_t i = 0; i < 16; i++) y[i] ^= p[i];
+                ghash_multiply_h(y, k);
+            }
+
+            if (length)
+            {
+                for (size_t i = 0; i < length; i++) y[i] ^= p[i];
+                ghash_multiply_h(y, k);
+            }
+        }
+    }
+}
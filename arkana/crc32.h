@@ -1,6 +1,6 @@
 /// @file
 /// @brief	arkana::crc32
-///			- An implementation of CRC32
+///			- An implementation of CRC32 and CRC32C
 /// @author Copyright(c) 2020 ttsuki
 /// 
 /// This software is released under the MIT License.
@@ -43,4 +43,13 @@ namespace arkana::crc32
     };
 
     std::unique_ptr<crc32_context_t> create_crc32_context(crc32_value_t initial = 0);
+
+    // Calculates crc32c (Castagnoli polynomial, RFC 3720)
+    //   data: data
+    //   length: length in bytes
+    //   current: current value (for partial calculation)
+    crc32_value_t calculate_crc32c(const void* data, size_t length, crc32_value_t current = 0);
+
+    // Creates crc32c (Castagnoli polynomial, RFC 3720) context.
+    std::unique_ptr<crc32_context_t> create_crc32c_context(crc32_value_t initial = 0);
 }
@@ -36,6 +36,19 @@ namespace arkana::crc32
             static inline constexpr uint64_t kM = 0x1'f7011641;
         };
 
+        template <>
+        struct constants<0x82F63B78>
+        {
+            static inline constexpr uint64_t kP = 0x1'05ec76f1;
+            static inline constexpr uint64_t k1 = 0x0'740eef02;
+            static inline constexpr uint64_t k2 = 0x0'9e4addf8;
+            static inline constexpr uint64_t k3 = 0x0'f20c0dfe;
+            static inline constexpr uint64_t k4 = 0x1'4cd00bd6;
+            static inline constexpr uint64_t k5 = 0x0'dd45aab8;
+            static inline constexpr uint64_t k6 = 0x1'05ec76f0;
+            static inline constexpr uint64_t kM = 0x0'dea713f1;
+        };
+
         template <uint32_t polynomial>
         static inline crc32_value_t calculate_crc32(const void* data, size_t length, crc32_value_t current = 0)
         {
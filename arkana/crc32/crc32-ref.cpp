@@ -33,4 +33,22 @@ namespace arkana::crc32
 
         return std::make_unique<crc32_context_impl_t>(initial);
     }
+
+    crc32_value_t calculate_crc32c_ref(const void* data, size_t length, crc32_value_t current)
+    {
+        return ref::calculate_crc32<0x82F63B78>(data, length, current);
+    }
+
+    std::unique_ptr<crc32_context_t> create_crc32c_context_ref(crc32_value_t initial)
+    {
+        struct crc32_context_impl_t final : public virtual crc32_context_t
+        {
+            crc32_value_t value{};
+            crc32_context_impl_t(crc32_value_t initial) : value(initial) { }
+            crc32_value_t current() const override { return value; }
+            void update(const void* data, size_t length) override { value = calculate_crc32c_ref(data, length, value); }
+        };
+
+        return std::make_unique<crc32_context_impl_t>(initial);
+    }
 }
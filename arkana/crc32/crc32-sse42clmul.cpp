@@ -0,0 +1,42 @@
+/// @file
+/// @brief	arkana::crc32
+///			- An implementation of CRC32C (Castagnoli)
+/// @author Copyright(c) 2020 ttsuki
+/// 
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// This implementation based on
+/// "Fast CRC Computation for iSCSI Polynomial Using CRC32 Instruction"
+/// -- V. Gopal, J. Guilford, E. Ozturk, et al., 2011,
+/// https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/crc-iscsi-polynomial-crc32-instruction-paper.pdf
+
+#include "./crc32.h"
+#include "./crc32-sse42clmul.h"
+#include "../ark/cpuid.h"
+
+namespace arkana::crc32
+{
+    bool cpu_supports_sse42clmul() noexcept
+    {
+        return cpuid::cpu_supports::SSE42 && cpuid::cpu_supports::PCLMULQDQ;
+    }
+
+    crc32_value_t calculate_crc32c_sse42clmul(const void* data, size_t length, crc32_value_t current)
+    {
+        return sse42clmul::calculate_crc32c(data, length, current);
+    }
+
+    std::unique_ptr<crc32_context_t> create_crc32c_context_sse42clmul(crc32_value_t initial)
+    {
+        struct crc32_context_impl_t final : public virtual crc32_context_t
+        {
+            crc32_value_t value{};
+            crc32_context_impl_t(crc32_value_t initial) : value(initial) { }
+            crc32_value_t current() const override { return value; }
+            void update(const void* data, size_t length) override { value = calculate_crc32c_sse42clmul(data, length, value); }
+        };
+
+        return std::make_unique<crc32_context_impl_t>(initial);
+    }
+}
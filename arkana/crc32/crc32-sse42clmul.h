@@ -0,0 +1,117 @@
+/// @file
+/// @brief	arkana::crc32
+///			- An implementation of CRC32C (Castagnoli)
+/// @author Copyright(c) 2020 ttsuki
+///
+/// This software is released under the MIT License.
+/// https://opensource.org/licenses/MIT
+///
+/// This implementation based on
+/// "Fast CRC Computation for iSCSI Polynomial Using CRC32 Instruction"
+/// -- V. Gopal, J. Guilford, E. Ozturk, et al., 2011,
+/// https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/crc-iscsi-polynomial-crc32-instruction-paper.pdf
+
+#pragma once
+
+#include <cstring>
+
+#include "crc32-ref.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <nmmintrin.h> // SSE4.2 crc32
+#include <wmmintrin.h> // PCLMULQDQ
+#endif
+
+namespace arkana::crc32
+{
+    namespace sse42clmul
+    {
+        // The crc32 instruction is hard-wired to the Castagnoli polynomial.
+        static inline constexpr uint32_t polynomial = 0x82F63B78;
+
+        // Shift constants: bit-reflected x^(8n-33) mod P, for n-byte shift.
+        struct constants
+        {
+            static inline constexpr uint64_t k64 = 0x9e4addf8;
+            static inline constexpr uint64_t k128 = 0x0d3b6092;
+            static inline constexpr uint64_t k512 = 0xdd7e3b0c;
+            static inline constexpr uint64_t k1024 = 0x170076fa;
+            static inline constexpr uint64_t k4096 = 0x82f89c77;
+            static inline constexpr uint64_t k8192 = 0x54a86326;
+        };
+
+        static inline uint64_t load_u64(const byte_t* p)
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        static inline uint32_t crc32_u64(uint32_t crc, uint64_t v)
+        {
+#if defined(_M_X64) || defined(__x86_64__)
+            return static_cast<uint32_t>(_mm_crc32_u64(crc, v));
+#else // delegates to 32bit operations
+            crc = _mm_crc32_u32(crc, static_cast<uint32_t>(v));
+            return _mm_crc32_u32(crc, static_cast<uint32_t>(v >> 32));
+#endif
+        }
+
+        // Multiplies crc by x^(8n) mod P, where k is the n-byte shift constant.
+        static inline uint32_t shift(uint32_t crc, uint64_t k)
+        {
+            __m128i t = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(crc)), _mm_set_epi64x(0, static_cast<int64_t>(k)), 0x00);
+            uint64_t v = static_cast<uint32_t>(_mm_cvtsi128_si32(t)) | static_cast<uint64_t>(static_cast<uint32_t>(_mm_extract_epi32(t, 1))) << 32;
+            return crc32_u64(0, v);
+        }
+
+        // Processes 3 * block_size bytes per step as three independent crc32 streams,
+        // then merges them with pclmul shifts by 2 * block_size and block_size bytes.
+        template <size_t block_size, uint64_t k_2n, uint64_t k_n>
+        static inline uint32_t process_3way(const byte_t*& p, size_t& length, uint32_t crc)
+        {
+            while (length >= block_size * 3)
+            {
+                uint32_t a = crc, b = 0, c = 0;
+                for (size_t i = 0; i < block_size; i += 8)
+                {
+                    a = crc32_u64(a, load_u64(p + i));
+                    b = crc32_u64(b, load_u64(p + i + block_size));
+                    c = crc32_u64(c, load_u64(p + i + block_size * 2));
+                }
+                crc = shift(a, k_2n) ^ shift(b, k_n) ^ c;
+                p += block_size * 3;
+                length -= block_size * 3;
+            }
+            return crc;
+        }
+
+        static inline crc32_value_t calculate_crc32c(const void* data, size_t length, crc32_value_t current = 0)
+        {
+            const byte_t* p = static_cast<const byte_t*>(data);
+            uint32_t crc = ~current;
+
+            // process unaligned bytes
+            while (length && (reinterpret_cast<uintptr_t>(p) & 7))
+            {
+                crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*p++));
+                length--;
+            }
+
+            // process 3-way interleaved blocks
+            crc = process_3way<4096, constants::k8192, constants::k4096>(p, length, crc);
+            crc = process_3way<512, constants::k1024, constants::k512>(p, length, crc);
+            crc = process_3way<64, constants::k128, constants::k64>(p, length, crc);
+
+            // process remain bytes
+            for (; length >= 8; p += 8, length -= 8)
+                crc = crc32_u64(crc, load_u64(p));
+            for (; length; p++, length--)
+                crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*p));
+
+            return ~crc;
+        }
+    }
+}
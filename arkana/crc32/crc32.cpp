@@ -23,4 +23,20 @@ namespace arkana::crc32
         if (cpu_supports_avx2()) return create_crc32_context_avx2(initial);
         return create_crc32_context_ia32(initial);
     }
+
+    crc32_value_t calculate_crc32c(const void* data, size_t length, crc32_value_t current)
+    {
+        if (cpu_supports_avx2clmul()) return calculate_crc32c_avx2clmul(data, length, current);
+        if (cpu_supports_sse42clmul()) return calculate_crc32c_sse42clmul(data, length, current);
+        if (cpu_supports_avx2()) return calculate_crc32c_avx2(data, length, current);
+        return calculate_crc32c_ia32(data, length, current);
+    }
+
+    std::unique_ptr<crc32_context_t> create_crc32c_context(crc32_value_t initial)
+    {
+        if (cpu_supports_avx2clmul()) return create_crc32c_context_avx2clmul(initial);
+        if (cpu_supports_sse42clmul()) return create_crc32c_context_sse42clmul(initial);
+        if (cpu_supports_avx2()) return create_crc32c_context_avx2(initial);
+        return create_crc32c_context_ia32(initial);
+    }
 }
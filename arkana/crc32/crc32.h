@@ -16,6 +16,7 @@ namespace arkana::crc32
     bool cpu_supports_ia32() noexcept;
     bool cpu_supports_avx2() noexcept;
     bool cpu_supports_avx2clmul() noexcept;
+    bool cpu_supports_sse42clmul() noexcept;
 
     crc32_value_t calculate_crc32_ref(const void* data, size_t length, crc32_value_t current = 0);
     crc32_value_t calculate_crc32_ia32(const void* data, size_t length, crc32_value_t current = 0);
@@ -26,4 +27,16 @@ namespace arkana::crc32
     std::unique_ptr<crc32_context_t> create_crc32_context_ia32(crc32_value_t initial = 0);
     std::unique_ptr<crc32_context_t> create_crc32_context_avx2(crc32_value_t initial = 0);
     std::unique_ptr<crc32_context_t> create_crc32_context_avx2clmul(crc32_value_t initial = 0);
+
+    crc32_value_t calculate_crc32c_ref(const void* data, size_t length, crc32_value_t current = 0);
+    crc32_value_t calculate_crc32c_ia32(const void* data, size_t length, crc32_value_t current = 0);
+    crc32_value_t calculate_crc32c_avx2(const void* data, size_t length, crc32_value_t current = 0);
+    crc32_value_t calculate_crc32c_avx2clmul(const void* data, size_t length, crc32_value_t current = 0);
+    crc32_value_t calculate_crc32c_sse42clmul(const void* data, size_t length, crc32_value_t current = 0);
+
+    std::unique_ptr<crc32_context_t> create_crc32c_context_ref(crc32_value_t initial = 0);
+    std::unique_ptr<crc32_context_t> create_crc32c_context_ia32(crc32_value_t initial = 0);
+    std::unique_ptr<crc32_context_t> create_crc32c_context_avx2(crc32_value_t initial = 0);
+    std::unique_ptr<crc32_context_t> create_crc32c_context_avx2clmul(crc32_value_t initial = 0);
+    std::unique_ptr<crc32_context_t> create_crc32c_context_sse42clmul(crc32_value_t initial = 0);
 }
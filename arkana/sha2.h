@@ -77,4 +77,9 @@ namespace arkana::sha2
     std::unique_ptr<sha512_context_t> create_sha512_context();
     std::unique_ptr<sha512_224_context_t> create_sha512_224_context();
     std::unique_ptr<sha512_256_context_t> create_sha512_256_context();
+
+    // Creates HMAC-SHA-256 context (RFC 2104)
+    //   key: hmac key
+    //   key_length: length of key in bytes (longer key than 64 bytes is hashed first)
+    std::unique_ptr<sha256_context_t> create_hmac_sha256_context(const void* key, size_t key_length);
 }
@@ -7,6 +7,9 @@
 /// https://opensource.org/licenses/MIT
 
 #include "./sha2.h"
+#include "../ark/intrinsics.h"
+
+#include <cstring>
 
 namespace arkana::sha2
 {
@@ -57,4 +60,63 @@ namespace arkana::sha2
         if (cpu_supports_avx2()) return create_sha512_256_context_avx2();
         return create_sha512_256_context_ref();
     }
+
+    template <class context_t, size_t block_size, auto create_context>
+    static std::unique_ptr<context_t> make_hmac_context(const void* key, size_t key_length)
+    {
+        struct hmac_context_impl_t final : public virtual context_t
+        {
+            using digest_t = typename context_t::digest_t;
+            std::unique_ptr<context_t> inner_ = create_context();
+            std::unique_ptr<context_t> outer_ = create_context(); // allocated up front: finalize() is noexcept
+
+            hmac_context_impl_t(const void* key, size_t key_length)
+            {
+                std::array<std::byte, block_size> k{};
+                if (key_length > block_size)
+                {
+                    auto hash = create_context();
+                    hash->process_bytes(key, key_length);
+                    digest_t d = hash->finalize();
+                    std::memcpy(k.data(), d.data(), d.size());
+                    bit::secure_be_zero(d);
+                }
+                else if (key_length)
+                {
+                    std::memcpy(k.data(), key, key_length);
+                }
+
+                std::array<std::byte, block_size> ipad{};
+                std::array<std::byte, block_size> opad{};
+                for (size_t i = 0; i < block_size; i++)
+                {
+                    ipad[i] = k[i] ^ std::byte{0x36};
+                    opad[i] = k[i] ^ std::byte{0x5c};
+                }
+
+                inner_->process_bytes(ipad.data(), ipad.size());
+                outer_->process_bytes(opad.data(), opad.size());
+                bit::secure_be_zero(k);
+                bit::secure_be_zero(ipad);
+                bit::secure_be_zero(opad);
+            }
+
+            void process_bytes(const void* data, size_t len) noexcept override { return inner_->process_bytes(data, len); }
+
+            digest_t finalize() noexcept override
+            {
+                digest_t d = inner_->finalize();
+                outer_->process_bytes(d.data(), d.size());
+                bit::secure_be_zero(d);
+                return outer_->finalize();
+            }
+        };
+
+        return std::make_unique<hmac_context_impl_t>(key, key_length);
+    }
+
+    std::unique_ptr<sha256_context_t> create_hmac_sha256_context(const void* key, size_t key_length)
+    {
+        return make_hmac_context<sha256_context_t, 64, create_sha256_context>(key, key_length);
+    }
 }